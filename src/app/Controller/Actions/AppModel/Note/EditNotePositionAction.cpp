@@ -8,21 +8,17 @@
 #include "Model/AppModel/SingingClip.h"
 
 void EditNotePositionAction::execute() {
-    for (const auto &note : m_notes) {
-        m_clip->removeNote(note);
-        note->setLocalStart(note->localStart() + m_deltaTick);
-        note->setKeyIndex(note->keyIndex() + m_deltaKey);
-        m_clip->insertNote(note);
-    }
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, m_notes);
+    NoteBatch batch;
+    for (const auto &note : m_notes)
+        batch.timeKeyEdits.append({note, note->localStart() + m_deltaTick, note->length(),
+                                   note->keyIndex() + m_deltaKey});
+    m_clip->applyNoteBatch(batch);
 }
 
 void EditNotePositionAction::undo() {
-    for (const auto &note : m_notes) {
-        m_clip->removeNote(note);
-        note->setLocalStart(note->localStart() - m_deltaTick);
-        note->setKeyIndex(note->keyIndex() - m_deltaKey);
-        m_clip->insertNote(note);
-    }
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, m_notes);
+    NoteBatch batch;
+    for (const auto &note : m_notes)
+        batch.timeKeyEdits.append({note, note->localStart() - m_deltaTick, note->length(),
+                                   note->keyIndex() - m_deltaKey});
+    m_clip->applyNoteBatch(batch);
 }
\ No newline at end of file
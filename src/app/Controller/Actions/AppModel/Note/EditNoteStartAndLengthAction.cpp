@@ -8,21 +8,17 @@
 #include "Model/AppModel/SingingClip.h"
 
 void EditNoteStartAndLengthAction::execute() {
-    for (const auto &note : m_notes) {
-        m_clip->removeNote(note);
-        note->setLocalStart(note->localStart() + m_deltaTick);
-        note->setLength(note->length() - m_deltaTick);
-        m_clip->insertNote(note);
-    }
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, m_notes);
+    NoteBatch batch;
+    for (const auto &note : m_notes)
+        batch.timeKeyEdits.append({note, note->localStart() + m_deltaTick,
+                                   note->length() - m_deltaTick, note->keyIndex()});
+    m_clip->applyNoteBatch(batch);
 }
 
 void EditNoteStartAndLengthAction::undo() {
-    for (const auto &note : m_notes) {
-        m_clip->removeNote(note);
-        note->setLocalStart(note->localStart() - m_deltaTick);
-        note->setLength(note->length() + m_deltaTick);
-        m_clip->insertNote(note);
-    }
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, m_notes);
+    NoteBatch batch;
+    for (const auto &note : m_notes)
+        batch.timeKeyEdits.append({note, note->localStart() - m_deltaTick,
+                                   note->length() + m_deltaTick, note->keyIndex()});
+    m_clip->applyNoteBatch(batch);
 }
\ No newline at end of file
@@ -8,13 +8,13 @@
 #include "Model/AppModel/SingingClip.h"
 
 void RemoveNoteAction::execute() {
-    for (const auto &note : m_notes)
-        m_clip->removeNote(note);
-    m_clip->notifyNoteChanged(SingingClip::Remove, m_notes);
+    NoteBatch batch;
+    batch.removed = m_notes;
+    m_clip->applyNoteBatch(batch);
 }
 
 void RemoveNoteAction::undo() {
-    for (const auto &note : m_notes)
-        m_clip->insertNote(note);
-    m_clip->notifyNoteChanged(SingingClip::Insert, m_notes);
+    NoteBatch batch;
+    batch.inserted = m_notes;
+    m_clip->applyNoteBatch(batch);
 }
\ No newline at end of file
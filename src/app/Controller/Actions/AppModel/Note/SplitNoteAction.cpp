@@ -13,26 +13,20 @@ SplitNoteAction::SplitNoteAction(Note *originalNote, Note *newNote, int newLengt
 }
 
 void SplitNoteAction::execute() {
-    // Resize original note
-    m_clip->removeNote(m_originalNote);
-    m_originalNote->setLength(m_newLength);
-    m_clip->insertNote(m_originalNote);
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, QList<Note *>{m_originalNote});
-
-    // Insert new note
-    m_clip->insertNote(m_newNote);
-    m_clip->notifyNoteChanged(SingingClip::Insert, QList<Note *>{m_newNote});
+    // Resize original note and insert new note
+    NoteBatch batch;
+    batch.timeKeyEdits.append({m_originalNote, m_originalNote->localStart(), m_newLength,
+                               m_originalNote->keyIndex()});
+    batch.inserted.append(m_newNote);
+    m_clip->applyNoteBatch(batch);
 }
 
 void SplitNoteAction::undo() {
-    // Remove new note
-    m_clip->removeNote(m_newNote);
-    m_clip->notifyNoteChanged(SingingClip::Remove, QList<Note *>{m_newNote});
-
-    // Restore original note length
-    m_clip->removeNote(m_originalNote);
-    m_originalNote->setLength(m_originalLength);
-    m_clip->insertNote(m_originalNote);
-    m_clip->notifyNoteChanged(SingingClip::TimeKeyPropertyChange, QList<Note *>{m_originalNote});
+    // Remove new note and restore original note length
+    NoteBatch batch;
+    batch.removed.append(m_newNote);
+    batch.timeKeyEdits.append({m_originalNote, m_originalNote->localStart(), m_originalLength,
+                               m_originalNote->keyIndex()});
+    m_clip->applyNoteBatch(batch);
 }
 
@@ -4,6 +4,7 @@
 
 #include "ReplaceParamAction.h"
 
+#include "Model/AppModel/DrawCurve.h"
 #include "Model/AppModel/SingingClip.h"
 #include "Utils/AppModelUtils.h"
 
@@ -25,4 +26,15 @@ void ReplaceParamAction::undo() {
     const auto param = m_clip->params.getParamByName(m_paramName);
     param->setCurves(m_paramType, m_oldCurves, m_clip);
     m_clip->notifyParamChanged(m_paramName, m_paramType);
+}
+
+qsizetype ReplaceParamAction::memoryUsage(QHash<const void *, qsizetype> &sharedData) const {
+    // Old and new curves are copies sharing their unchanged chunks, so an edit only costs the
+    // chunks it touched
+    qsizetype size = 0;
+    for (const auto &curves : {m_oldCurves, m_newCurves})
+        for (const auto curve : curves)
+            if (const auto drawCurve = dynamic_cast<const DrawCurve *>(curve))
+                size += drawCurve->memoryUsage(sharedData);
+    return size;
 }
\ No newline at end of file
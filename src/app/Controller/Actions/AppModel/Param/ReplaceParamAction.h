@@ -16,6 +16,8 @@ public:
                                 const QList<Curve *> &curves, SingingClip *clip);
     void execute() override;
     void undo() override;
+    [[nodiscard]] qsizetype
+        memoryUsage(QHash<const void *, qsizetype> &sharedData) const override;
 
 private:
     ParamInfo::Name m_paramName = ParamInfo::Unknown;
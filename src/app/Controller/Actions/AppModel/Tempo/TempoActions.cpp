@@ -18,11 +18,9 @@ void TempoActions::editTempo(const double oldTempo, const double newTempo, AppMo
         for (const auto clip : track->clips()) {
             if (clip->clipType() == Clip::Audio) {
                 const auto audioClip = dynamic_cast<AudioClip *>(clip);
-                const auto audioInfo = audioClip->audioInfo();
+                const auto &audioInfo = audioClip->audioInfo();
                 Clip::ClipCommonProperties oldArgs(*clip);
                 auto newArgs = oldArgs;
-                auto chunksPerTick = static_cast<double>(audioInfo.sampleRate) /
-                                     audioInfo.chunkSize * 60 / newTempo / 480;
 
                 const auto oldStartInMs = tickToMs(oldArgs.start, oldTempo);
                 newArgs.start = msToTick(oldStartInMs, newTempo);
@@ -22,14 +22,18 @@
 #include "Modules/History/HistoryManager.h"
 #include "Modules/Inference/InferController.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/ProjectConverters/DspxProjectConverter.h"
 #include "Modules/ProjectConverters/MidiConverter.h"
 #include "Modules/Task/TaskManager.h"
 #include "Tasks/DecodeAudioTask.h"
 #include "Tasks/LaunchLanguageEngineTask.h"
+#include "Tasks/SaveProjectTask.h"
 #include "UI/Controls/Toast.h"
 #include "Utils/Log.h"
 
+#include <QCryptographicHash>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
 
 #include "Actions/AppModel/MasterControl/MasterControlActions.h"
@@ -44,6 +48,14 @@ AppController::AppController(QObject *parent)
             [=] { d->onRunLanguageEngineTaskFinished(task); });
     taskManager->addAndStartTask(task);
     appStatus->languageModuleStatus = AppStatus::ModuleStatus::Loading;
+
+    connect(&d->m_autoSaveTimer, &QTimer::timeout, d, &AppControllerPrivate::autoSave);
+    connect(appOptions, &AppOptions::optionsChanged, d, [d](const auto option) {
+        if (option != AppOptionsGlobal::All && option != AppOptionsGlobal::General)
+            return;
+        d->applyAutoSaveOptions();
+    });
+    d->applyAutoSaveOptions();
 }
 
 AppController::~AppController() {
@@ -89,6 +101,20 @@ bool AppController::saveProject(const QString &filePath, QString &errorMessage)
     return true;
 }
 
+void AppController::saveProjectInBackground(const QString &filePath) {
+    Q_D(AppController);
+    if (d->m_saveTask) {
+        d->m_pendingSavePath = filePath;
+        return;
+    }
+    d->startSaveTask(filePath, false);
+}
+
+bool AppController::isSaving() const {
+    Q_D(const AppController);
+    return d->m_saveTask != nullptr;
+}
+
 void AppController::importMidiFile(const QString &filePath) {
     appModel->importMidiFile(filePath);
 }
@@ -239,10 +265,92 @@ void AppControllerPrivate::onRunLanguageEngineTaskFinished(LaunchLanguageEngineT
 void AppControllerPrivate::updateProjectPathAndName(const QString &path) {
     Q_Q(AppController);
     m_projectPath = path;
+    m_isAutoSaveUpToDate = false;
     q->setProjectName(m_projectPath.isEmpty() ? tr("New Project")
                                               : QFileInfo(m_projectPath).fileName());
 }
 
+void AppControllerPrivate::startSaveTask(const QString &path, const bool isAutoSave) {
+    QElapsedTimer timer;
+    timer.start();
+    const auto task =
+        new SaveProjectTask(DspxProjectConverter::takeSnapshot(appModel), path, isAutoSave);
+    task->snapshotMs = timer.elapsed();
+    task->state = historyManager->currentState();
+    m_saveTask = task;
+    connect(task, &Task::finished, this, [task, this] { onSaveTaskFinished(task); });
+    taskManager->addAndStartTask(task);
+}
+
+void AppControllerPrivate::onSaveTaskFinished(SaveProjectTask *task) {
+    Q_Q(AppController);
+    taskManager->removeTask(task);
+    m_saveTask = nullptr;
+    Log::i("Save", QString("%1 %2: snapshot %3 ms, write %4 ms")
+                       .arg(task->isAutoSave() ? "Auto saved" : "Saved", task->path())
+                       .arg(task->snapshotMs)
+                       .arg(task->writeMs));
+    if (task->isAutoSave()) {
+        if (task->success) {
+            m_autoSavedState = task->state;
+            m_isAutoSaveUpToDate = true;
+        } else
+            qWarning() << "Auto save failed:" << task->errorMessage;
+    } else {
+        if (task->success) {
+            historyManager->setSavePoint(task->state);
+            updateProjectPathAndName(task->path());
+            m_lastProjectFolder = QFileInfo(task->path()).dir().path();
+        }
+        emit q->projectSaved(task->path(), task->success, task->errorMessage);
+    }
+    delete task;
+
+    if (!m_pendingSavePath.isEmpty()) {
+        const auto path = m_pendingSavePath;
+        m_pendingSavePath.clear();
+        startSaveTask(path, false);
+    }
+}
+
+void AppControllerPrivate::autoSave() {
+    // Only unsaved changes that are not auto saved yet, and never alongside another save
+    if (m_saveTask || historyManager->isOnSavePoint())
+        return;
+    if (m_isAutoSaveUpToDate && m_autoSavedState == historyManager->currentState())
+        return;
+    const auto path = autoSavePath();
+    if (!QDir().mkpath(QFileInfo(path).path())) {
+        qWarning() << "Auto save: failed to create folder for" << path;
+        return;
+    }
+    startSaveTask(path, true);
+}
+
+QString AppControllerPrivate::autoSavePath() const {
+    const auto folder = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    if (m_projectPath.isEmpty())
+        return folder + "/Autosave/" + m_projectName + ".dspx";
+    // Projects with the same name in different folders must not share an auto save file
+    const QFileInfo info(m_projectPath);
+    const auto pathHash =
+        QCryptographicHash::hash(QDir::cleanPath(info.absoluteFilePath()).toUtf8(),
+                                 QCryptographicHash::Sha1)
+            .toHex()
+            .left(12);
+    return folder + "/Autosave/" + info.completeBaseName() + "-" + QString::fromLatin1(pathHash) +
+           ".dspx";
+}
+
+void AppControllerPrivate::applyAutoSaveOptions() {
+    const auto minutes = appOptions->general()->autoSaveIntervalMin;
+    if (minutes <= 0) {
+        m_autoSaveTimer.stop();
+        return;
+    }
+    m_autoSaveTimer.start(minutes * 60 * 1000);
+}
+
 bool AppControllerPrivate::openDspxFile(const QString &path, QString &errorMessage) {
     if (!appModel->loadProject(path, errorMessage)) {
         qCritical() << errorMessage;
@@ -46,6 +46,10 @@ public slots:
     void newProject();
     bool openFile(const QString &filePath, QString &errorMessage);
     bool saveProject(const QString &filePath, QString &errorMessage);
+    // Snapshots the project and writes it on a worker thread. A save requested while another one
+    // is running starts when it is done. The result is reported by projectSaved().
+    void saveProjectInBackground(const QString &filePath);
+    [[nodiscard]] bool isSaving() const;
 
     void setTrackAndClipPanelCollapsed(bool trackCollapsed, bool clipCollapsed);
 
@@ -64,6 +68,7 @@ public slots:
 
 signals:
     void activePanelChanged(AppGlobal::PanelType panel);
+    void projectSaved(const QString &filePath, bool success, const QString &errorMessage);
 
 private:
     Q_DECLARE_PRIVATE(AppController)
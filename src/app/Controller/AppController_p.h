@@ -6,11 +6,14 @@
 #define APPCONTROLLER_P_H
 
 #include "Global/AppGlobal.h"
+#include "Modules/History/HistoryManager.h"
 
 #include <QStandardPaths>
+#include <QTimer>
 
 class IMainWindow;
 class LaunchLanguageEngineTask;
+class SaveProjectTask;
 
 class AppControllerPrivate : public QObject {
     Q_OBJECT
@@ -28,11 +31,23 @@ public:
     QList<IPanel *> m_panels{};
     AppGlobal::PanelType m_activePanel = AppGlobal::TracksEditor;
 
+    SaveProjectTask *m_saveTask = nullptr;
+    QString m_pendingSavePath;
+    QTimer m_autoSaveTimer;
+    HistoryManager::StateId m_autoSavedState = HistoryManager::noStep;
+    bool m_isAutoSaveUpToDate = false;
+
     static void initializeModules();
     static bool isPowerOf2(int num);
     static void onRunLanguageEngineTaskFinished(LaunchLanguageEngineTask *task);
     void updateProjectPathAndName(const QString &path);
 
+    void startSaveTask(const QString &path, bool isAutoSave);
+    void onSaveTaskFinished(SaveProjectTask *task);
+    void autoSave();
+    [[nodiscard]] QString autoSavePath() const;
+    void applyAutoSaveOptions();
+
     bool openDspxFile(const QString &path, QString &errorMessage);
     bool openMidiFile(const QString &path, QString &errorMessage);
 
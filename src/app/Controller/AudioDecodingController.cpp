@@ -4,6 +4,9 @@
 
 #include "AudioDecodingController.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <TalcsFormat/FormatManager.h>
 
 #include "Model/AppModel/AudioClip.h"
@@ -12,6 +15,7 @@
 #include "Tasks/DecodeAudioTask.h"
 #include "UI/Controls/AccentButton.h"
 #include "UI/Dialogs/Base/Dialog.h"
+#include "Utils/Log.h"
 
 AudioDecodingController::AudioDecodingController(QObject *parent) : QObject(parent) {
 }
@@ -23,8 +27,8 @@ LITE_SINGLETON_IMPLEMENT_INSTANCE(AudioDecodingController)
 void AudioDecodingController::onModelChanged() {
     // qDebug() << "AudioDecodingController::onModelChanged";
     // Terminate all decoding tasks
-    for (const auto task : m_tasks) {
-        taskManager->terminateTask(task);
+    for (const auto task : QList(m_tasks)) {
+        terminateTask(task);
     }
     // Start new decoding tasks
     for (const auto track : appModel->tracks()) {
@@ -54,7 +58,7 @@ void AudioDecodingController::onClipChanged(const Track::ClipChangeType type, Cl
         if (clip->clipType() == Clip::Audio) {
             const auto audioClip = reinterpret_cast<AudioClip *>(clip);
             // TODO: 用其他方式判断是否需要重新解码
-            if (audioClip->audioInfo().peakCache.count() <= 0)
+            if (audioClip->audioInfo().peaks.isEmpty())
                 createAndStartTask(audioClip);
         }
     } else if (type == Track::Removed) {
@@ -83,13 +87,59 @@ void AudioDecodingController::createAndStartTask(AudioClip *clip) {
                 handleTaskFinished(decodeTask);
             });
     taskManager->addTask(decodeTask);
-    taskManager->startTask(decodeTask);
+    if (m_queuedTasks.isEmpty() && m_runningTaskCount == 0) {
+        m_batchTimer.start();
+        m_batchFileCount = 0;
+        m_batchFrames = 0;
+        m_batchSamples = 0;
+    }
+    m_queuedTasks.append(decodeTask);
+    startQueuedTasks();
+}
+
+void AudioDecodingController::setVisibleTimeRange(const double startTick, const double endTick) {
+    m_visibleStartTick = startTick;
+    m_visibleEndTick = endTick;
+}
+
+void AudioDecodingController::startQueuedTasks() {
+    while (m_runningTaskCount < maxConcurrentTasks && !m_queuedTasks.isEmpty()) {
+        const auto next = std::min_element(
+            m_queuedTasks.cbegin(), m_queuedTasks.cend(), [this](const auto lhs, const auto rhs) {
+                return distanceToVisibleRange(lhs) < distanceToVisibleRange(rhs);
+            });
+        const auto task = *next;
+        m_queuedTasks.erase(next);
+        m_runningTaskCount++;
+        taskManager->startTask(task);
+    }
+}
+
+double AudioDecodingController::distanceToVisibleRange(const DecodeAudioTask *task) const {
+    int trackIndex;
+    const auto clip = appModel->findClipById(task->clipId, trackIndex);
+    if (!clip)
+        return std::numeric_limits<double>::max();
+    const double start = clip->start() + clip->clipStart();
+    const double end = start + clip->clipLen();
+    if (end < m_visibleStartTick)
+        return m_visibleStartTick - end;
+    if (start > m_visibleEndTick)
+        return start - m_visibleEndTick;
+    return 0;
 }
 
 void AudioDecodingController::handleTaskFinished(DecodeAudioTask *task) {
     const auto terminate = task->terminated();
     taskManager->removeTask(task);
     m_tasks.removeOne(task);
+    m_runningTaskCount--;
+    m_batchFileCount++;
+    m_batchFrames += task->decodedFrames();
+    m_batchSamples += task->decodedFrames() * task->result().channels;
+    startQueuedTasks();
+    if (m_queuedTasks.isEmpty() && m_runningTaskCount == 0)
+        reportThroughput();
 
     if (terminate) {
         delete task;
@@ -124,15 +174,38 @@ void AudioDecodingController::handleTaskFinished(DecodeAudioTask *task) {
     delete task;
 }
 
+void AudioDecodingController::terminateTask(DecodeAudioTask *task) {
+    // Tasks still waiting in the queue never started, so they will not report they finished
+    if (m_queuedTasks.removeOne(task)) {
+        taskManager->removeTask(task);
+        m_tasks.removeOne(task);
+        delete task;
+        return;
+    }
+    taskManager->terminateTask(task);
+}
+
 void AudioDecodingController::terminateTaskByClipId(const int clipId) {
-    for (const auto task : m_tasks)
+    for (const auto task : QList(m_tasks))
         if (task->clipId == clipId)
-            taskManager->terminateTask(task);
+            terminateTask(task);
 }
 
 void AudioDecodingController::terminateTasksByTrackId(const int trackId) {
-    for (auto task : m_tasks) {
+    for (auto task : QList(m_tasks)) {
         if (task->trackId == trackId)
-            taskManager->terminateTask(task);
+            terminateTask(task);
     }
+}
+
+void AudioDecodingController::reportThroughput() {
+    const auto seconds = static_cast<double>(m_batchTimer.nsecsElapsed()) / 1e9;
+    if (m_batchFrames == 0 || seconds <= 0)
+        return;
+    Log::i("AudioDecoding",
+           QString("Decoded %1 files, %2 M frames in %3 s: %4 M samples/s")
+               .arg(m_batchFileCount)
+               .arg(static_cast<double>(m_batchFrames) / 1e6, 0, 'f', 1)
+               .arg(seconds, 0, 'f', 2)
+               .arg(static_cast<double>(m_batchSamples) / 1e6 / seconds, 0, 'f', 1));
 }
\ No newline at end of file
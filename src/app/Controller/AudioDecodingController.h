@@ -11,6 +11,7 @@
 #include "Model/AppModel/AppModel.h"
 #include "Model/AppModel/Track.h"
 
+#include <QElapsedTimer>
 #include <QObject>
 
 class AudioClip;
@@ -31,14 +32,33 @@ public slots:
     void onModelChanged();
     void onTrackChanged(AppModel::TrackChangeType type, qsizetype index, const Track *track);
     void onClipChanged(Track::ClipChangeType type, Clip *clip);
+    // Clips in the visible range of the track editor are decoded first
+    void setVisibleTimeRange(double startTick, double endTick);
 
 private:
+    // Decoding is bound by disk reads: more concurrent streams only make the disks seek
+    static constexpr int maxConcurrentTasks = 2;
+
     QList<DecodeAudioTask *> m_tasks;
+    QList<DecodeAudioTask *> m_queuedTasks;
+    int m_runningTaskCount = 0;
+    double m_visibleStartTick = 0;
+    double m_visibleEndTick = 0;
+
+    // Aggregate throughput of the tasks decoded since the queue was last empty
+    QElapsedTimer m_batchTimer;
+    int m_batchFileCount = 0;
+    qint64 m_batchFrames = 0;
+    qint64 m_batchSamples = 0;
 
     void createAndStartTask(AudioClip *clip);
+    void startQueuedTasks();
+    [[nodiscard]] double distanceToVisibleRange(const DecodeAudioTask *task) const;
     void handleTaskFinished(DecodeAudioTask *task);
+    void terminateTask(DecodeAudioTask *task);
     void terminateTaskByClipId(int clipId);
     void terminateTasksByTrackId(int trackId);
+    void reportThroughput();
 };
 
 #endif // AUDIODECODINGCONTROLLER_H
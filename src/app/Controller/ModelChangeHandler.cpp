@@ -47,6 +47,8 @@ void ModelChangeHandler::handleSingingClipInserted(SingingClip *clip) {
             [clip, this](const SingingClip::NoteChangeType type, const QList<Note *> &notes) {
                 handleNoteChanged(type, notes, clip);
             });
+    connect(clip, &SingingClip::noteBatchApplied, this,
+            [clip, this](const QList<Note *> &notes) { handleNoteBatchApplied(notes, clip); });
     connect(clip, &SingingClip::piecesChanged, this,
             [clip, this](const QList<InferPiece *> &pieces, const QList<InferPiece *> &newPieces,
                          const QList<InferPiece *> &discardedPieces) {
@@ -66,6 +68,9 @@ void ModelChangeHandler::handleNoteChanged(SingingClip::NoteChangeType type,
                                            const QList<Note *> &notes, SingingClip *clip) {
 }
 
+void ModelChangeHandler::handleNoteBatchApplied(const QList<Note *> &notes, SingingClip *clip) {
+}
+
 void ModelChangeHandler::handleParamChanged(ParamInfo::Name name, Param::Type type,
                                             SingingClip *clip) {
 }
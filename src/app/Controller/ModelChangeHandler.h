@@ -28,6 +28,7 @@ protected:
     virtual void handleSingingClipRemoved(SingingClip *clip);
     virtual void handleNoteChanged(SingingClip::NoteChangeType type, const QList<Note *> &notes,
                                    SingingClip *clip);
+    virtual void handleNoteBatchApplied(const QList<Note *> &notes, SingingClip *clip);
     virtual void handleParamChanged(ParamInfo::Name name, Param::Type type, SingingClip *clip);
     virtual void handlePiecesChanged(const PieceList &pieces, const PieceList &discardedPieces, SingingClip *clip);
 
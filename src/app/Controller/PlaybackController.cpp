@@ -45,6 +45,26 @@ double PlaybackController::lastPosition() const {
     return d->m_lastPlayPosition;
 }
 
+double PlaybackController::interpolatedPosition() const {
+    Q_D(const PlaybackController);
+    if (d->m_playbackStatus != Playing || !d->m_positionClock.isValid())
+        return d->m_position;
+
+    // Do not run away if the audio thread stalls
+    constexpr double maxExtrapolationSecs = 0.1;
+    const auto secs = qMin(static_cast<double>(d->m_positionClock.nsecsElapsed()) / 1e9,
+                           maxExtrapolationSecs);
+    // Extrapolated in time, so that the playhead follows tempo changes
+    const auto timeline = appModel->timeline();
+    const auto positionSecs = timeline.tickToSec(d->m_position) + secs;
+    // A report slightly behind the extrapolated position would move the playhead backwards
+    const auto behind = timeline.tickToSec(d->m_interpolatedPosition) - positionSecs;
+    if (behind > 0 && behind < maxExtrapolationSecs)
+        return d->m_interpolatedPosition;
+    d->m_interpolatedPosition = timeline.secToTick(positionSecs);
+    return d->m_interpolatedPosition;
+}
+
 double PlaybackController::tempo() const {
     Q_D(const PlaybackController);
     return d->m_tempo;
@@ -78,6 +98,7 @@ void PlaybackController::stop() {
 void PlaybackController::setPosition(const double tick) {
     Q_D(PlaybackController);
     d->m_position = tick;
+    d->m_positionClock.start();
     emit positionChanged(tick);
 }
 
@@ -110,6 +131,7 @@ void PlaybackControllerPrivate::onValidationFinished(const bool passed) {
         m_playRequested = false;
         if (passed) {
             m_playbackStatus = Playing;
+            m_interpolatedPosition = m_position;
             emit q->playbackStatusChanged(Playing);
         } else {
             Toast::show(tr("Please fix project errors before playing"));
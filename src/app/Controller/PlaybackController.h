@@ -33,6 +33,9 @@ public:
 
     [[nodiscard]] double position() const;
     [[nodiscard]] double lastPosition() const;
+    // Position extrapolated from the last one reported by the audio thread, which only reports
+    // once per buffer. Use it to move the playhead at the display rate.
+    [[nodiscard]] double interpolatedPosition() const;
 
     [[nodiscard]] double tempo() const;
 
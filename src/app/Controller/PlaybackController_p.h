@@ -5,6 +5,8 @@
 #ifndef PLAYBACKCONTROLLER_P_H
 #define PLAYBACKCONTROLLER_P_H
 
+#include <QElapsedTimer>
+
 class PlaybackControllerPrivate : public QObject {
     Q_OBJECT
     Q_DECLARE_PUBLIC(PlaybackController)
@@ -14,6 +16,8 @@ public:
     }
 
     double m_position = 0;
+    QElapsedTimer m_positionClock;
+    mutable double m_interpolatedPosition = 0;
     double m_lastPlayPosition = 0;
     double m_sampleRate = 48000;
     double m_tempo = 120;
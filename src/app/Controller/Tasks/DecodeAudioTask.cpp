@@ -4,6 +4,10 @@
 
 #include "DecodeAudioTask.h"
 
+#include "Modules/Audio/utils/PeakFile.h"
+
+#include <algorithm>
+
 #include <QDebug>
 #include <QThread>
 
@@ -17,15 +21,52 @@ DecodeAudioTask::DecodeAudioTask(/*int id*/) /*: ITask(id)*/ {
 }
 
 AudioInfoModel DecodeAudioTask::result() const {
-    AudioInfoModel info;
-    info.sampleRate = m_sampleRate;
-    info.channels = m_channels;
-    info.chunkSize = m_chunkSize;
-    info.mipmapScale = m_mipmapScale;
-    info.frames = m_frames;
-    info.peakCache = m_peakCache;
-    info.peakCacheMipmap = m_peakCacheMipmap;
-    return info;
+    return m_result;
+}
+
+qint64 DecodeAudioTask::decodedFrames() const {
+    return m_decodedFrames;
+}
+
+// Mono mix of a frame as a 16-bit peak value. NaN is dropped and out of range samples are
+// clamped before the conversion, which is undefined for them.
+static int toPeakValue(const float mono) {
+    return mono == mono ? static_cast<int>(std::clamp(mono, -1.0f, 1.0f) * 32767.0f) : 0;
+}
+
+// Min and max of the mono mix of interleaved frames, as 16-bit peak values. Reduced as integers
+// with a fixed channel count for mono and stereo files, so that the compiler vectorizes the loop
+// (float min/max reductions are not, because of NaN ordering).
+template <int Channels>
+static void reduceFrames(const float *samples, const qint64 frames, int &min, int &max) {
+    auto localMin = min;
+    auto localMax = max;
+    for (qint64 i = 0; i < frames; i++) {
+        float mono = 0;
+        for (int j = 0; j < Channels; j++)
+            mono += samples[i * Channels + j];
+        const auto value = toPeakValue(mono / Channels);
+        localMin = std::min(localMin, value);
+        localMax = std::max(localMax, value);
+    }
+    min = localMin;
+    max = localMax;
+}
+
+static void reduceFrames(const float *samples, const qint64 frames, const int channels, int &min,
+                         int &max) {
+    if (channels == 1)
+        return reduceFrames<1>(samples, frames, min, max);
+    if (channels == 2)
+        return reduceFrames<2>(samples, frames, min, max);
+    for (qint64 i = 0; i < frames; i++) {
+        float mono = 0;
+        for (int j = 0; j < channels; j++)
+            mono += samples[i * channels + j];
+        const auto value = toPeakValue(mono / static_cast<float>(channels));
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
 }
 
 void DecodeAudioTask::runTask() {
@@ -42,116 +83,81 @@ void DecodeAudioTask::runTask() {
 #endif
     //    SndfileHandle sf(pathStr.c_str());
 
+    // Peaks saved by an earlier decode of the same file make decoding unnecessary
+    const auto peakFileKey = PeakFile::audioFileKey(path);
+    if (PeakFile::load(path, peakFileKey, m_result)) {
+        success = true;
+        return;
+    }
+
     if (!io || !io->open(talcs::AbstractAudioFormatIO::Read)) {
         success = false;
         errorMessage = "No io"; // TODO talcs::FormatEntry should provide error message
         return;
     }
 
-    QVector<std::tuple<short, short>> nullVector;
-    m_peakCache.swap(nullVector);
-    QVector<std::tuple<short, short>> nullVectorThumbnail;
-    m_peakCacheMipmap.swap(nullVectorThumbnail);
-
-    m_sampleRate = io->sampleRate();
-    m_channels = io->channelCount();
-    m_frames = io->length();
+    m_result = AudioInfoModel();
+    m_result.sampleRate = io->sampleRate();
+    m_result.channels = io->channelCount();
+    m_result.frames = io->length();
+    const auto channels = m_result.channels;
     // auto totalSize = frames * channels;
     // qDebug() << frames;
 
-    std::vector<float> buffer(m_chunkSize * m_channels);
-    const auto totalBufferCount = m_frames / m_chunkSize;
+    const auto readSize = m_chunkSize * m_chunksPerRead;
+    std::vector<float> buffer(readSize * channels);
+    const auto totalBufferCount = m_result.frames / m_chunkSize;
+    QList<qint16> peakMins;
+    QList<qint16> peakMaxs;
+    peakMins.reserve(totalBufferCount + 1);
+    peakMaxs.reserve(totalBufferCount + 1);
     long long buffersRead = 0;
     qint64 samplesRead = 0;
-    while (samplesRead < m_frames * m_channels) {
+
+    while (samplesRead < m_result.frames * channels) {
         if (isTerminateRequested()) {
-            qDebug() << "Decode audio task abort:" << path;
-            status.title = "Canceling decoding...";
-            status.isIndetermine = true;
-            status.runningStatus = TaskGlobal::Error;
-            setStatus(status);
-            // QThread::sleep(3);
+            abort(status);
             return;
         }
-        samplesRead = io->read(buffer.data(), m_chunkSize);
+        samplesRead = io->read(buffer.data(), readSize);
         if (samplesRead == 0) {
             break;
         }
-        double sampleMax = 0;
-        double sampleMin = 0;
-        const qint64 framesRead = samplesRead / m_channels;
-        for (qint64 i = 0; i < framesRead; i++) {
-            double monoSample = 0.0;
-            for (int j = 0; j < m_channels; j++) {
-                monoSample += buffer[i * m_channels + j] / static_cast<double>(m_channels);
-            }
-            if (monoSample > sampleMax)
-                sampleMax = monoSample;
-            if (monoSample < sampleMin)
-                sampleMin = monoSample;
+        const qint64 framesRead = samplesRead / channels;
+        m_decodedFrames += framesRead;
+        for (qint64 chunkStart = 0; chunkStart < framesRead; chunkStart += m_chunkSize) {
+            int sampleMin = 0;
+            int sampleMax = 0;
+            reduceFrames(buffer.data() + chunkStart * channels,
+                         std::min<qint64>(m_chunkSize, framesRead - chunkStart), channels,
+                         sampleMin, sampleMax);
+            peakMins.append(static_cast<qint16>(sampleMin));
+            peakMaxs.append(static_cast<qint16>(sampleMax));
+            buffersRead++;
         }
 
-        auto toShortInt = [](double d) -> short {
-            if (d < -1)
-                d = -1;
-            else if (d > 1)
-                d = 1;
-            return static_cast<short>(d * 32767);
-        };
-
-        short max = toShortInt(sampleMax);
-        short min = toShortInt(sampleMin);
-
-        auto pair = std::make_pair(min, max);
-        m_peakCache.append(pair);
-        buffersRead++;
-
-        constexpr int updateProgressThreshold = 200;
-        if (totalBufferCount < updateProgressThreshold) {
-            status.progress = 100;
-            setStatus(status);
-        } else if (buffersRead % (totalBufferCount / 200) == 0) {
-            const auto progress = 100 * buffersRead / totalBufferCount;
-            // qDebug() << progress;
+        const auto progress = totalBufferCount == 0
+                                  ? 100
+                                  : std::min<qint64>(100, 100 * buffersRead / totalBufferCount);
+        if (progress != status.progress) {
             status.progress = static_cast<int>(progress);
             setStatus(status);
         }
         // QThread::msleep(1);
     }
 
-    // Create mipmap from peak cache
-    short min = 0;
-    short max = 0;
-    bool hasTail = false;
-    for (int i = 0; i < m_peakCache.count(); i++) {
-        if (isTerminateRequested()) {
-            qDebug() << "Decode audio task abort:" << path;
-            status.title = "Canceling decoding...";
-            status.isIndetermine = true;
-            status.runningStatus = TaskGlobal::Error;
-            setStatus(status);
-            // QThread::sleep(3);
-            return;
-        }
-        if ((i + 1) % m_mipmapScale == 0) {
-            m_peakCacheMipmap.append(std::make_pair(min, max));
-            min = 0;
-            max = 0;
-            hasTail = false;
-        } else {
-            auto frame = m_peakCache.at(i);
-            const auto frameMin = std::get<0>(frame);
-            const auto frameMax = std::get<1>(frame);
-            if (frameMin < min)
-                min = frameMin;
-            if (frameMax > max)
-                max = frameMax;
-            hasTail = true;
-        }
-    }
-    if (hasTail)
-        m_peakCacheMipmap.append(std::make_pair(min, max));
+    m_result.peaks = PeakPyramid(peakMins, peakMaxs, m_chunkSize);
+    if (!PeakFile::save(path, peakFileKey, m_result))
+        qWarning() << "Failed to save peak file of" << path;
 
     // QThread::msleep(3000);
     success = true;
-}
\ No newline at end of file
+}
+
+void DecodeAudioTask::abort(TaskStatus &status) {
+    qDebug() << "Decode audio task abort:" << path;
+    status.title = "Canceling decoding...";
+    status.isIndetermine = true;
+    status.runningStatus = TaskGlobal::Error;
+    setStatus(status);
+}
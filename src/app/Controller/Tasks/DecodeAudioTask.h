@@ -28,17 +28,18 @@ public:
     QString errorMessage;
     QJsonObject workspace;
     [[nodiscard]] AudioInfoModel result() const;
+    // Frames actually decoded, 0 if the peaks came from a peak file
+    [[nodiscard]] qint64 decodedFrames() const;
 
 private:
     void runTask() override;
+    void abort(TaskStatus &status);
 
-    int m_sampleRate = 0;
-    int m_channels = 0;
-    long long m_frames = 0;
     int m_chunkSize = 128;
-    int m_mipmapScale = 10;
-    QVector<std::tuple<short, short>> m_peakCache;
-    QVector<std::tuple<short, short>> m_peakCacheMipmap;
+    // Chunks decoded per read, so that a disk stream is read in large blocks
+    int m_chunksPerRead = 64;
+    AudioInfoModel m_result;
+    qint64 m_decodedFrames = 0;
 };
 
 #endif // DECODEAUDIOTASK_H
@@ -0,0 +1,35 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "SaveProjectTask.h"
+
+#include <QElapsedTimer>
+
+SaveProjectTask::SaveProjectTask(DspxProjectConverter::Snapshot snapshot, QString path,
+                                 const bool isAutoSave, QObject *parent)
+    : Task(parent), m_snapshot(std::move(snapshot)), m_path(std::move(path)),
+      m_isAutoSave(isAutoSave) {
+    TaskStatus status;
+    status.title = isAutoSave ? tr("Auto saving...") : tr("Saving project...");
+    status.message = m_path;
+    status.isIndetermine = true;
+    setStatus(status);
+}
+
+QString SaveProjectTask::path() const {
+    return m_path;
+}
+
+bool SaveProjectTask::isAutoSave() const {
+    return m_isAutoSave;
+}
+
+void SaveProjectTask::runTask() {
+    QElapsedTimer timer;
+    timer.start();
+    success = DspxProjectConverter::writeSnapshot(m_snapshot, m_path, errorMessage);
+    writeMs = timer.elapsed();
+    // The snapshot shares data with the model, release it here rather than on the GUI thread
+    m_snapshot = {};
+}
@@ -0,0 +1,41 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef SAVEPROJECTTASK_H
+#define SAVEPROJECTTASK_H
+
+#include "Modules/History/HistoryManager.h"
+#include "Modules/ProjectConverters/DspxProjectConverter.h"
+#include "Modules/Task/Task.h"
+
+// Encodes and writes a project snapshot taken on the GUI thread. The model may change while it
+// runs.
+class SaveProjectTask final : public Task {
+    Q_OBJECT
+
+public:
+    SaveProjectTask(DspxProjectConverter::Snapshot snapshot, QString path, bool isAutoSave,
+                    QObject *parent = nullptr);
+
+    // History state the snapshot was taken at
+    HistoryManager::StateId state = HistoryManager::noStep;
+    qint64 snapshotMs = 0;
+
+    [[nodiscard]] QString path() const;
+    [[nodiscard]] bool isAutoSave() const;
+    bool success = false;
+    QString errorMessage;
+    qint64 writeMs = 0;
+
+protected:
+    // Not interruptible: a save in progress always completes, also when the app is closing
+    void runTask() override;
+
+private:
+    DspxProjectConverter::Snapshot m_snapshot;
+    QString m_path;
+    bool m_isAutoSave;
+};
+
+#endif // SAVEPROJECTTASK_H
@@ -45,7 +45,7 @@ std::tuple<qsizetype, qsizetype> AnchorNode::interval() const {
     return std::make_tuple(pos(), pos());
 }
 
-const OverlappableSerialList<AnchorNode> &AnchorCurve::nodes() const {
+const FlatOverlappableList<AnchorNode> &AnchorCurve::nodes() const {
     return m_nodes;
 }
 
@@ -6,7 +6,7 @@
 #define ANCHORCURVE_H
 
 #include "Curve.h"
-#include "Utils/OverlappableSerialList.h"
+#include "Utils/FlatOverlappableList.h"
 
 class AnchorNode : public Overlappable, public UniqueObject {
 public:
@@ -38,13 +38,13 @@ public:
         return Anchor;
     }
 
-    const OverlappableSerialList<AnchorNode> &nodes() const;
+    const FlatOverlappableList<AnchorNode> &nodes() const;
     void insertNode(AnchorNode *node);
     void removeNode(AnchorNode *node);
     int localEndTick() const override;
 
 private:
-    OverlappableSerialList<AnchorNode> m_nodes;
+    FlatOverlappableList<AnchorNode> m_nodes;
 };
 
 
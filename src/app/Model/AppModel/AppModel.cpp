@@ -16,6 +16,7 @@
 #include "Utils/MathUtils.h"
 
 #include <QJsonArray>
+#include <QSignalBlocker>
 
 AppModel::AppModel(QObject *parent) : QObject(parent), d_ptr(new AppModelPrivate(this)) {
 }
@@ -42,6 +43,11 @@ double AppModel::tempo() const {
     return d->m_tempo;
 }
 
+Timeline AppModel::timeline() const {
+    Q_D(const AppModel);
+    return Timeline({Tempo{0, d->m_tempo}}, {d->m_timeSignature});
+}
+
 void AppModel::setTempo(const double tempo) {
     Q_D(AppModel);
     d->m_tempo = tempo;
@@ -150,11 +156,18 @@ void AppModel::newProject() {
 bool AppModel::loadProject(const QString &path, QString &errorMessage) {
     Q_D(AppModel);
     d->reset();
+    // Decode straight into this model. Its signals are held back until the whole project is in
+    // place, so that listeners only see the modelChanged() of a completely loaded project.
     DspxProjectConverter converter;
-    AppModel resultModel;
-    const auto ok = converter.load(path, &resultModel, errorMessage, ImportMode::NewProject);
-    if (ok)
-        loadFromAppModel(resultModel);
+    bool ok;
+    {
+        const QSignalBlocker blocker(this);
+        ok = converter.load(path, this, errorMessage, ImportMode::NewProject);
+    }
+    if (ok) {
+        emit modelChanged();
+        d->dispose();
+    }
     return ok;
 }
 
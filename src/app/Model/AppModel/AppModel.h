@@ -10,6 +10,7 @@
 #include "Utils/Singleton.h"
 #include "Clip.h"
 #include "TimeSignature.h"
+#include "Timeline.h"
 #include "Interface/ISerializable.h"
 #include "TrackControl.h"
 
@@ -35,6 +36,8 @@ public:
     void setTimeSignature(const TimeSignature &signature);
     double tempo() const;
     void setTempo(double tempo);
+    // The project has a single tempo and time signature for now
+    Timeline timeline() const;
     TrackControl masterControl() const;
     void setMasterControl(const TrackControl &control);
     const QList<Track *> &tracks() const;
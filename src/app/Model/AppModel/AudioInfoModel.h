@@ -5,17 +5,14 @@
 #ifndef AUDIOINFOMODEL_H
 #define AUDIOINFOMODEL_H
 
-#include <QList>
+#include "PeakPyramid.h"
 
 class AudioInfoModel {
 public:
-    int chunkSize = 0;
-    int mipmapScale = 0;
     int sampleRate = 0;
     int channels = 0;
     long long frames = 0;
-    QList<std::tuple<short, short>> peakCache;
-    QList<std::tuple<short, short>> peakCacheMipmap;
+    PeakPyramid peaks;
 };
 
 
@@ -0,0 +1,66 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "CurveEnvelope.h"
+
+#include <algorithm>
+#include <limits>
+
+CurveEnvelope::CurveEnvelope(const ChunkedList<int> &values)
+    : MinMaxPyramid(firstLevelOf(values)) {
+}
+
+std::pair<int, int> CurveEnvelope::rangeOf(const Level &level, const qsizetype startIndex,
+                                           const qsizetype endIndex) {
+    return MinMaxPyramid::rangeOf(
+        level, startIndex / level.valuesPerEntry,
+        (endIndex + level.valuesPerEntry - 1) / level.valuesPerEntry,
+        std::numeric_limits<int>::max(), std::numeric_limits<int>::min());
+}
+
+void CurveEnvelope::update(const ChunkedList<int> &values, const qsizetype firstIndex,
+                           const qsizetype lastIndex) {
+    if (isEmpty()) {
+        *this = CurveEnvelope(values);
+        return;
+    }
+    auto &first = firstLevel();
+    const auto count = (values.count() + samplesPerLevel0 - 1) / samplesPerLevel0;
+    const auto firstEntry = std::min(firstIndex / samplesPerLevel0, count);
+    const auto lastEntry =
+        std::min((lastIndex + samplesPerLevel0 - 1) / samplesPerLevel0, count);
+    first.mins.resize(count);
+    first.maxs.resize(count);
+    reduceEntries(values, firstEntry, lastEntry, first);
+    updateLevels(firstEntry, lastEntry);
+}
+
+CurveEnvelope::Level CurveEnvelope::firstLevelOf(const ChunkedList<int> &values) {
+    Level first;
+    first.valuesPerEntry = samplesPerLevel0;
+    const auto count = (values.count() + samplesPerLevel0 - 1) / samplesPerLevel0;
+    first.mins.resize(count);
+    first.maxs.resize(count);
+    reduceEntries(values, 0, count, first);
+    return first;
+}
+
+void CurveEnvelope::reduceEntries(const ChunkedList<int> &values, const qsizetype firstEntry,
+                                  const qsizetype lastEntry, Level &level) {
+    if (firstEntry >= lastEntry)
+        return;
+    const auto firstIndex = firstEntry * samplesPerLevel0;
+    const auto entryValues = values.mid(firstIndex, (lastEntry - firstEntry) * samplesPerLevel0);
+    for (qsizetype i = 0; i < entryValues.count(); i++) {
+        const auto entry = firstEntry + i / samplesPerLevel0;
+        const auto value = entryValues[i];
+        if (i % samplesPerLevel0 == 0) {
+            level.mins[entry] = value;
+            level.maxs[entry] = value;
+        } else {
+            level.mins[entry] = std::min(level.mins[entry], value);
+            level.maxs[entry] = std::max(level.maxs[entry], value);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef CURVEENVELOPE_H
+#define CURVEENVELOPE_H
+
+#include "Utils/ChunkedList.h"
+#include "Utils/MinMaxPyramid.h"
+
+// Min/max envelope of curve values, for drawing zoomed out curves. Level 0 holds the range of
+// every samplesPerLevel0 values.
+class CurveEnvelope : public MinMaxPyramid<int> {
+public:
+    static constexpr int samplesPerLevel0 = 4;
+
+    CurveEnvelope() = default;
+    explicit CurveEnvelope(const ChunkedList<int> &values);
+
+    // Follows a change of the values [firstIndex, lastIndex), rebuilding only the entries
+    // covering them. Pass the end of the values as lastIndex when the count changed.
+    void update(const ChunkedList<int> &values, qsizetype firstIndex, qsizetype lastIndex);
+
+    // Min and max of the values [startIndex, endIndex) at the given level. The entries on the
+    // borders may include a few neighbouring values.
+    [[nodiscard]] static std::pair<int, int> rangeOf(const Level &level, qsizetype startIndex,
+                                                     qsizetype endIndex);
+
+private:
+    static Level firstLevelOf(const ChunkedList<int> &values);
+    // Reduces the values of the level 0 entries [firstEntry, lastEntry) into level
+    static void reduceEntries(const ChunkedList<int> &values, qsizetype firstEntry,
+                              qsizetype lastEntry, Level &level);
+};
+
+#endif // CURVEENVELOPE_H
@@ -6,6 +6,8 @@
 
 #include <QDebug>
 
+#include "Utils/PackedCurveCodec.h"
+
 // DrawCurve::DrawCurve(const DrawCurve &other)
 //     : Curve(other), step(other.step), m_values(other.m_values) {
 //     // qDebug() << "DrawCurve() copy from: #id" << other.id() << "start:" << other.start;
@@ -18,20 +20,28 @@ void DrawCurve::setLocalStart(const int start) {
         qCritical() << "setStart: start not divisible by 5 tick";
 }
 
-const QList<int> &DrawCurve::values() const {
-    return m_values;
+QList<int> DrawCurve::values() const {
+    materializeValues();
+    return m_values.toList();
+}
+
+int DrawCurve::valueCount() const {
+    return m_packedValues.isNull() ? static_cast<int>(m_values.count()) : m_packedCount;
+}
+
+int DrawCurve::valueAt(const int index) const {
+    materializeValues();
+    return m_values.at(index);
 }
 
 bool DrawCurve::isEmpty() const {
-    return m_values.isEmpty();
+    return valueCount() == 0;
 }
 
 QList<int> DrawCurve::mid(const int tick) const {
+    materializeValues();
     const auto startIndex = (tick - localStart()) / step;
-    QList<int> result;
-    for (int i = startIndex; i < m_values.count(); i++)
-        result.append(m_values.at(i));
-    return result;
+    return m_values.mid(startIndex);
 }
 
 void DrawCurve::clip(const int clipStart, const int clipEnd) {
@@ -50,37 +60,86 @@ void DrawCurve::clip(const int clipStart, const int clipEnd) {
 }
 
 void DrawCurve::setValues(const QList<int> &values) {
-    m_values = values;
+    m_packedValues = QByteArray();
+    m_values = ChunkedList<int>(values);
+    invalidateValues();
+}
+
+void DrawCurve::setPackedValues(const QByteArray &packedValues, const int count) {
+    if (count == 0) {
+        clearValues();
+        return;
+    }
+    m_values.clear();
+    m_packedValues = packedValues;
+    m_packedCount = count;
+    invalidateValues();
+}
+
+const QByteArray &DrawCurve::packedValues() const {
+    return m_packedValues;
+}
+
+const CurveEnvelope &DrawCurve::envelope() const {
+    if (!m_envelopeValid) {
+        materializeValues();
+        m_envelope = CurveEnvelope(m_values);
+        m_envelopeValid = true;
+    } else if (m_envelopeDirtyFirst < m_envelopeDirtyLast) {
+        m_envelope.update(m_values, m_envelopeDirtyFirst,
+                          std::min(m_envelopeDirtyLast, m_values.count()));
+    }
+    m_envelopeDirtyFirst = m_envelopeDirtyLast = 0;
+    return m_envelope;
 }
 
 void DrawCurve::insertValue(const int index, const int value) {
-    m_values.insert(index, value);
+    materializeValues();
+    m_values.insert(index, {value});
+    invalidateValues(index, toEnd);
 }
 
 void DrawCurve::insertValues(const int index, const QList<int> &values) {
-    for (int i = 0; i < values.count(); i++)
-        m_values.insert(index + i, values.at(i));
+    materializeValues();
+    m_values.insert(index, values);
+    invalidateValues(index, toEnd);
 }
 
 void DrawCurve::removeValueRange(const qsizetype i, const qsizetype n) {
+    materializeValues();
     m_values.remove(i, n);
+    invalidateValues(i, toEnd);
 }
 
 void DrawCurve::clearValues() {
+    m_packedValues = QByteArray();
     m_values.clear();
+    invalidateValues();
 }
 
 void DrawCurve::appendValue(const int value) {
+    materializeValues();
     m_values.append(value);
+    invalidateValues(m_values.count() - 1, toEnd);
 }
 
 void DrawCurve::replaceValue(const int index, const int value) {
+    materializeValues();
     m_values.replace(index, value);
+    invalidateValues(index, index + 1);
+}
+
+void DrawCurve::replaceValues(const int index, const QList<int> &values) {
+    materializeValues();
+    m_values.replace(index, values);
+    invalidateValues(index, index + values.count());
 }
 
 void DrawCurve::mergeWithCurrentPriority(const DrawCurve &other) {
     if (!other.isOverlappedWith(this))
         qCritical() << "mergeWithCurrentPriority: other is not overlapped with this";
+    materializeValues();
+    other.materializeValues();
 
     const int curStart = localStart();
     const int otherStart = other.localStart();
@@ -95,21 +154,17 @@ void DrawCurve::mergeWithCurrentPriority(const DrawCurve &other) {
 
     if (otherStart > curStart) {
         const auto startIndex = (curEnd - otherStart) / step;
-        for (int i = startIndex; i < other.values().count(); i++)
-            appendValue(other.values().at(i));
+        invalidateValues(m_values.count(), toEnd);
+        m_values.append(other.m_values.mid(startIndex));
     } else { // otherStart <= curStart
-        QList<int> earlyPoints;
         const auto earlyCurvePointCount = (curStart - otherStart) / step;
-        for (int i = 0; i < earlyCurvePointCount; i++)
-            earlyPoints.append(other.values().at(i));
-        insertValues(0, earlyPoints);
+        m_values.insert(0, other.m_values.mid(0, earlyCurvePointCount));
         setLocalStart(otherStart);
         if (curEnd < otherEnd) {
             const auto tailCount = (otherEnd - curEnd) / step;
-            const auto startIndex = other.values().count() - tailCount;
-            for (auto i = startIndex; i < other.values().count(); i++)
-                appendValue(other.values().at(i));
+            m_values.append(other.m_values.mid(other.m_values.count() - tailCount));
         }
+        invalidateValues(0, toEnd);
     }
 }
 
@@ -121,28 +176,31 @@ void DrawCurve::mergeWithOtherPriority(const DrawCurve &other) {
     if (otherEnd < curStart || curEnd < otherStart) {
         qCritical() << "overlayMergeWith: other curve is not overlapped with current curve";
     }
+    materializeValues();
+    other.materializeValues();
 
     if (otherStart > curStart) {
         const auto editStartIndex = (otherStart - curStart) / step;
         if (curEnd >= otherEnd) {
-            for (int i = 0; i < other.values().count(); i++)
-                replaceValue(editStartIndex + i, other.values().at(i));
+            m_values.replace(editStartIndex, other.values());
+            invalidateValues(editStartIndex, editStartIndex + other.valueCount());
         } else {
-            removeValueRange(editStartIndex, values().count() - editStartIndex);
-            for (int i = 0; i < other.values().count(); i++)
-                appendValue(other.values().at(i));
+            m_values.remove(editStartIndex, m_values.count() - editStartIndex);
+            m_values.append(other.values());
+            invalidateValues(editStartIndex, toEnd);
         }
     } else { // otherStart <= curStart
         if (otherEnd >= curEnd) {
-            clearValues();
+            // Shares all chunks with other
+            m_values = other.m_values;
             setLocalStart(otherStart);
-            for (int i = 0; i < other.values().count(); i++)
-                appendValue(other.values().at(i));
+            invalidateValues();
         } else { // otherEnd<curEnd
             const auto removeEndIndex = (otherEnd - curStart) / step;
-            removeValueRange(0, removeEndIndex);
+            m_values.remove(0, removeEndIndex);
             setLocalStart(otherStart);
-            insertValues(0, other.values());
+            m_values.insert(0, other.values());
+            invalidateValues(0, toEnd);
         }
     }
 }
@@ -166,7 +224,7 @@ void DrawCurve::erase(const int otherStart, const int otherEnd) {
 
 void DrawCurve::eraseTail(const int length) {
     const auto count = length / step;
-    removeValueRange(values().count() - count, count);
+    removeValueRange(valueCount() - count, count);
 }
 
 void DrawCurve::eraseTailFrom(const int tick) {
@@ -175,10 +233,56 @@ void DrawCurve::eraseTailFrom(const int tick) {
 }
 
 int DrawCurve::localEndTick() const {
-    return localStart() + step * m_values.count();
+    return localStart() + step * valueCount();
+}
+
+qsizetype DrawCurve::memoryUsage(QHash<const void *, qsizetype> &sharedData) const {
+    m_values.forEachChunk([&](const QList<int> &list) {
+        if (list.capacity() > 0)
+            sharedData.insert(list.constData(),
+                              list.capacity() * static_cast<qsizetype>(sizeof(int)));
+    });
+    if (!m_packedValues.isNull())
+        sharedData.insert(m_packedValues.constData(), m_packedValues.capacity());
+    return sizeof(DrawCurve);
+}
+
+void DrawCurve::invalidateValues() {
+    if (m_envelopeValid) {
+        m_envelopeValid = false;
+        m_envelope = CurveEnvelope();
+    }
+}
+
+void DrawCurve::invalidateValues(const qsizetype firstIndex, const qsizetype lastIndex) {
+    if (!m_envelopeValid)
+        return;
+    if (m_envelopeDirtyFirst < m_envelopeDirtyLast) {
+        m_envelopeDirtyFirst = std::min(m_envelopeDirtyFirst, firstIndex);
+        m_envelopeDirtyLast = std::max(m_envelopeDirtyLast, lastIndex);
+    } else {
+        m_envelopeDirtyFirst = firstIndex;
+        m_envelopeDirtyLast = lastIndex;
+    }
+}
+
+void DrawCurve::materializeValues() const {
+    if (m_packedValues.isNull())
+        return;
+    QList<int> values;
+    if (!PackedCurveCodec::unpack(m_packedValues, m_packedCount, values)) {
+        qCritical() << "DrawCurve: failed to unpack curve values, count:" << m_packedCount;
+        values.fill(0, m_packedCount);
+    }
+    m_values = ChunkedList<int>(values);
+    m_packedValues = QByteArray();
 }
 
 bool operator==(const DrawCurve &lhs, const DrawCurve &rhs) {
+    if (!lhs.m_packedValues.isNull() && lhs.m_packedValues == rhs.m_packedValues)
+        return lhs.localStart() == rhs.localStart() && lhs.step == rhs.step;
+    lhs.materializeValues();
+    rhs.materializeValues();
     return lhs.localStart() == rhs.localStart() && lhs.step == rhs.step &&
            lhs.m_values == rhs.m_values;
 }
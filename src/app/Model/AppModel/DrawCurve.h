@@ -5,9 +5,14 @@
 #ifndef DRAWCURVE_H
 #define DRAWCURVE_H
 
+#include <limits>
+
+#include <QHash>
 #include <QList>
 
 #include "Curve.h"
+#include "CurveEnvelope.h"
+#include "Utils/ChunkedList.h"
 
 class DrawCurve final : public Curve {
 public:
@@ -24,17 +29,29 @@ public:
 
     int step = 5;
     void setLocalStart(int start) override;
-    const QList<int> &values() const;
+    // Flattened copy of the values. Prefer valueCount() and valueAt() on hot paths.
+    QList<int> values() const;
+    int valueCount() const;
+    int valueAt(int index) const;
     bool isEmpty() const;
     QList<int> mid(int tick) const;
     void clip(int clipStart, int clipEnd);
     void setValues(const QList<int> &values);
+    // Keeps values packed by PackedCurveCodec until they are first read or edited
+    void setPackedValues(const QByteArray &packedValues, int count);
+    // The packed values set by setPackedValues() as long as they are untouched, or null
+    const QByteArray &packedValues() const;
+    // Min/max envelope of the values for drawing zoomed out. The first call after a change
+    // rebuilds only the entries covering the changed values.
+    const CurveEnvelope &envelope() const;
     void insertValue(int index, int value);
     void insertValues(int index, const QList<int> &values);
     void removeValueRange(qsizetype i, qsizetype n);
     void clearValues();
     void appendValue(int value);
     void replaceValue(int index, int value);
+    // Overwrites values.count() values starting at index
+    void replaceValues(int index, const QList<int> &values);
     void mergeWithCurrentPriority(const DrawCurve &other);
     void mergeWithOtherPriority(const DrawCurve &other);
     void erase(int otherStart, int otherEnd);
@@ -42,13 +59,33 @@ public:
     void eraseTailFrom(int tick);
 
     int localEndTick() const override;
+    // Size of the curve object. Its value chunks and packed values are implicitly shared, they are
+    // added to sharedData with their heap size instead.
+    qsizetype memoryUsage(QHash<const void *, qsizetype> &sharedData) const;
 
     friend bool operator==(const DrawCurve &lhs, const DrawCurve &rhs);
     friend bool operator!=(const DrawCurve &lhs, const DrawCurve &rhs);
 
 private:
+    // Drops the envelope, for changes of all the values
+    void invalidateValues();
+    // Marks the values [firstIndex, lastIndex) as changed. Changes of the count shift all
+    // following values, so they pass toEnd as lastIndex.
+    void invalidateValues(qsizetype firstIndex, qsizetype lastIndex);
+    static constexpr qsizetype toEnd = std::numeric_limits<qsizetype>::max();
+    void materializeValues() const;
+
     // int m_step = 5;
-    QList<int> m_values;
+    // Copies of a curve (piece curves, clip params, undo snapshots) share unchanged chunks
+    mutable ChunkedList<int> m_values;
+    // Values of a loaded project stay packed until first accessed
+    mutable QByteArray m_packedValues;
+    int m_packedCount = 0;
+    mutable CurveEnvelope m_envelope;
+    mutable bool m_envelopeValid = false;
+    // Values changed since the envelope was last updated, none if first >= last
+    mutable qsizetype m_envelopeDirtyFirst = 0;
+    mutable qsizetype m_envelopeDirtyLast = 0;
 };
 
 
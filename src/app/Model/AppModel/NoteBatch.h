@@ -0,0 +1,33 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef NOTEBATCH_H
+#define NOTEBATCH_H
+
+#include <QList>
+
+class Note;
+
+// A set of note edits applied to a clip at once, see SingingClip::applyNoteBatch()
+class NoteBatch {
+public:
+    // New time and key of a note that stays in the clip
+    class TimeKeyEdit {
+    public:
+        Note *note = nullptr;
+        int localStart = 0;
+        int length = 0;
+        int keyIndex = 0;
+    };
+
+    QList<Note *> inserted;
+    QList<Note *> removed;
+    QList<TimeKeyEdit> timeKeyEdits;
+
+    [[nodiscard]] bool isEmpty() const {
+        return inserted.isEmpty() && removed.isEmpty() && timeKeyEdits.isEmpty();
+    }
+};
+
+#endif // NOTEBATCH_H
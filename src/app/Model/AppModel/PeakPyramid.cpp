@@ -0,0 +1,19 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "PeakPyramid.h"
+
+#include <cmath>
+
+PeakPyramid::PeakPyramid(const QList<qint16> &mins, const QList<qint16> &maxs,
+                         const int framesPerPeak)
+    : MinMaxPyramid({framesPerPeak, mins, maxs}) {
+}
+
+std::pair<qint16, qint16> PeakPyramid::peakOf(const Level &level, const double startFrame,
+                                              const double endFrame) {
+    const auto first = static_cast<qsizetype>(std::floor(startFrame / level.valuesPerEntry));
+    const auto last = static_cast<qsizetype>(std::ceil(endFrame / level.valuesPerEntry));
+    return rangeOf(level, first, last, 0, 0);
+}
@@ -0,0 +1,23 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef PEAKPYRAMID_H
+#define PEAKPYRAMID_H
+
+#include "Utils/MinMaxPyramid.h"
+
+// Min/max waveform peaks of an audio file at power-of-two resolutions. Level 0 holds the peaks of
+// every framesPerPeak frames.
+class PeakPyramid : public MinMaxPyramid<qint16> {
+public:
+    PeakPyramid() = default;
+    // Builds the coarser levels from the peaks of level 0
+    PeakPyramid(const QList<qint16> &mins, const QList<qint16> &maxs, int framesPerPeak);
+
+    // Min and max of the frames [startFrame, endFrame) at the given level, 0 if out of range
+    [[nodiscard]] static std::pair<qint16, qint16> peakOf(const Level &level, double startFrame,
+                                                          double endFrame);
+};
+
+#endif // PEAKPYRAMID_H
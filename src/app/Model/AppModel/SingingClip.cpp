@@ -18,6 +18,8 @@
 
 #include <QTimer>
 
+#include <algorithm>
+
 SingingClip::SingingClip() : Clip(), params(this) {
     init();
 }
@@ -38,7 +40,7 @@ IClip::ClipType SingingClip::clipType() const {
     return Singing;
 }
 
-const OverlappableSerialList<Note> &SingingClip::notes() const {
+const FlatOverlappableList<Note> &SingingClip::notes() const {
     return m_notes;
 }
 
@@ -49,7 +51,8 @@ void SingingClip::insertNote(Note *note) {
 
 void SingingClip::insertNotes(const QList<Note *> &notes) {
     for (const auto note : notes)
-        insertNote(note);
+        note->setClip(this);
+    m_notes.add(notes);
 }
 
 void SingingClip::removeNote(Note *note) {
@@ -57,6 +60,42 @@ void SingingClip::removeNote(Note *note) {
     note->setClip(nullptr);
 }
 
+void SingingClip::applyNoteBatch(const NoteBatch &batch) {
+    if (batch.isEmpty())
+        return;
+    QList<Note *> editedNotes;
+    editedNotes.reserve(batch.timeKeyEdits.count());
+    for (const auto &edit : batch.timeKeyEdits)
+        editedNotes.append(edit.note);
+
+    // Edited notes leave the list with their old interval and come back with the new one
+    m_notes.remove(batch.removed + editedNotes);
+    for (const auto note : batch.removed)
+        note->setClip(nullptr);
+    for (const auto &edit : batch.timeKeyEdits) {
+        edit.note->setLocalStart(edit.localStart);
+        edit.note->setLength(edit.length);
+        edit.note->setKeyIndex(edit.keyIndex);
+    }
+    for (const auto note : batch.inserted)
+        note->setClip(this);
+    m_notes.add(editedNotes + batch.inserted);
+
+    m_applyingNoteBatch = true;
+    if (!batch.removed.isEmpty())
+        emit noteChanged(Remove, batch.removed);
+    if (!editedNotes.isEmpty())
+        emit noteChanged(TimeKeyPropertyChange, editedNotes);
+    if (!batch.inserted.isEmpty())
+        emit noteChanged(Insert, batch.inserted);
+    m_applyingNoteBatch = false;
+    emit noteBatchApplied(batch.removed + editedNotes + batch.inserted);
+}
+
+bool SingingClip::isApplyingNoteBatch() const {
+    return m_applyingNoteBatch;
+}
+
 Note *SingingClip::findNoteById(const int id) const {
     return MathUtils::findItemById<Note *>(m_notes, id);
 }
@@ -73,50 +112,195 @@ const PieceList &SingingClip::pieces() const {
     return m_pieces;
 }
 
-void SingingClip::reSegment() {
-    // TODO: Refactor AppModel to support multiple tempos
-    Timeline timeline;
-    timeline.tempos = {{0, appModel->tempo()}};
-
-    auto [segments] = SingingClipSlicer::slice(timeline, m_notes.toList());
-
-    // Check if existing piece and segment are the same
-    // 1. Head padding length is the same
-    // 2. Note sequence is the same
-    // 3. Tail padding length is the same
-    auto isSamePiece = [](const InferPiece &left, const Segment &right) {
-        if (left.notes.count() != right.notes.count())
-            return false;
+// Check if existing piece and segment are the same
+// 1. Head padding length is the same
+// 2. Note sequence is the same
+// 3. Tail padding length is the same
+static bool isSamePiece(const InferPiece &left, const Segment &right) {
+    if (left.notes.count() != right.notes.count())
+        return false;
 
-        if (!qFuzzyCompare(left.paddingStartMs, right.paddingStartMs))
-            return false;
+    if (!qFuzzyCompare(left.paddingStartMs, right.paddingStartMs))
+        return false;
+
+    if (!qFuzzyCompare(left.paddingEndMs, right.paddingEndMs))
+        return false;
 
-        if (!qFuzzyCompare(left.paddingEndMs, right.paddingEndMs))
+    for (int i = 0; i < left.notes.count(); i++) {
+        if (left.notes[i] != right.notes[i])
             return false;
+    }
+    return true;
+}
 
-        for (int i = 0; i < left.notes.count(); i++) {
-            if (left.notes[i] != right.notes[i])
-                return false;
+static size_t notesKey(const QList<Note *> &notes) {
+    return qHashRange(notes.cbegin(), notes.cend());
+}
+
+void SingingClip::reSegment() {
+    auto [segments] = SingingClipSlicer::slice(appModel->timeline(), m_notes.toList());
+    PieceList discarded;
+    const auto pieces = buildPieces(segments, m_pieces, discarded);
+    replacePieces(pieces, discarded);
+}
+
+void SingingClip::reSegment(const QList<Note *> &changedNotes) {
+    const auto notes = m_notes.toList();
+    if (m_pieces.isEmpty() || notes.isEmpty()) {
+        reSegment();
+        return;
+    }
+
+    QHash<Note *, qsizetype> noteIndex;
+    noteIndex.reserve(notes.count());
+    for (qsizetype i = 0; i < notes.count(); i++)
+        noteIndex.insert(notes[i], i);
+    QHash<Note *, InferPiece *> cleanPieceOfNote;
+    for (const auto piece : std::as_const(m_pieces))
+        if (!piece->dirty)
+            for (const auto note : piece->notes)
+                cleanPieceOfNote.insert(note, piece);
+
+    // Notes removed from the clip are only safe to access if they are part of this change
+    const QSet<Note *> changedNoteSet(changedNotes.cbegin(), changedNotes.cend());
+    qsizetype first = notes.count();
+    qsizetype last = -1;
+    auto include = [&](const qsizetype index) {
+        first = qMin(first, index);
+        last = qMax(last, index);
+    };
+    auto includeNote = [&](Note *note) {
+        if (const auto it = noteIndex.constFind(note); it != noteIndex.constEnd()) {
+            include(*it);
+            return true;
         }
+        if (!changedNoteSet.contains(note))
+            return false;
+        // Removed from the clip: the notes it was between are affected
+        const auto it = std::lower_bound(
+            notes.cbegin(), notes.cend(), note->localStart(),
+            [](const Note *left, const int start) { return left->localStart() < start; });
+        const auto index = it - notes.cbegin();
+        include(qMax<qsizetype>(0, index - 1));
+        include(qMin(index, notes.count() - 1));
         return true;
     };
+    for (const auto note : changedNotes)
+        includeNote(note);
+    for (const auto piece : std::as_const(m_pieces)) {
+        if (!piece->dirty)
+            continue;
+        for (const auto note : piece->notes) {
+            if (!includeNote(note)) {
+                reSegment();
+                return;
+            }
+        }
+    }
+    if (last < 0) {
+        reSegment();
+        return;
+    }
+
+    // Widen the window to whole clean pieces. The clean piece next to the edited notes is
+    // re-sliced too, since it may merge with them; the boundary past it depends on unchanged
+    // notes only and is kept.
+    bool consistent = true;
+    auto pieceBoundary = [&](const InferPiece *piece, const bool start) {
+        const auto index = noteIndex.value(start ? piece->notes.first() : piece->notes.last(), -1);
+        if (index < 0)
+            consistent = false;
+        return index;
+    };
+    if (const auto piece = cleanPieceOfNote.value(notes[first]))
+        first = pieceBoundary(piece, true);
+    for (bool neighbourIncluded = false; consistent && first > 0;) {
+        const auto piece = cleanPieceOfNote.value(notes[first - 1]);
+        if (!piece)
+            first--;
+        else if (!neighbourIncluded) {
+            first = pieceBoundary(piece, true);
+            neighbourIncluded = true;
+        } else
+            break;
+    }
+    if (const auto piece = cleanPieceOfNote.value(notes[last]); consistent && piece)
+        last = pieceBoundary(piece, false);
+    for (bool neighbourIncluded = false; consistent && last < notes.count() - 1;) {
+        const auto piece = cleanPieceOfNote.value(notes[last + 1]);
+        if (!piece)
+            last++;
+        else if (!neighbourIncluded) {
+            last = pieceBoundary(piece, false);
+            neighbourIncluded = true;
+        } else
+            break;
+    }
+    if (!consistent) {
+        reSegment();
+        return;
+    }
+
+    const auto timeline = appModel->timeline();
+    double previousTailEndMs = 0;
+    if (first > 0) {
+        const auto previous = notes[first - 1];
+        previousTailEndMs = timeline.tickToMs(previous->globalStart() + previous->length()) +
+                            cleanPieceOfNote.value(previous)->paddingEndMs;
+    }
+    auto [segments] =
+        SingingClipSlicer::slice(timeline, notes.mid(first, last - first + 1), previousTailEndMs);
+
+    PieceList before;
+    PieceList window;
+    PieceList after;
+    for (const auto piece : std::as_const(m_pieces)) {
+        if (piece->dirty) {
+            window.append(piece);
+            continue;
+        }
+        const auto index = noteIndex.value(piece->notes.first());
+        if (index < first)
+            before.append(piece);
+        else if (index > last)
+            after.append(piece);
+        else
+            window.append(piece);
+    }
+
+    PieceList discarded;
+    auto pieces = before;
+    pieces.append(buildPieces(segments, window, discarded));
+    pieces.append(after);
+    replacePieces(pieces, discarded);
+}
 
-    PieceList newPieces;
+PieceList SingingClip::buildPieces(const QList<Segment> &segments, const PieceList &candidates,
+                                   PieceList &discarded) {
+    // Ignore dirty pieces, keep pieces that are not marked as dirty and are the same as before
+    QMultiHash<size_t, InferPiece *> cleanPieces;
+    for (const auto piece : candidates)
+        if (!piece->dirty)
+            cleanPieces.insert(notesKey(piece->notes), piece);
+
+    QSet<InferPiece *> reused;
+    PieceList result;
     for (const auto &segment : segments) {
-        bool exists = false;
-        for (int i = 0; i < m_pieces.count(); i++) {
-            const auto piece = m_pieces[i];
-            // Ignore dirty segments, keep segments that are not marked as dirty and are the same as before
-            if (!piece->dirty && isSamePiece(*piece, segment)) {
-                exists = true;
-                // Although it's still the same segment, the head available space may have changed and needs to be updated
-                piece->headAvailableLengthMs = segment.headAvailableLengthMs;
-                newPieces.append(piece);
-                m_pieces.removeAt(i);
+        const auto key = notesKey(segment.notes);
+        InferPiece *existing = nullptr;
+        for (auto [it, end] = cleanPieces.equal_range(key); it != end; ++it) {
+            if (isSamePiece(**it, segment)) {
+                existing = *it;
                 break;
             }
         }
-        if (!exists) {
+        if (existing) {
+            cleanPieces.remove(key, existing);
+            reused.insert(existing);
+            // Although it's still the same segment, the head available space may have changed and needs to be updated
+            existing->headAvailableLengthMs = segment.headAvailableLengthMs;
+            result.append(existing);
+        } else {
             const auto newPiece = new InferPiece(this);
             newPiece->identifier = singerIdentifier();
             newPiece->speaker = speakerId();
@@ -124,15 +308,21 @@ void SingingClip::reSegment() {
             newPiece->headAvailableLengthMs = segment.headAvailableLengthMs;
             newPiece->paddingStartMs = segment.paddingStartMs;
             newPiece->paddingEndMs = segment.paddingEndMs;
-            newPieces.append(newPiece);
+            result.append(newPiece);
         }
     }
-    PieceList temp = m_pieces;
-    m_pieces.clear();
-    m_pieces = newPieces;
-    emit piecesChanged(m_pieces, newPieces, temp);
+    for (const auto piece : candidates)
+        if (!reused.contains(piece))
+            discarded.append(piece);
+    return result;
+}
+
+void SingingClip::replacePieces(const PieceList &pieces, const PieceList &discarded) {
+    m_pieces = pieces;
+    rebuildPieceIndex();
+    emit piecesChanged(m_pieces, m_pieces, discarded);
     qInfo() << "piecesChanged";
-    for (const auto piece : temp)
+    for (const auto piece : discarded)
         delete piece;
 }
 
@@ -156,16 +346,38 @@ InferPiece *SingingClip::findPieceById(const int id) const {
 PieceList SingingClip::findPiecesByNotes(const QList<Note *> &notes) const {
     QSet<InferPiece *> result;
     for (const auto &note : notes) {
-        for (const auto &piece : m_pieces) {
-            if (std::find(piece->notes.begin(), piece->notes.end(), note) != piece->notes.end()) {
-                result.insert(piece);
-                break;
-            }
+        if (const auto piece = m_pieceByNoteId.value(note->id()))
+            result.insert(piece);
+        else if (note->clip() == this) {
+            // Not sliced yet, e.g. just inserted: the pieces it lands on are affected
+            for (const auto overlapped :
+                 findPiecesByTickRange(note->localStart(), note->localStart() + note->length()))
+                result.insert(overlapped);
         }
     }
     return {result.begin(), result.end()}; // 将 QSet 转换为 QList 返回
 }
 
+PieceList SingingClip::findPiecesByTickRange(const int start, const int end) const {
+    PieceList result;
+    m_pieceIntervals.overlap_find_all(PieceInterval(start, end, nullptr), [&result](auto it) {
+        result.append(it->interval().piece);
+        return true;
+    });
+    return result;
+}
+
+void SingingClip::rebuildPieceIndex() {
+    m_pieceByNoteId.clear();
+    m_pieceIntervals.clear();
+    for (const auto piece : std::as_const(m_pieces)) {
+        for (const auto note : piece->notes)
+            m_pieceByNoteId.insert(note->id(), piece);
+        m_pieceIntervals.insert(
+            PieceInterval(piece->localStartTick(), piece->localEndTick(), piece));
+    }
+}
+
 void SingingClip::setDefaultLanguage(const QString &language) {
     m_defaultLanguage = language;
     this->updateDefaultG2pId(language);
@@ -220,6 +432,8 @@ SingerIdentifier SingingClip::singerIdentifier() const {
 }
 
 void SingingClip::init() {
+    // Paddings are in milliseconds, so the tick ranges of the pieces move with the tempo
+    connect(appModel, &AppModel::tempoChanged, this, [this] { rebuildPieceIndex(); });
     m_defaultLanguage.onChanged(qSignalCallback(defaultLanguageChanged));
     m_singerInfo.onChanged([this](const SingerInfo &) {
         if (!useTrackSingerInfo) {
@@ -6,8 +6,10 @@
 #define SINGINGCLIP_H
 
 #include "Clip.h"
+#include "NoteBatch.h"
 #include "Params.h"
 #include "Global/AppGlobal.h"
+#include "Utils/FlatOverlappableList.h"
 #include "Utils/Property.h"
 #include "Modules/Inference/Models/SingerIdentifier.h"
 #include "Modules/PackageManager/Models/SingerInfo.h"
@@ -16,6 +18,7 @@
 class DrawCurve;
 class InferPiece;
 class Note;
+class Segment;
 
 using PieceList = QList<InferPiece *>;
 
@@ -36,19 +39,30 @@ public:
     ~SingingClip() override;
 
     ClipType clipType() const override;
-    const OverlappableSerialList<Note> &notes() const;
+    const FlatOverlappableList<Note> &notes() const;
 
     void insertNote(Note *note);
     void insertNotes(const QList<Note *> &notes);
     void removeNote(Note *note);
+    // Updates the note list once for all the edits, then emits noteChanged once per kind of change
+    // (Remove, TimeKeyPropertyChange, Insert, in that order) and noteBatchApplied with every note
+    // involved. Listeners that rebuild derived data should do it on noteBatchApplied, and skip
+    // the noteChanged signals emitted while isApplyingNoteBatch() is true.
+    void applyNoteBatch(const NoteBatch &batch);
+    [[nodiscard]] bool isApplyingNoteBatch() const;
     Note *findNoteById(int id) const;
     void notifyNoteChanged(NoteChangeType type, const QList<Note *> &notes);
     void notifyParamChanged(ParamInfo::Name name, Param::Type type);
     const PieceList &pieces() const;
     void reSegment();
+    // Only re-slices the notes around the changed notes and the dirty pieces, up to the nearest
+    // clean pieces. Falls back to reSegment() when the window can not be determined.
+    void reSegment(const QList<Note *> &changedNotes);
     void updateOriginalParam(ParamInfo::Name name);
     InferPiece *findPieceById(int id) const;
     PieceList findPiecesByNotes(const QList<Note *> &notes) const;
+    // Pieces whose range, paddings included, overlaps [start, end) in local ticks
+    PieceList findPiecesByTickRange(int start, int end) const;
 
     void setDefaultLanguage(const QString &language);
     QString defaultLanguage() const;
@@ -74,6 +88,7 @@ signals:
     void singerChanged(const SingerInfo &identifier);
     void speakerChanged(const SpeakerInfo &speaker);
     void noteChanged(SingingClip::NoteChangeType type, const QList<Note *> &notes);
+    void noteBatchApplied(const QList<Note *> &notes);
     void paramChanged(ParamInfo::Name name, Param::Type type);
     void defaultLanguageChanged(QString language);
     void defaultG2pIdChanged(QString g2pId);
@@ -83,9 +98,28 @@ signals:
 private:
     void init();
     void updateDefaultG2pId(const QString &language);
+    // Reuses the clean pieces in candidates that match a segment; the others go to discarded
+    PieceList buildPieces(const QList<Segment> &segments, const PieceList &candidates,
+                          PieceList &discarded);
+    void replacePieces(const PieceList &pieces, const PieceList &discarded);
+    void rebuildPieceIndex();
+
+    struct PieceInterval : lib_interval_tree::interval<int, lib_interval_tree::right_open> {
+        InferPiece *piece;
+
+        PieceInterval(const int start, const int end, InferPiece *piece)
+            : lib_interval_tree::interval<int, lib_interval_tree::right_open>(
+                  start, std::max(start + 1, end)),
+              piece(piece) {
+        }
+    };
 
-    OverlappableSerialList<Note> m_notes;
+    FlatOverlappableList<Note> m_notes;
+    bool m_applyingNoteBatch = false;
     PieceList m_pieces;
+    // Rebuilt whenever the pieces change, see rebuildPieceIndex()
+    QHash<int, InferPiece *> m_pieceByNoteId;
+    lib_interval_tree::interval_tree<PieceInterval> m_pieceIntervals;
 
     Property<QString> m_defaultLanguage{"unknown"};
     Property<QString> m_defaultG2pId{"unknown"};
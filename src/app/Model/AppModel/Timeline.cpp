@@ -4,13 +4,54 @@
 
 #include "Timeline.h"
 
-// TODO 支持多曲速
+#include <algorithm>
+
+static constexpr int ticksPerQuarterNote = 480;
+static constexpr int ticksPerWholeNote = 1920;
+
+static double msPerTickOf(const double bpm) {
+    return 60000.0 / ticksPerQuarterNote / bpm;
+}
+
+static int barTicksOf(const TimeSignature &timeSignature) {
+    return ticksPerWholeNote * timeSignature.numerator / timeSignature.denominator;
+}
+
+Timeline::Timeline() : Timeline({Tempo()}) {
+}
+
+Timeline::Timeline(const QList<Tempo> &tempos, const QList<TimeSignature> &timeSignatures)
+    : m_tempos(tempos), m_timeSignatures(timeSignatures) {
+    rebuildTempoMap();
+    rebuildBarMap();
+}
+
+const QList<Tempo> &Timeline::tempos() const {
+    return m_tempos;
+}
+
+void Timeline::setTempos(const QList<Tempo> &tempos) {
+    m_tempos = tempos;
+    rebuildTempoMap();
+}
+
+const QList<TimeSignature> &Timeline::timeSignatures() const {
+    return m_timeSignatures;
+}
+
+void Timeline::setTimeSignatures(const QList<TimeSignature> &timeSignatures) {
+    m_timeSignatures = timeSignatures;
+    rebuildBarMap();
+}
+
 double Timeline::tickToMs(const double tick) const {
-    return tick * 60 / tempos.first().value / 480 * 1000;
+    const auto i = tempoIndexOfTick(tick);
+    return m_tempoStartMs[i] + (tick - m_tempos[i].pos) * m_msPerTick[i];
 }
 
 double Timeline::msToTick(const double ms) const {
-    return ms * 480 * tempos.first().value / 60000;
+    const auto i = tempoIndexOfMs(ms);
+    return m_tempos[i].pos + (ms - m_tempoStartMs[i]) / m_msPerTick[i];
 }
 
 double Timeline::tickToSec(double tick) const {
@@ -21,22 +62,120 @@ double Timeline::secToTick(double ms) const {
     return msToTick(ms * 1000.0);
 }
 
+double Timeline::tickLengthToSec(const double tick, const double length) const {
+    return tickToSec(tick + length) - tickToSec(tick);
+}
+
+void Timeline::tickToMs(const std::span<const double> ticks, const std::span<double> outMs) const {
+    Q_ASSERT(outMs.size() >= ticks.size());
+    const auto tempoCount = m_tempos.count();
+    qsizetype i = 0;
+    for (size_t k = 0; k < ticks.size(); k++) {
+        const auto tick = ticks[k];
+        if (tick < m_tempos[i].pos)
+            i = tempoIndexOfTick(tick);
+        else
+            while (i + 1 < tempoCount && m_tempos[i + 1].pos <= tick)
+                i++;
+        outMs[k] = m_tempoStartMs[i] + (tick - m_tempos[i].pos) * m_msPerTick[i];
+    }
+}
+
+void Timeline::msToTick(const std::span<const double> ms, const std::span<double> outTicks) const {
+    Q_ASSERT(outTicks.size() >= ms.size());
+    const auto tempoCount = m_tempos.count();
+    qsizetype i = 0;
+    for (size_t k = 0; k < ms.size(); k++) {
+        const auto value = ms[k];
+        if (value < m_tempoStartMs[i])
+            i = tempoIndexOfMs(value);
+        else
+            while (i + 1 < tempoCount && m_tempoStartMs[i + 1] <= value)
+                i++;
+        outTicks[k] = m_tempos[i].pos + (value - m_tempoStartMs[i]) / m_msPerTick[i];
+    }
+}
+
 QString Timeline::getBarBeatTickTime(const int ticks) const {
-    const auto timeSignature = timeSignatures.first();
-    const int barTicks = 1920 * timeSignature.numerator / timeSignature.denominator;
-    const int beatTicks = 1920 / timeSignature.denominator;
-    const auto bar = ticks / barTicks + 1;
-    const auto beat = ticks % barTicks / beatTicks + 1;
-    const auto tick = ticks % barTicks % beatTicks;
+    const auto it = std::upper_bound(m_signatureStartTicks.cbegin() + 1,
+                                     m_signatureStartTicks.cend(), ticks);
+    const auto i = it - m_signatureStartTicks.cbegin() - 1;
+    const auto &timeSignature = m_timeSignatures[i];
+    const int barTicks = barTicksOf(timeSignature);
+    const int beatTicks = ticksPerWholeNote / timeSignature.denominator;
+    const auto relativeTicks = ticks - m_signatureStartTicks[i];
+    const auto bar = timeSignature.pos + relativeTicks / barTicks + 1;
+    const auto beat = relativeTicks % barTicks / beatTicks + 1;
+    const auto tick = relativeTicks % barTicks % beatTicks;
     auto str = QString::asprintf("%03d", bar) + ":" + QString::asprintf("%02d", beat) + ":" +
                QString::asprintf("%03d", tick);
     return str;
 }
 
+void Timeline::rebuildTempoMap() {
+    m_tempos.removeIf([](const Tempo &tempo) { return tempo.value <= 0; });
+    std::stable_sort(m_tempos.begin(), m_tempos.end(),
+                     [](const Tempo &left, const Tempo &right) { return left.pos < right.pos; });
+    // The last tempo at a position wins
+    for (qsizetype i = m_tempos.count() - 1; i > 0; i--)
+        if (m_tempos[i - 1].pos == m_tempos[i].pos)
+            m_tempos.removeAt(i - 1);
+    if (m_tempos.isEmpty())
+        m_tempos.append(Tempo());
+    m_tempos.first().pos = 0;
+
+    m_tempoStartMs.resize(m_tempos.count());
+    m_msPerTick.resize(m_tempos.count());
+    double startMs = 0;
+    for (qsizetype i = 0; i < m_tempos.count(); i++) {
+        if (i > 0)
+            startMs += (m_tempos[i].pos - m_tempos[i - 1].pos) * m_msPerTick[i - 1];
+        m_tempoStartMs[i] = startMs;
+        m_msPerTick[i] = msPerTickOf(m_tempos[i].value);
+    }
+}
+
+void Timeline::rebuildBarMap() {
+    m_timeSignatures.removeIf([](const TimeSignature &timeSignature) {
+        return timeSignature.numerator <= 0 || timeSignature.denominator <= 0;
+    });
+    std::stable_sort(m_timeSignatures.begin(), m_timeSignatures.end(),
+                     [](const TimeSignature &left, const TimeSignature &right) {
+                         return left.pos < right.pos;
+                     });
+    for (qsizetype i = m_timeSignatures.count() - 1; i > 0; i--)
+        if (m_timeSignatures[i - 1].pos == m_timeSignatures[i].pos)
+            m_timeSignatures.removeAt(i - 1);
+    if (m_timeSignatures.isEmpty())
+        m_timeSignatures.append(TimeSignature());
+    m_timeSignatures.first().pos = 0;
+
+    m_signatureStartTicks.resize(m_timeSignatures.count());
+    int startTick = 0;
+    for (qsizetype i = 0; i < m_timeSignatures.count(); i++) {
+        if (i > 0)
+            startTick += (m_timeSignatures[i].pos - m_timeSignatures[i - 1].pos) *
+                         barTicksOf(m_timeSignatures[i - 1]);
+        m_signatureStartTicks[i] = startTick;
+    }
+}
+
+qsizetype Timeline::tempoIndexOfTick(const double tick) const {
+    const auto it = std::upper_bound(
+        m_tempos.cbegin() + 1, m_tempos.cend(), tick,
+        [](const double value, const Tempo &tempo) { return value < tempo.pos; });
+    return it - m_tempos.cbegin() - 1;
+}
+
+qsizetype Timeline::tempoIndexOfMs(const double ms) const {
+    const auto it = std::upper_bound(m_tempoStartMs.cbegin() + 1, m_tempoStartMs.cend(), ms);
+    return it - m_tempoStartMs.cbegin() - 1;
+}
+
 bool operator==(const Timeline &lhs, const Timeline &rhs) {
-    return lhs.tempos == rhs.tempos && lhs.timeSignatures == rhs.timeSignatures;
+    return lhs.m_tempos == rhs.m_tempos && lhs.m_timeSignatures == rhs.m_timeSignatures;
 }
 
 bool operator!=(const Timeline &lhs, const Timeline &rhs) {
     return !(lhs == rhs);
-}
\ No newline at end of file
+}
@@ -8,24 +8,58 @@
 #include "Tempo.h"
 #include "TimeSignature.h"
 
+#include <span>
+
 #include <QList>
 
+// Tempo map of a project. Tempos are sorted by tick and the start time of each one is
+// precomputed, so conversions in both directions are binary searches. The first tempo always
+// starts at tick 0; ticks before it use the first tempo.
+// TimeSignature::pos is the bar index the signature starts at, as in .dspx.
 class Timeline {
 public:
-    QList<Tempo> tempos;
-    QList<TimeSignature> timeSignatures;
+    Timeline();
+    explicit Timeline(const QList<Tempo> &tempos,
+                      const QList<TimeSignature> &timeSignatures = {TimeSignature()});
+
+    [[nodiscard]] const QList<Tempo> &tempos() const;
+    void setTempos(const QList<Tempo> &tempos);
+    [[nodiscard]] const QList<TimeSignature> &timeSignatures() const;
+    void setTimeSignatures(const QList<TimeSignature> &timeSignatures);
 
     [[nodiscard]] double tickToMs(double tick) const;
     [[nodiscard]] double msToTick(double ms) const;
 
     [[nodiscard]] double tickToSec(double tick) const;
     [[nodiscard]] double secToTick(double ms) const;
+
+    // Length starting at a position, taking the tempos it spans into account
+    [[nodiscard]] double tickLengthToSec(double tick, double length) const;
+
+    // Batch conversions for curve resampling. Ascending input is converted in a single pass
+    // over the tempo map; unsorted input is still correct but searches for each value.
+    void tickToMs(std::span<const double> ticks, std::span<double> outMs) const;
+    void msToTick(std::span<const double> ms, std::span<double> outTicks) const;
+
     [[nodiscard]] QString getBarBeatTickTime(int ticks) const;
 
     friend bool operator==(const Timeline &lhs, const Timeline &rhs);
 
     friend bool operator!=(const Timeline &lhs, const Timeline &rhs);
+
+private:
+    void rebuildTempoMap();
+    void rebuildBarMap();
+    [[nodiscard]] qsizetype tempoIndexOfTick(double tick) const;
+    [[nodiscard]] qsizetype tempoIndexOfMs(double ms) const;
+
+    QList<Tempo> m_tempos;
+    QList<double> m_tempoStartMs; // Start time of each tempo
+    QList<double> m_msPerTick;    // Of each tempo
+
+    QList<TimeSignature> m_timeSignatures;
+    QList<int> m_signatureStartTicks; // Start tick of each time signature
 };
 
 
-#endif // DS_EDITOR_LITE_TIMELINE_H
\ No newline at end of file
+#endif // DS_EDITOR_LITE_TIMELINE_H
@@ -13,6 +13,12 @@ void AppearanceOption::load(const QJsonObject &object) {
         animationLevel = animationLevelFromString(object.value(animationLevelKey).toString());
     if (object.contains(animationTimeScaleKey))
         animationTimeScale = object.value(animationTimeScaleKey).toDouble();
+    if (object.contains(showFrameTimeKey))
+        showFrameTime = object.value(showFrameTimeKey).toBool();
+    if (object.contains(virtualizeNoteViewsKey))
+        virtualizeNoteViews = object.value(virtualizeNoteViewsKey).toBool();
+    if (object.contains(smoothPlaybackFollowKey))
+        smoothPlaybackFollow = object.value(smoothPlaybackFollowKey).toBool();
 }
 
 void AppearanceOption::save(QJsonObject &object) {
@@ -20,6 +26,9 @@ void AppearanceOption::save(QJsonObject &object) {
     object.insert(enableDirectManipulationKey, enableDirectManipulation);
     object.insert(animationLevelKey, animationLevelToString(animationLevel));
     object.insert(animationTimeScaleKey, animationTimeScale);
+    object.insert(showFrameTimeKey, showFrameTime);
+    object.insert(virtualizeNoteViewsKey, virtualizeNoteViews);
+    object.insert(smoothPlaybackFollowKey, smoothPlaybackFollow);
 }
 
 AnimationGlobal::AnimationLevels AppearanceOption::animationLevelFromString(const QString &name) {
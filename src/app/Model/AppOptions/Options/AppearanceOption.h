@@ -24,6 +24,9 @@ public:
     bool enableDirectManipulation = true;
     AnimationGlobal::AnimationLevels animationLevel = AnimationGlobal::Full;
     double animationTimeScale = 1;
+    bool showFrameTime = false;
+    bool virtualizeNoteViews = true;
+    bool smoothPlaybackFollow = false;
 
     static AnimationGlobal::AnimationLevels animationLevelFromString(const QString &name);
     static QString animationLevelToString(AnimationGlobal::AnimationLevels level);
@@ -36,6 +39,9 @@ private:
     const QString enableDirectManipulationKey = "enableDirectManipulation";
     const QString animationLevelKey = "animationLevel";
     const QString animationTimeScaleKey = "animationTimeScale";
+    const QString showFrameTimeKey = "showFrameTime";
+    const QString virtualizeNoteViewsKey = "virtualizeNoteViews";
+    const QString smoothPlaybackFollowKey = "smoothPlaybackFollow";
 };
 
 #endif // APPEARANCEOPTION_H
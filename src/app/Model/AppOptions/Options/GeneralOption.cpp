@@ -46,6 +46,14 @@ void GeneralOption::load(const QJsonObject &object) {
         somePath = object[somePathKey].toString();
     if (object.contains(rmvpePathKey))
         rmvpePath = object[rmvpePathKey].toString();
+    if (object.contains(historyMaxStepsKey))
+        historyMaxSteps = object[historyMaxStepsKey].toInt();
+    if (object.contains(historyMemoryLimitMbKey))
+        historyMemoryLimitMb = object[historyMemoryLimitMbKey].toInt();
+    if (object.contains(packDenseCurvesKey))
+        packDenseCurves = object[packDenseCurvesKey].toBool();
+    if (object.contains(autoSaveIntervalMinKey))
+        autoSaveIntervalMin = object[autoSaveIntervalMinKey].toInt();
 }
 
 void GeneralOption::save(QJsonObject &object) {
@@ -61,7 +69,11 @@ void GeneralOption::save(QJsonObject &object) {
         serialize_defaultSpeakerId(),
 #endif
         serialize_somePath(),
-        serialize_rmvpePath()
+        serialize_rmvpePath(),
+        serialize_historyMaxSteps(),
+        serialize_historyMemoryLimitMb(),
+        serialize_packDenseCurves(),
+        serialize_autoSaveIntervalMin()
     };
 }
 
@@ -32,6 +32,13 @@ public:
 #endif
     LITE_OPTION_ITEM(QString, somePath, QString())
     LITE_OPTION_ITEM(QString, rmvpePath, QString())
+    // Undo history limits, 0 for unlimited. The oldest steps are dropped first.
+    LITE_OPTION_ITEM(int, historyMaxSteps, 1000)
+    LITE_OPTION_ITEM(int, historyMemoryLimitMb, 512)
+    // Save dense free curves packed into the clip workspace. Other .dspx readers see them empty.
+    LITE_OPTION_ITEM(bool, packDenseCurves, false)
+    // Minutes between auto saves of unsaved changes, 0 to disable
+    LITE_OPTION_ITEM(int, autoSaveIntervalMin, 5)
 
 
 public:
@@ -36,6 +36,16 @@ void InferenceOption::load(const QJsonObject &object) {
         autoStartInfer = object[autoStartInferKey].toBool();
     if (object.contains(pitch_smooth_kernel_sizeKey))
         pitch_smooth_kernel_size = object[pitch_smooth_kernel_sizeKey].toInt();
+    if (object.contains(autoTuneConcurrencyKey))
+        autoTuneConcurrency = object[autoTuneConcurrencyKey].toBool();
+    if (object.contains(durationConcurrencyKey))
+        durationConcurrency = object[durationConcurrencyKey].toInt();
+    if (object.contains(pitchConcurrencyKey))
+        pitchConcurrency = object[pitchConcurrencyKey].toInt();
+    if (object.contains(varianceConcurrencyKey))
+        varianceConcurrency = object[varianceConcurrencyKey].toInt();
+    if (object.contains(acousticConcurrencyKey))
+        acousticConcurrency = object[acousticConcurrencyKey].toInt();
 }
 
 void InferenceOption::save(QJsonObject &object) {
@@ -47,6 +57,11 @@ void InferenceOption::save(QJsonObject &object) {
               serialize_runVocoderOnCpu(),
               serialize_autoStartInfer(),
               serialize_cacheDirectory(),
-              serialize_pitch_smooth_kernel_size()
+              serialize_pitch_smooth_kernel_size(),
+              serialize_autoTuneConcurrency(),
+              serialize_durationConcurrency(),
+              serialize_pitchConcurrency(),
+              serialize_varianceConcurrency(),
+              serialize_acousticConcurrency()
     };
 }
\ No newline at end of file
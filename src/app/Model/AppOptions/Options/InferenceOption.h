@@ -29,6 +29,13 @@ public:
                          "/Cache")
 
     LITE_OPTION_ITEM(int, pitch_smooth_kernel_size, 0)
+
+    LITE_OPTION_ITEM(bool, autoTuneConcurrency, false)
+    // Concurrent tasks per infer stage, used when auto-tuning is off
+    LITE_OPTION_ITEM(int, durationConcurrency, 1)
+    LITE_OPTION_ITEM(int, pitchConcurrency, 1)
+    LITE_OPTION_ITEM(int, varianceConcurrency, 1)
+    LITE_OPTION_ITEM(int, acousticConcurrency, 1)
 };
 
 
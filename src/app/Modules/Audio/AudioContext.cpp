@@ -10,6 +10,10 @@
 #include <QBoxLayout>
 #include <QFormLayout>
 #include <QComboBox>
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
 
 #include <TalcsCore/MixerAudioSource.h>
 #include <TalcsCore/PositionableMixerAudioSource.h>
@@ -30,6 +34,7 @@
 #include <Modules/Audio/subsystem/OutputSystem.h>
 #include <Modules/Audio/AudioSettings.h>
 #include <Modules/Audio/TrackSynthesizer.h>
+#include <Modules/Audio/utils/LevelMeterChannel.h>
 
 #include "Model/AppModel/Track.h"
 #include "Model/AppModel/LoopSettings.h"
@@ -170,48 +175,11 @@ AudioContext::AudioContext(QObject *parent) : DspxProjectContext(parent) {
         }
     });
 
-    masterChannel = new Track;
-    m_trackLevelMeterValue[masterChannel] = {std::make_shared<talcs::SmoothedFloat>(-96),
-                                             std::make_shared<talcs::SmoothedFloat>(-96)};
-    m_trackLevelMeterValue[masterChannel].first->setRampLength(
-        m_levelMeterRampLength); // TODO make it configurable
-    m_trackLevelMeterValue[masterChannel].second->setRampLength(m_levelMeterRampLength);
-    auto trackControlMixer = masterControlMixer();
-    trackControlMixer->setLevelMeterChannelCount(2);
-    connect(trackControlMixer, &talcs::PositionableMixerAudioSource::levelMetered, this,
-            [trackControlMixer, this](QVector<float> values) {
-                // if (!m_trackLevelMeterValue.contains(masterChannel))
-                //     return;
-                if (masterTrackMixer()->isMutedBySoloSetting(trackControlMixer))
-                    values = {0, 0};
-                updateTrackLevelMeterValue(masterChannel, values);
-            });
+    m_masterLevelMeter = createLevelMeter(masterControlMixer());
 
     m_levelMeterTimer = new QTimer(this);
-    m_levelMeterTimer->setInterval(8); // TODO make it configurable
-    connect(m_levelMeterTimer, &QTimer::timeout, this, [this] {
-        AppModel::LevelMetersUpdatedArgs args;
-
-        auto addChannelLevel = [&](const Track *track) {
-            if (playbackController->playbackStatus() != Playing &&
-                (m_trackLevelMeterValue[track].first->targetValue() > -96 ||
-                 m_trackLevelMeterValue[track].second->targetValue() > -96)) {
-                m_trackLevelMeterValue[track].first->setTargetValue(-96);
-                m_trackLevelMeterValue[track].second->setTargetValue(-96);
-            }
-            args.trackMeterStates.append({m_trackLevelMeterValue[track].first->nextValue(),
-                                          m_trackLevelMeterValue[track].second->nextValue()});
-        };
-        for (const auto track : appModel->tracks()) {
-            if (!m_trackLevelMeterValue.contains(track))
-                continue;
-            addChannelLevel(track);
-        }
-        // Add master level
-        addChannelLevel(masterChannel);
-        emit levelMeterUpdated(args);
-    });
-    m_levelMeterTimer->start();
+    m_levelMeterTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_levelMeterTimer, &QTimer::timeout, this, &AudioContext::updateLevelMeters);
 
     new PseudoSingerConfigNotifier(this);
 
@@ -290,6 +258,7 @@ void AudioContext::handlePlaybackStatusChanged(const PlaybackStatus status) {
                     playbackController->setLastPosition(playbackController->position());
             }
             transport()->play();
+            startLevelMeters();
             break;
         case Paused:
             transport()->pause();
@@ -346,31 +315,7 @@ void AudioContext::handleTrackInserted(const int index, Track *track) {
                 }
             });
 
-    m_trackLevelMeterValue[track] = {std::make_shared<talcs::SmoothedFloat>(-96),
-                                     std::make_shared<talcs::SmoothedFloat>(-96)};
-    m_trackLevelMeterValue[track].first->setRampLength(
-        m_levelMeterRampLength); // TODO make it configurable
-    m_trackLevelMeterValue[track].second->setRampLength(m_levelMeterRampLength);
-    auto trackControlMixer = trackContext->controlMixer();
-    trackControlMixer->setLevelMeterChannelCount(2);
-    connect(trackControlMixer, &talcs::PositionableMixerAudioSource::levelMetered, this,
-            [track, trackControlMixer, this](QVector<float> values) {
-                if (!m_trackLevelMeterValue.contains(track))
-                    return;
-                if (masterTrackMixer()->isMutedBySoloSetting(trackControlMixer))
-                    values = {0, 0};
-                const auto dBL = static_cast<float>(talcs::Decibels::gainToDecibels(values[0]));
-                const auto dBR = static_cast<float>(talcs::Decibels::gainToDecibels(values[1]));
-                if (dBL < m_trackLevelMeterValue[track].first->currentValue())
-                    m_trackLevelMeterValue[track].first->setTargetValue(dBL);
-                else
-                    m_trackLevelMeterValue[track].first->setCurrentAndTargetValue(dBL);
-
-                if (dBR < m_trackLevelMeterValue[track].second->currentValue())
-                    m_trackLevelMeterValue[track].second->setTargetValue(dBR);
-                else
-                    m_trackLevelMeterValue[track].second->setCurrentAndTargetValue(dBR);
-            });
+    m_trackLevelMeters.insert(index, createLevelMeter(trackContext->controlMixer()));
 
     // m_trackSynthDict.insert(track, new TrackSynthesizer(trackContext, track));
     m_trackInferDict.insert(track, new TrackInferenceHandler(trackContext, track));
@@ -387,7 +332,7 @@ void AudioContext::handleTrackRemoved(const int index, Track *track) {
     removeTrack(index);
     m_trackInferDict.remove(track);
     m_trackModelDict.remove(track);
-    m_trackLevelMeterValue.remove(track);
+    m_trackLevelMeters.removeAt(index);
 }
 
 void AudioContext::handleMasterControlChanged(const TrackControl &control) const {
@@ -488,16 +433,81 @@ void AudioContext::willFinishCallback(AudioExporter *exporter) {
     m_exporter = nullptr;
 }
 
-void AudioContext::updateTrackLevelMeterValue(const Track *track, QList<float> values) {
-    const auto dBL = static_cast<float>(talcs::Decibels::gainToDecibels(values[0]));
-    const auto dBR = static_cast<float>(talcs::Decibels::gainToDecibels(values[1]));
-    if (dBL < m_trackLevelMeterValue[track].first->currentValue())
-        m_trackLevelMeterValue[track].first->setTargetValue(dBL);
-    else
-        m_trackLevelMeterValue[track].first->setCurrentAndTargetValue(dBL);
-
-    if (dBR < m_trackLevelMeterValue[track].second->currentValue())
-        m_trackLevelMeterValue[track].second->setTargetValue(dBR);
-    else
-        m_trackLevelMeterValue[track].second->setCurrentAndTargetValue(dBR);
+AudioContext::TrackLevelMeter
+    AudioContext::createLevelMeter(talcs::PositionableMixerAudioSource *mixer) {
+    TrackLevelMeter meter;
+    meter.mixer = mixer;
+    meter.channel = std::make_shared<LevelMeterChannel>();
+    meter.valueL = std::make_shared<talcs::SmoothedFloat>(-96);
+    meter.valueR = std::make_shared<talcs::SmoothedFloat>(-96);
+    mixer->setLevelMeterChannelCount(2);
+    // Runs on the audio thread, the channel outlives the mixer in this connection
+    connect(
+        mixer, &talcs::PositionableMixerAudioSource::levelMetered, this,
+        [channel = meter.channel](const QVector<float> &values) {
+            channel->publish(values[0], values[1]);
+        },
+        Qt::DirectConnection);
+    return meter;
+}
+
+void AudioContext::startLevelMeters() {
+    const auto screen = QGuiApplication::primaryScreen();
+    const auto refreshRate = screen ? screen->refreshRate() : 60.0;
+    const auto interval = qBound(4, qRound(1000 / refreshRate), 33);
+    // Keep the fall time of the meters independent of the refresh rate
+    const auto rampLength = qMax(1, m_levelMeterFallTime / interval);
+    auto setRampLength = [rampLength](const TrackLevelMeter &meter) {
+        meter.valueL->setRampLength(rampLength);
+        meter.valueR->setRampLength(rampLength);
+    };
+    for (const auto &meter : m_trackLevelMeters)
+        setRampLength(meter);
+    setRampLength(m_masterLevelMeter);
+    m_levelMeterTimer->setInterval(interval);
+    if (!m_levelMeterTimer->isActive())
+        m_levelMeterTimer->start();
+}
+
+void AudioContext::updateLevelMeters() {
+    const auto playing = playbackController->playbackStatus() == Playing;
+    auto &states = m_levelMetersArgs.trackMeterStates;
+    states.resize(m_trackLevelMeters.count() + 1);
+    for (qsizetype i = 0; i < m_trackLevelMeters.count(); i++)
+        updateLevelMeter(m_trackLevelMeters[i], states[i], playing);
+    // Add master level
+    updateLevelMeter(m_masterLevelMeter, states.last(), playing);
+    emit levelMeterUpdated(m_levelMetersArgs);
+
+    if (playing)
+        return;
+    const auto fallen = std::all_of(states.cbegin(), states.cend(), [](const auto &state) {
+        return state.valueL <= -96 && state.valueR <= -96;
+    });
+    if (fallen)
+        m_levelMeterTimer->stop();
+}
+
+void AudioContext::updateLevelMeter(TrackLevelMeter &meter,
+                                    AppModel::LevelMetersUpdatedArgs::State &state,
+                                    const bool playing) {
+    auto [gainL, gainR] = meter.channel->take();
+    if (masterTrackMixer()->isMutedBySoloSetting(meter.mixer))
+        gainL = gainR = 0;
+
+    auto applyGain = [playing](talcs::SmoothedFloat &value, const float gain) {
+        if (!playing) {
+            if (value.targetValue() > -96)
+                value.setTargetValue(-96);
+            return;
+        }
+        const auto dB = static_cast<float>(talcs::Decibels::gainToDecibels(gain));
+        if (dB < value.currentValue())
+            value.setTargetValue(dB);
+        else
+            value.setCurrentAndTargetValue(dB);
+    };
+    applyGain(*meter.valueL, gainL);
+    applyGain(*meter.valueR, gainR);
+    state = {meter.valueL->nextValue(), meter.valueR->nextValue()};
 }
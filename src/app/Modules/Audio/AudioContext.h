@@ -27,6 +27,7 @@ namespace talcs {
 
 class TrackSynthesizer;
 class AudioContextAudioExporterListener;
+class LevelMeterChannel;
 
 class AudioContext : public talcs::DspxProjectContext, public Audio::AudioExporterListener {
     Q_OBJECT
@@ -68,13 +69,21 @@ private:
     QHash<Track *, TrackSynthesizer *> m_trackSynthDict;
     QHash<Track *, TrackInferenceHandler *> m_trackInferDict;
 
+    // The audio thread publishes the peaks of every mixer channel, the timer polls them at the
+    // display refresh rate while playing and until the meters have fallen after a stop.
+    struct TrackLevelMeter {
+        talcs::PositionableMixerAudioSource *mixer = nullptr;
+        std::shared_ptr<LevelMeterChannel> channel;
+        std::shared_ptr<talcs::SmoothedFloat> valueL;
+        std::shared_ptr<talcs::SmoothedFloat> valueR;
+    };
+
     QTimer *m_levelMeterTimer;
-    QHash<const Track *,
-          QPair<std::shared_ptr<talcs::SmoothedFloat>, std::shared_ptr<talcs::SmoothedFloat>>>
-        m_trackLevelMeterValue;
-    Track *masterChannel;
+    QList<TrackLevelMeter> m_trackLevelMeters; // In the order of the tracks
+    TrackLevelMeter m_masterLevelMeter;
+    AppModel::LevelMetersUpdatedArgs m_levelMetersArgs;
 
-    int m_levelMeterRampLength = 128;
+    int m_levelMeterFallTime = 1024; // ms
 
     bool m_transportPositionFlag = true;
 
@@ -97,7 +106,11 @@ private:
     bool willStartCallback(AudioExporter *exporter) override;
     void willFinishCallback(AudioExporter *exporter) override;
 
-    void updateTrackLevelMeterValue(const Track *track, QList<float> values);
+    TrackLevelMeter createLevelMeter(talcs::PositionableMixerAudioSource *mixer);
+    void startLevelMeters();
+    void updateLevelMeters();
+    void updateLevelMeter(TrackLevelMeter &meter, AppModel::LevelMetersUpdatedArgs::State &state,
+                          bool playing);
 };
 
 #endif // AUDIOCONTEXT_H
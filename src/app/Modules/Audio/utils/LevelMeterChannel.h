@@ -0,0 +1,42 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef AUDIO_LEVELMETERCHANNEL_H
+#define AUDIO_LEVELMETERCHANNEL_H
+
+#include <atomic>
+#include <utility>
+
+// Peak gains of a stereo mixer channel, handed from the audio thread to the UI thread without
+// locks. The audio thread raises the stored gains to the highest values seen since the last read,
+// the UI thread takes and resets them, so that peaks between two meter updates are not lost
+// whatever the meter refresh rate is.
+class LevelMeterChannel {
+public:
+    // Audio thread
+    void publish(const float gainL, const float gainR) {
+        raise(m_gainL, gainL);
+        raise(m_gainR, gainR);
+    }
+
+    // UI thread
+    std::pair<float, float> take() {
+        return {m_gainL.exchange(0, std::memory_order_acquire),
+                m_gainR.exchange(0, std::memory_order_acquire)};
+    }
+
+private:
+    static void raise(std::atomic<float> &peak, const float gain) {
+        auto current = peak.load(std::memory_order_relaxed);
+        while (gain > current &&
+               !peak.compare_exchange_weak(current, gain, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    std::atomic<float> m_gainL = 0.f;
+    std::atomic<float> m_gainR = 0.f;
+};
+
+#endif // AUDIO_LEVELMETERCHANNEL_H
@@ -0,0 +1,112 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "PeakFile.h"
+
+#include "Model/AppModel/AudioInfoModel.h"
+
+#include <algorithm>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+static constexpr quint32 peakFileMagic = 0x4453504B; // "DSPK"
+static constexpr qint64 hashedBlockSize = 1024 * 1024;
+
+// Level 0 holds one peak per framesPerPeak frames, the last one covering the remainder
+static bool isPeakCountValid(const long long frames, const int framesPerPeak,
+                             const qsizetype peakCount) {
+    if (frames < 0 || framesPerPeak <= 0)
+        return false;
+    return peakCount == (frames + framesPerPeak - 1) / framesPerPeak;
+}
+
+QByteArray PeakFile::audioFileKey(const QString &audioPath) {
+    QFile file(audioPath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const auto size = file.size();
+    const auto lastModified = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(&size), sizeof(size)));
+    hash.addData(
+        QByteArrayView(reinterpret_cast<const char *>(&lastModified), sizeof(lastModified)));
+    hash.addData(file.read(hashedBlockSize));
+    if (size > hashedBlockSize && file.seek(std::max(hashedBlockSize, size - hashedBlockSize)))
+        hash.addData(file.read(hashedBlockSize));
+    return hash.result();
+}
+
+bool PeakFile::load(const QString &audioPath, const QByteArray &key, AudioInfoModel &info) {
+    if (key.isEmpty())
+        return false;
+    for (const auto &path : {peakFilePath(audioPath), cachedPeakFilePath(key)}) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        QDataStream in(&file);
+        quint32 magic = 0;
+        quint32 fileVersion = 0;
+        QByteArray fileKey;
+        in >> magic >> fileVersion;
+        if (magic != peakFileMagic || fileVersion != version)
+            continue;
+        in >> fileKey;
+        if (fileKey != key)
+            continue;
+
+        AudioInfoModel result;
+        qint32 framesPerPeak = 0;
+        QList<qint16> mins;
+        QList<qint16> maxs;
+        in >> result.sampleRate >> result.channels >> result.frames >> framesPerPeak >> mins >>
+            maxs;
+        if (in.status() != QDataStream::Ok || mins.count() != maxs.count() ||
+            !isPeakCountValid(result.frames, framesPerPeak, mins.count()))
+            continue;
+        result.peaks = PeakPyramid(mins, maxs, framesPerPeak);
+        info = result;
+        return true;
+    }
+    return false;
+}
+
+bool PeakFile::save(const QString &audioPath, const QByteArray &key, const AudioInfoModel &info) {
+    if (key.isEmpty() || info.peaks.isEmpty())
+        return false;
+    // The coarser levels are cheap to build again, only level 0 is stored
+    const auto &level = info.peaks.level(0);
+    // A file load() would reject is not worth writing
+    if (!isPeakCountValid(info.frames, level.valuesPerEntry, level.mins.count()))
+        return false;
+    const auto write = [&](const QString &path) {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        QDataStream out(&file);
+        out << peakFileMagic << version << key;
+        out << info.sampleRate << info.channels << info.frames
+            << static_cast<qint32>(level.valuesPerEntry) << level.mins << level.maxs;
+        return out.status() == QDataStream::Ok && file.commit();
+    };
+    if (write(peakFilePath(audioPath)))
+        return true;
+    const auto cachedPath = cachedPeakFilePath(key);
+    return QDir().mkpath(QFileInfo(cachedPath).path()) && write(cachedPath);
+}
+
+QString PeakFile::peakFilePath(const QString &audioPath) {
+    return audioPath + ".peaks";
+}
+
+QString PeakFile::cachedPeakFilePath(const QByteArray &key) {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/Peaks/" +
+           QString::fromLatin1(key.toHex()) + ".peaks";
+}
@@ -0,0 +1,33 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef AUDIO_PEAKFILE_H
+#define AUDIO_PEAKFILE_H
+
+#include <QByteArray>
+#include <QString>
+
+class AudioInfoModel;
+
+// Caches the decoded waveform peaks of an audio file, so that reopening a project does not decode
+// its audio again. The peak file lives next to the audio file, or in the app cache folder if that
+// one is not writable. It is keyed by a hash of the audio file and carries a format version;
+// a peak file that does not match both is ignored.
+class PeakFile {
+public:
+    static constexpr quint32 version = 1;
+
+    // Hash of the size, modification time and the first and last megabyte of the audio file.
+    // Empty if the file can not be read.
+    static QByteArray audioFileKey(const QString &audioPath);
+
+    static bool load(const QString &audioPath, const QByteArray &key, AudioInfoModel &info);
+    static bool save(const QString &audioPath, const QByteArray &key, const AudioInfoModel &info);
+
+private:
+    static QString peakFilePath(const QString &audioPath);
+    static QString cachedPeakFilePath(const QByteArray &key);
+};
+
+#endif // AUDIO_PEAKFILE_H
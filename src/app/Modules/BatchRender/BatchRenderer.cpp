@@ -0,0 +1,279 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "BatchRenderer.h"
+
+#include "Controller/AppController.h"
+#include "Model/AppModel/AppModel.h"
+#include "Model/AppModel/InferPiece.h"
+#include "Model/AppModel/SingingClip.h"
+#include "Model/AppModel/Track.h"
+#include "Model/AppOptions/AppOptions.h"
+#include "Model/AppStatus/AppStatus.h"
+#include "Modules/Audio/AudioExporter.h"
+#include "Modules/Inference/InferTelemetry.h"
+#include "Modules/Task/TaskManager.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFileInfo>
+#include <QThread>
+
+static constexpr auto renderOptionName = "render";
+static constexpr int pollIntervalMs = 100;
+
+static double elapsedMs(const QElapsedTimer &timer) {
+    return static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
+}
+
+BatchRenderer::BatchRenderer(const Options &options, QObject *parent)
+    : QObject(parent), m_options(options) {
+    m_pollTimer.setInterval(pollIntervalMs);
+    connect(&m_pollTimer, &QTimer::timeout, this, &BatchRenderer::onPollTimerTimeout);
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &BatchRenderer::onTimeout);
+}
+
+bool BatchRenderer::isRequested(const int argc, char *argv[]) {
+    const auto option = QByteArray("--") + renderOptionName;
+    for (int i = 1; i < argc; i++)
+        if (option == argv[i])
+            return true;
+    return false;
+}
+
+void BatchRenderer::prepareEnvironment() {
+    // Render servers usually have no display
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+}
+
+void BatchRenderer::prepareOptions() {
+    // Acoustic inference must run without waiting for playback. Not saved to the config file.
+    appOptions->inference()->autoStartInfer = true;
+}
+
+bool BatchRenderer::parseArguments(const QStringList &arguments, Options &options,
+                                   QString &errorMessage) {
+    QCommandLineParser parser;
+    const QCommandLineOption renderOption(renderOptionName, "Project file (.dspx) to render.",
+                                          "project");
+    const QCommandLineOption outputOption({"o", "output"}, "Output audio file (.wav or .flac).",
+                                          "file");
+    const QCommandLineOption sampleRateOption("sample-rate", "Output sample rate.", "rate",
+                                              QString::number(options.sampleRate));
+    const QCommandLineOption monoOption("mono", "Mix down to a single channel.");
+    const QCommandLineOption jobsOption(
+        "jobs", "Maximum number of concurrent tasks per inference stage, or \"auto\".", "count",
+        QString::number(qMax(1, QThread::idealThreadCount() / 4)));
+    const QCommandLineOption timeoutOption("timeout", "Give up after the given seconds.",
+                                           "seconds", "0");
+    const QCommandLineOption telemetryOption(
+        "telemetry", "Save inference telemetry to the given JSON file.", "file");
+    parser.addOptions({renderOption, outputOption, sampleRateOption, monoOption, jobsOption,
+                       timeoutOption, telemetryOption});
+
+    if (!parser.parse(arguments)) {
+        errorMessage = parser.errorText();
+        return false;
+    }
+
+    options.projectPath = QFileInfo(parser.value(renderOption)).absoluteFilePath();
+    const QFileInfo projectInfo(options.projectPath);
+    if (!projectInfo.exists()) {
+        errorMessage = QString("Project file does not exist: %1").arg(options.projectPath);
+        return false;
+    }
+    if (projectInfo.suffix().toLower() != "dspx") {
+        errorMessage = QString("Unsupported project format: %1").arg(projectInfo.suffix());
+        return false;
+    }
+
+    if (!parser.isSet(outputOption)) {
+        errorMessage = "Output file is not specified";
+        return false;
+    }
+    options.outputPath = QFileInfo(parser.value(outputOption)).absoluteFilePath();
+    const auto outputSuffix = QFileInfo(options.outputPath).suffix().toLower();
+    if (outputSuffix != "wav" && outputSuffix != "flac") {
+        errorMessage = QString("Unsupported output format: %1").arg(outputSuffix);
+        return false;
+    }
+
+    bool ok = false;
+    options.sampleRate = parser.value(sampleRateOption).toDouble(&ok);
+    if (!ok || options.sampleRate <= 0) {
+        errorMessage = "Invalid sample rate";
+        return false;
+    }
+    if (parser.value(jobsOption) == "auto") {
+        options.maxConcurrentTasks = 0;
+    } else if (options.maxConcurrentTasks = parser.value(jobsOption).toInt(&ok);
+               !ok || options.maxConcurrentTasks < 1) {
+        errorMessage = "Invalid job count";
+        return false;
+    }
+    options.timeoutSeconds = parser.value(timeoutOption).toInt(&ok);
+    if (!ok || options.timeoutSeconds < 0) {
+        errorMessage = "Invalid timeout";
+        return false;
+    }
+    options.mono = parser.isSet(monoOption);
+    options.telemetryPath = parser.value(telemetryOption);
+    return true;
+}
+
+void BatchRenderer::start() {
+    qInfo().noquote() << "Batch render:" << m_options.projectPath << "->" << m_options.outputPath;
+    // Not saved to the config file
+    const auto option = appOptions->inference();
+    option->autoTuneConcurrency = m_options.maxConcurrentTasks == 0;
+    if (m_options.maxConcurrentTasks > 0) {
+        option->durationConcurrency = m_options.maxConcurrentTasks;
+        option->pitchConcurrency = m_options.maxConcurrentTasks;
+        option->varianceConcurrency = m_options.maxConcurrentTasks;
+        option->acousticConcurrency = m_options.maxConcurrentTasks;
+    }
+    m_totalTimer.start();
+    m_stageTimer.start();
+    if (m_options.timeoutSeconds > 0)
+        m_timeoutTimer.start(m_options.timeoutSeconds * 1000);
+    m_pollTimer.start();
+}
+
+void BatchRenderer::onPollTimerTimeout() {
+    if (m_stage == Stage::WaitingForModules) {
+        QString errorMessage;
+        if (!modulesReady(errorMessage)) {
+            if (!errorMessage.isEmpty())
+                finish(ExitFailed, errorMessage);
+            return;
+        }
+        m_waitingForModulesMs = elapsedMs(m_stageTimer);
+        openProject();
+    } else if (m_stage == Stage::Inferring) {
+        int pieceCount = 0;
+        int failedCount = 0;
+        if (!inferenceSettled(pieceCount, failedCount))
+            return;
+        m_inferringMs = elapsedMs(m_stageTimer);
+        if (failedCount > 0) {
+            finish(ExitFailed, QString("Inference failed for %1 of %2 pieces")
+                                   .arg(failedCount)
+                                   .arg(pieceCount));
+            return;
+        }
+        qInfo() << "Inferred" << pieceCount << "pieces in" << m_inferringMs << "ms";
+        exportAudio();
+    }
+}
+
+void BatchRenderer::onTimeout() {
+    if (m_stage != Stage::Finished)
+        finish(ExitFailed, QString("Timed out after %1 s").arg(m_options.timeoutSeconds));
+}
+
+bool BatchRenderer::modulesReady(QString &errorMessage) {
+    if (appStatus->inferEngineEnvStatus == AppStatus::ModuleStatus::Error) {
+        errorMessage = "Failed to initialize the inference engine";
+        return false;
+    }
+    if (appStatus->languageModuleStatus == AppStatus::ModuleStatus::Error) {
+        errorMessage = "Failed to initialize the language module";
+        return false;
+    }
+    // Installed packages are scanned by a task started once the inference engine is initialized
+    return appStatus->inferEngineEnvStatus == AppStatus::ModuleStatus::Ready &&
+           appStatus->languageModuleStatus == AppStatus::ModuleStatus::Ready &&
+           taskManager->tasks().isEmpty();
+}
+
+bool BatchRenderer::inferenceSettled(int &pieceCount, int &failedCount) {
+    // Pieces are created by the pronunciation and phoneme tasks, so wait for them first
+    if (!taskManager->tasks().isEmpty())
+        return false;
+    for (const auto track : appModel->tracks()) {
+        for (const auto clip : track->clips()) {
+            if (clip->clipType() != Clip::Singing)
+                continue;
+            for (const auto piece : static_cast<SingingClip *>(clip)->pieces()) {
+                const auto status = piece->acousticInferStatus.get();
+                if (status == Pending || status == Running)
+                    return false;
+                pieceCount++;
+                if (status == Failed)
+                    failedCount++;
+            }
+        }
+    }
+    return true;
+}
+
+void BatchRenderer::openProject() {
+    m_stageTimer.restart();
+    QString errorMessage;
+    if (!appController->openFile(m_options.projectPath, errorMessage)) {
+        finish(ExitFailed, QString("Failed to open project: %1").arg(errorMessage));
+        return;
+    }
+    qInfo() << "Project opened in" << elapsedMs(m_stageTimer) << "ms";
+    m_stage = Stage::Inferring;
+}
+
+void BatchRenderer::exportAudio() {
+    m_stage = Stage::Exporting;
+    m_pollTimer.stop();
+    m_stageTimer.restart();
+
+    const QFileInfo outputInfo(m_options.outputPath);
+    const auto fileType = outputInfo.suffix().toLower() == "flac" ? AudioExporterConfig::FT_Flac
+                                                                  : AudioExporterConfig::FT_Wav;
+    const auto config = AudioExporterConfig::fromVariantMap({
+        {"fileName",          outputInfo.fileName()        },
+        {"fileDirectory",     outputInfo.absolutePath()    },
+        {"fileType",          fileType                     },
+        {"formatMono",        m_options.mono               },
+        {"formatOption",      0                            },
+        {"formatQuality",     100                          },
+        {"formatSampleRate",  m_options.sampleRate         },
+        {"mixingOption",      AudioExporterConfig::MO_Mixed},
+        {"isMuteSoloEnabled", true                         },
+        {"sourceOption",      AudioExporterConfig::SO_All  },
+        {"source",            {}                           },
+        {"timeRange",         AudioExporterConfig::TR_All  },
+    });
+
+    AudioExporter exporter(nullptr);
+    exporter.setConfig(config);
+    if (exporter.warning() & AudioExporter::W_UnrecognizedTemplate) {
+        finish(ExitFailed, "Output file name contains an unrecognized template");
+        return;
+    }
+    const auto result = exporter.exec();
+    if (result != AudioExporter::R_Ok) {
+        finish(ExitFailed, QString("Export failed: %1").arg(exporter.errorString()));
+        return;
+    }
+    qInfo() << "Exported in" << elapsedMs(m_stageTimer) << "ms";
+    finish(ExitSucceeded);
+}
+
+void BatchRenderer::finish(const ExitCode code, const QString &message) {
+    m_stage = Stage::Finished;
+    m_pollTimer.stop();
+    m_timeoutTimer.stop();
+    if (!message.isEmpty())
+        qCritical().noquote() << "Batch render:" << message;
+
+    if (!m_options.telemetryPath.isEmpty() && !inferTelemetry->dumpToFile(m_options.telemetryPath))
+        qWarning() << "Failed to save inference telemetry to" << m_options.telemetryPath;
+
+    qInfo().noquote() << QString("Batch render %1. Modules: %2 ms, inference: %3 ms, total: %4 ms")
+                             .arg(code == ExitSucceeded ? "succeeded" : "failed")
+                             .arg(m_waitingForModulesMs)
+                             .arg(m_inferringMs)
+                             .arg(elapsedMs(m_totalTimer));
+    QCoreApplication::exit(code);
+}
@@ -0,0 +1,67 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+// Renders a .dspx project to an audio file without creating any widget. The project is loaded
+// once the inference engine, the language module and the installed packages are ready, every
+// piece is inferred with the acoustic stage forced on, and the mix is exported with AudioExporter.
+class BatchRenderer final : public QObject {
+    Q_OBJECT
+
+public:
+    enum ExitCode { ExitSucceeded = 0, ExitFailed = 1, ExitInvalidArguments = 2 };
+
+    class Options {
+    public:
+        QString projectPath;
+        QString outputPath;
+        double sampleRate = 44100;
+        bool mono = false;
+        int maxConcurrentTasks = 1; // 0 to auto-tune
+        int timeoutSeconds = 0;
+        QString telemetryPath;
+    };
+
+    explicit BatchRenderer(const Options &options, QObject *parent = nullptr);
+
+    // Checks argv before QApplication is created, so that the platform plugin can still be chosen
+    static bool isRequested(int argc, char *argv[]);
+    // Must be called before the application object is created
+    static void prepareEnvironment();
+    // Must be called before the controllers are created
+    static void prepareOptions();
+    static bool parseArguments(const QStringList &arguments, Options &options,
+                               QString &errorMessage);
+
+    // Starts rendering. The application quits with one of ExitCode when done.
+    void start();
+
+private:
+    enum class Stage { WaitingForModules, Inferring, Exporting, Finished };
+
+    void onPollTimerTimeout();
+    void onTimeout();
+    [[nodiscard]] static bool modulesReady(QString &errorMessage);
+    [[nodiscard]] static bool inferenceSettled(int &pieceCount, int &failedCount);
+    void openProject();
+    void exportAudio();
+    void finish(ExitCode code, const QString &message = {});
+
+    Options m_options;
+    Stage m_stage = Stage::WaitingForModules;
+    QTimer m_pollTimer;
+    QTimer m_timeoutTimer;
+    QElapsedTimer m_totalTimer;
+    QElapsedTimer m_stageTimer;
+    double m_waitingForModulesMs = 0;
+    double m_inferringMs = 0;
+};
+
+#endif // BATCHRENDERER_H
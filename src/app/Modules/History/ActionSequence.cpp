@@ -27,6 +27,19 @@ QString ActionSequence::name() {
     return m_name;
 }
 
+qsizetype ActionSequence::memoryUsage(QHash<const void *, qsizetype> &sharedData) const {
+    // Rough size of an action object and its fields
+    constexpr qsizetype actionSize = 64;
+    qsizetype size = sizeof(ActionSequence) + m_name.capacity() * sizeof(QChar);
+    for (const auto action : m_actions)
+        size += actionSize + action->memoryUsage(sharedData);
+    return size;
+}
+
+quint64 ActionSequence::stepId() const {
+    return m_stepId;
+}
+
 void ActionSequence::addAction(IAction *action) {
     m_actions.append(action);
 }
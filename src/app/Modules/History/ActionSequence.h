@@ -6,6 +6,7 @@
 #define ACTIONSEQUENCE_H
 
 #include <QObject>
+#include <QHash>
 #include <QList>
 
 #include "IAction.h"
@@ -19,14 +20,21 @@ public:
     void undo();
     qsizetype count() const;
     QString name();
+    // Approximate heap size of the actions, see IAction::memoryUsage
+    qsizetype memoryUsage(QHash<const void *, qsizetype> &sharedData) const;
+    // Assigned by HistoryManager when the sequence is recorded, unique within the session
+    [[nodiscard]] quint64 stepId() const;
 
 protected:
     void addAction(IAction *action);
     void setName(const QString &name);
 
 private:
+    friend class HistoryManager;
+
     QList<IAction *> m_actions;
     QString m_name;
+    quint64 m_stepId = 0;
 };
 
 
@@ -7,13 +7,25 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 #include "ActionSequence.h"
+#include "Model/AppOptions/AppOptions.h"
 #include "Model/AppStatus/AppStatus.h"
 
 HistoryManager::HistoryManager(QObject *parent)
     : QObject(parent), d_ptr(new HistoryManagerPrivate) {
     Q_D(HistoryManager);
     d->q_ptr = this;
+    d->applyOptions();
+    connect(appOptions, &AppOptions::optionsChanged, this, [this](const auto option) {
+        if (option != AppOptionsGlobal::All && option != AppOptionsGlobal::General)
+            return;
+        Q_D(HistoryManager);
+        d->applyOptions();
+        d->trim();
+        emit memoryUsageChanged(d->m_memoryUsage, stepCount());
+    });
 }
 
 HistoryManager::~HistoryManager() {
@@ -59,9 +71,13 @@ void HistoryManager::record(ActionSequence *actions) {
     if (actions->count() <= 0)
         return;
 
+    actions->m_stepId = d->m_nextStepId++;
     d->m_undoStack.push(actions);
-    d->m_redoStack.clear();
+    d->clearRedo();
+    d->addMemoryUsage(actions);
+    d->trim();
     emit undoRedoChanged(canUndo(), undoActionName(), canRedo(), redoActionName());
+    emit memoryUsageChanged(d->m_memoryUsage, stepCount());
 }
 
 void HistoryManager::reset() {
@@ -73,9 +89,14 @@ void HistoryManager::reset() {
         delete seq;
     d->m_undoStack.clear();
     d->m_redoStack.clear();
-    d->m_savePoint = nullptr;
+    d->m_savePoint = noStep;
     d->m_isSavePointSet = false;
+    d->m_isSavePointLost = false;
+    d->m_memoryUsage = 0;
+    d->m_stepMemoryUsages.clear();
+    d->m_sharedDataRefCounts.clear();
     emit undoRedoChanged(canUndo(), "", canRedo(), "");
+    emit memoryUsageChanged(0, 0);
 }
 
 bool HistoryManager::isOnSavePoint() const {
@@ -84,12 +105,12 @@ bool HistoryManager::isOnSavePoint() const {
     if (d->m_undoStack.isEmpty() && d->m_redoStack.isEmpty())
         return true;
 
-    if (!d->m_isSavePointSet)
+    if (!d->m_isSavePointSet || d->m_isSavePointLost)
         return flag;
 
-    if (d->m_savePoint != nullptr) {
+    if (d->m_savePoint != noStep) {
         if (!d->m_undoStack.isEmpty())
-            if (d->m_undoStack.top() == d->m_savePoint)
+            if (d->m_undoStack.top()->stepId() == d->m_savePoint)
                 flag = true;
     } else if (d->m_undoStack.isEmpty())
         flag = true;
@@ -97,13 +118,22 @@ bool HistoryManager::isOnSavePoint() const {
 }
 
 void HistoryManager::setSavePoint() {
+    setSavePoint(currentState());
+}
+
+auto HistoryManager::currentState() const -> StateId {
+    Q_D(const HistoryManager);
+    return d->m_undoStack.isEmpty() ? noStep : d->m_undoStack.top()->stepId();
+}
+
+void HistoryManager::setSavePoint(const StateId state) {
     Q_D(HistoryManager);
     d->m_isSavePointSet = true;
-    if (d->m_undoStack.isEmpty()) {
-        d->m_savePoint = nullptr;
-        return;
-    }
-    d->m_savePoint = d->m_undoStack.top();
+    d->m_savePoint = state;
+    // The state is gone if its step was trimmed or discarded with the redo steps in the meantime
+    d->m_isSavePointLost = state != noStep && !d->containsStep(d->m_undoStack, state) &&
+                           !d->containsStep(d->m_redoStack, state);
+    emit undoRedoChanged(canUndo(), undoActionName(), canRedo(), redoActionName());
 }
 
 bool HistoryManager::canUndo() const {
@@ -124,4 +154,87 @@ QString HistoryManager::undoActionName() const {
 QString HistoryManager::redoActionName() const {
     Q_D(const HistoryManager);
     return d->m_redoStack.isEmpty() ? "" : d->m_redoStack.top()->name();
-}
\ No newline at end of file
+}
+
+qsizetype HistoryManager::memoryUsage() const {
+    Q_D(const HistoryManager);
+    return d->m_memoryUsage;
+}
+
+int HistoryManager::stepCount() const {
+    Q_D(const HistoryManager);
+    return static_cast<int>(d->m_undoStack.count() + d->m_redoStack.count());
+}
+
+void HistoryManagerPrivate::applyOptions() {
+    const auto option = appOptions->general();
+    m_maxSteps = qMax(0, option->historyMaxSteps);
+    m_maxMemoryUsage = qMax(0, option->historyMemoryLimitMb) * qsizetype(1024 * 1024);
+}
+
+void HistoryManagerPrivate::trim() {
+    const auto isOverLimit = [&] {
+        return (m_maxSteps > 0 && m_undoStack.count() > m_maxSteps) ||
+               (m_maxMemoryUsage > 0 && m_memoryUsage > m_maxMemoryUsage);
+    };
+    qsizetype trimCount = 0;
+    while (m_undoStack.count() > 1 && isOverLimit()) {
+        removeOldestUndo();
+        trimCount++;
+    }
+    if (trimCount > 0)
+        qDebug() << "HistoryManager: trimmed" << trimCount << "oldest steps";
+}
+
+void HistoryManagerPrivate::addMemoryUsage(const ActionSequence *seq) {
+    StepMemoryUsage usage;
+    usage.ownSize = seq->memoryUsage(usage.sharedData);
+    m_memoryUsage += usage.ownSize;
+    for (auto it = usage.sharedData.cbegin(); it != usage.sharedData.cend(); ++it)
+        if (m_sharedDataRefCounts[it.key()]++ == 0)
+            m_memoryUsage += it.value();
+    m_stepMemoryUsages.insert(seq->stepId(), usage);
+}
+
+void HistoryManagerPrivate::removeMemoryUsage(const ActionSequence *seq) {
+    const auto usage = m_stepMemoryUsages.take(seq->stepId());
+    m_memoryUsage -= usage.ownSize;
+    for (auto it = usage.sharedData.cbegin(); it != usage.sharedData.cend(); ++it) {
+        const auto refCount = m_sharedDataRefCounts.find(it.key());
+        if (refCount == m_sharedDataRefCounts.end())
+            continue;
+        if (--refCount.value() == 0) {
+            m_sharedDataRefCounts.erase(refCount);
+            m_memoryUsage -= it.value();
+        }
+    }
+}
+
+void HistoryManagerPrivate::removeOldestUndo() {
+    const auto seq = m_undoStack.takeFirst();
+    removeMemoryUsage(seq);
+    if (m_isSavePointSet && !m_isSavePointLost) {
+        if (m_savePoint == seq->stepId())
+            // The saved state is now the one with every remaining step undone
+            m_savePoint = HistoryManager::noStep;
+        else if (m_savePoint == HistoryManager::noStep)
+            m_isSavePointLost = true;
+    }
+    delete seq;
+}
+
+void HistoryManagerPrivate::clearRedo() {
+    // Undone steps are not deleted: they may own objects that are back in the model (e.g. the
+    // track of an undone RemoveTrackAction)
+    if (m_isSavePointSet && m_savePoint != HistoryManager::noStep &&
+        containsStep(m_redoStack, m_savePoint))
+        m_isSavePointLost = true;
+    for (const auto seq : std::as_const(m_redoStack))
+        removeMemoryUsage(seq);
+    m_redoStack.clear();
+}
+
+bool HistoryManagerPrivate::containsStep(const QStack<ActionSequence *> &stack, const quint64 id) {
+    return std::any_of(stack.cbegin(), stack.cend(),
+                       [id](const ActionSequence *seq) { return seq->stepId() == id; });
+}
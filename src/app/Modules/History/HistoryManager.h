@@ -31,16 +31,30 @@ public:
     void record(ActionSequence *actions);
     void reset();
 
+    // Id of the latest step applied, noStep before the first one. Ids are never reused, so a
+    // state stays identifiable after its step is deleted.
+    using StateId = quint64;
+    static constexpr StateId noStep = 0;
+
     [[nodiscard]] bool isOnSavePoint() const;
     void setSavePoint();
+    // Identifies the current state of the project, e.g. when a snapshot is taken for saving
+    [[nodiscard]] StateId currentState() const;
+    // Marks a state returned by currentState() as saved, even if steps were recorded since
+    void setSavePoint(StateId state);
     [[nodiscard]] bool canUndo() const;
     [[nodiscard]] bool canRedo() const;
     [[nodiscard]] QString undoActionName() const;
     [[nodiscard]] QString redoActionName() const;
+    // Approximate memory held by the undo and redo steps. Data shared between steps, such as
+    // unchanged curve chunks, is counted once.
+    [[nodiscard]] qsizetype memoryUsage() const;
+    [[nodiscard]] int stepCount() const;
 
 signals:
     void undoRedoChanged(bool canUndo, const QString &undoName, bool canRedo,
                          const QString &redoName);
+    void memoryUsageChanged(qsizetype bytes, int stepCount);
 
 private:
     Q_DECLARE_PRIVATE(HistoryManager)
@@ -5,6 +5,7 @@
 #ifndef HISTORYMANAGERPRIVATE_H
 #define HISTORYMANAGERPRIVATE_H
 
+#include <QHash>
 #include <QStack>
 
 class ActionSequence;
@@ -14,10 +15,39 @@ class HistoryManagerPrivate {
     Q_DECLARE_PUBLIC(HistoryManager);
 
 public:
+    void applyOptions();
+    // Drops the oldest undo steps until both the step limit and the memory limit are met. The
+    // latest step is always kept.
+    void trim();
+    // Steps are measured once when recorded. Implicitly shared data is counted while at least
+    // one step references it, so dropping a step only frees what no other step shares.
+    void addMemoryUsage(const ActionSequence *seq);
+    void removeMemoryUsage(const ActionSequence *seq);
+    void removeOldestUndo();
+    void clearRedo();
+    [[nodiscard]] static bool containsStep(const QStack<ActionSequence *> &stack, quint64 id);
+
     QStack<ActionSequence *> m_undoStack;
     QStack<ActionSequence *> m_redoStack;
-    ActionSequence *m_savePoint = nullptr;
+    quint64 m_nextStepId = 1;
+    // Step id of the saved state, 0 for the state with every remaining step undone
+    quint64 m_savePoint = 0;
     bool m_isSavePointSet = false;
+    // The saved state was trimmed or discarded and can no longer be reached by undo/redo
+    bool m_isSavePointLost = false;
+
+    int m_maxSteps = 0;            // 0 for unlimited
+    qsizetype m_maxMemoryUsage = 0; // Bytes, 0 for unlimited
+    qsizetype m_memoryUsage = 0;
+
+    class StepMemoryUsage {
+    public:
+        qsizetype ownSize = 0;
+        QHash<const void *, qsizetype> sharedData;
+    };
+
+    QHash<quint64, StepMemoryUsage> m_stepMemoryUsages; // By step id
+    QHash<const void *, int> m_sharedDataRefCounts;
 
 private:
     HistoryManager *q_ptr = nullptr;
@@ -5,12 +5,22 @@
 #ifndef IACTION_H
 #define IACTION_H
 
+#include <QHash>
+
 #include "Utils/Macros.h"
 
 LITE_INTERFACE IAction {
     I_DECL(IAction)
     I_METHOD(void execute());
     I_METHOD(void undo());
+
+    // Approximate heap size of the data kept for undo and redo, excluding the action object
+    // itself. Implicitly shared data is not included but added to sharedData with its size, so
+    // that data shared between steps is counted once.
+    [[nodiscard]] virtual qsizetype memoryUsage(QHash<const void *, qsizetype> &sharedData) const {
+        Q_UNUSED(sharedData)
+        return 0;
+    }
 };
 
 #endif // IACTION_H
@@ -16,6 +16,7 @@
 #include "Utils/ValidationUtils.h"
 #include "Controller/PlaybackController.h"
 #include "InferPipeline.h"
+#include "InferStageTuner.h"
 
 namespace Helper = InferControllerHelper;
 
@@ -30,6 +31,8 @@ InferController::InferController(QObject *parent)
             &InferControllerPrivate::onInferOptionChanged);
     connect(playbackController, &PlaybackController::playbackStatusChanged, d,
             &InferControllerPrivate::onPlaybackStatusChanged);
+    connect(inferStageTuner, &InferStageTuner::maxConcurrentTasksChanged, d,
+            &InferControllerPrivate::onMaxConcurrentTasksChanged);
 }
 
 InferController::~InferController() = default;
@@ -38,6 +41,8 @@ LITE_SINGLETON_IMPLEMENT_INSTANCE(InferController)
 
 void InferController::addInferDurationTask(InferDurationTask &task) {
     Q_D(InferController);
+    d->m_inferDurTasks.setMaxConcurrentTasks(
+        inferStageTuner->maxConcurrentTasks(InferTelemetry::Duration, task.input().identifier));
     d->m_inferDurTasks.add(&task);
 }
 
@@ -46,13 +51,15 @@ void InferController::cancelInferDurationTask(int taskId) {
     d->m_inferDurTasks.cancelIf(L_PRED(t, t->id() == taskId));
 }
 
-void InferController::finishCurrentInferDurationTask() {
+void InferController::finishInferDurationTask(InferDurationTask &task) {
     Q_D(InferController);
-    d->m_inferDurTasks.onCurrentFinished();
+    d->m_inferDurTasks.onTaskFinished(&task);
 }
 
 void InferController::addInferPitchTask(InferPitchTask &task) {
     Q_D(InferController);
+    d->m_inferPitchTasks.setMaxConcurrentTasks(
+        inferStageTuner->maxConcurrentTasks(InferTelemetry::Pitch, task.input().identifier));
     d->m_inferPitchTasks.add(&task);
 }
 
@@ -61,13 +68,15 @@ void InferController::cancelInferPitchTask(int taskId) {
     d->m_inferPitchTasks.cancelIf(L_PRED(t, t->id() == taskId));
 }
 
-void InferController::finishCurrentInferPitchTask() {
+void InferController::finishInferPitchTask(InferPitchTask &task) {
     Q_D(InferController);
-    d->m_inferPitchTasks.onCurrentFinished();
+    d->m_inferPitchTasks.onTaskFinished(&task);
 }
 
 void InferController::addInferVarianceTask(InferVarianceTask &task) {
     Q_D(InferController);
+    d->m_inferVarianceTasks.setMaxConcurrentTasks(
+        inferStageTuner->maxConcurrentTasks(InferTelemetry::Variance, task.input().identifier));
     d->m_inferVarianceTasks.add(&task);
 }
 
@@ -76,13 +85,15 @@ void InferController::cancelInferVarianceTask(int taskId) {
     d->m_inferVarianceTasks.cancelIf(L_PRED(t, t->id() == taskId));
 }
 
-void InferController::finishCurrentInferVarianceTask() {
+void InferController::finishInferVarianceTask(InferVarianceTask &task) {
     Q_D(InferController);
-    d->m_inferVarianceTasks.onCurrentFinished();
+    d->m_inferVarianceTasks.onTaskFinished(&task);
 }
 
 void InferController::addInferAcousticTask(InferAcousticTask &task) {
     Q_D(InferController);
+    d->m_inferAcousticTasks.setMaxConcurrentTasks(
+        inferStageTuner->maxConcurrentTasks(InferTelemetry::Acoustic, task.input().identifier));
     d->m_inferAcousticTasks.add(&task);
 }
 
@@ -91,9 +102,29 @@ void InferController::cancelInferAcousticTask(int taskId) {
     d->m_inferAcousticTasks.cancelIf(L_PRED(t, t->id() == taskId));
 }
 
-void InferController::finishCurrentInferAcousticTask() {
+void InferController::finishInferAcousticTask(InferAcousticTask &task) {
     Q_D(InferController);
-    d->m_inferAcousticTasks.onCurrentFinished();
+    d->m_inferAcousticTasks.onTaskFinished(&task);
+}
+
+void InferControllerPrivate::onMaxConcurrentTasksChanged(const InferTelemetry::Stage stage,
+                                                         const int count) {
+    switch (stage) {
+        case InferTelemetry::Duration:
+            m_inferDurTasks.setMaxConcurrentTasks(count);
+            break;
+        case InferTelemetry::Pitch:
+            m_inferPitchTasks.setMaxConcurrentTasks(count);
+            break;
+        case InferTelemetry::Variance:
+            m_inferVarianceTasks.setMaxConcurrentTasks(count);
+            break;
+        case InferTelemetry::Acoustic:
+            m_inferAcousticTasks.setMaxConcurrentTasks(count);
+            break;
+        default:
+            break;
+    }
 }
 
 void InferControllerPrivate::onModuleStatusChanged(const AppStatus::ModuleType module,
@@ -126,11 +157,18 @@ void InferControllerPrivate::onInferOptionChanged(const AppOptionsGlobal::Option
 
     m_autoStartAcousticInfer = appOptions->inference()->autoStartInfer;
     // runInferAcousticIfNeeded();
+
+    // Tuned counts are applied when the next task of the model is added
+    if (!appOptions->inference()->autoTuneConcurrency) {
+        for (const auto stage : {InferTelemetry::Duration, InferTelemetry::Pitch,
+                                 InferTelemetry::Variance, InferTelemetry::Acoustic})
+            onMaxConcurrentTasksChanged(stage, inferStageTuner->maxConcurrentTasks(stage, {}));
+    }
 }
 
 void InferControllerPrivate::onPlaybackStatusChanged(const PlaybackGlobal::PlaybackStatus status) {
     if (status == PlaybackGlobal::Playing) {
-        // if (!m_inferAcousticTasks.current)
+        // if (m_inferAcousticTasks.running.isEmpty())
         // runNextInferAcousticTask();
     }
 }
@@ -189,14 +227,21 @@ void InferControllerPrivate::handleNoteChanged(const SingingClip::NoteChangeType
             for (const auto &piece : clip->findPiecesByNotes(notes)) {
                 piece->dirty = true;
             }
-            if (!clip->singerInfo().isEmpty())
-                clip->reSegment();
+            // A batch is re-segmented once, in handleNoteBatchApplied()
+            if (!clip->singerInfo().isEmpty() && !clip->isApplyingNoteBatch())
+                clip->reSegment(notes);
             break;
         default:
             break;
     } // Ignore original word property change
 }
 
+void InferControllerPrivate::handleNoteBatchApplied(const QList<Note *> &notes,
+                                                    SingingClip *clip) {
+    if (!clip->singerInfo().isEmpty())
+        clip->reSegment(notes);
+}
+
 void InferControllerPrivate::handleParamChanged(const ParamInfo::Name name, const Param::Type type,
                                                 SingingClip *clip) {
     if (type != Param::Edited)
@@ -277,7 +322,7 @@ void InferControllerPrivate::handleLanguageModuleStatusChanged(
 }
 
 void InferControllerPrivate::handleGetPronTaskFinished(GetPronunciationTask &task) {
-    m_getPronTasks.onCurrentFinished();
+    m_getPronTasks.onTaskFinished(&task);
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
         delete &task;
@@ -292,7 +337,7 @@ void InferControllerPrivate::handleGetPronTaskFinished(GetPronunciationTask &tas
 }
 
 void InferControllerPrivate::handleGetPhoneTaskFinished(GetPhonemeNameTask &task) {
-    m_getPhoneTasks.onCurrentFinished();
+    m_getPhoneTasks.onTaskFinished(&task);
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
         delete &task;
@@ -27,19 +27,19 @@ public:
 
     void addInferDurationTask(InferDurationTask &task);
     void cancelInferDurationTask(int taskId);
-    void finishCurrentInferDurationTask();
+    void finishInferDurationTask(InferDurationTask &task);
 
     void addInferPitchTask(InferPitchTask &task);
     void cancelInferPitchTask(int taskId);
-    void finishCurrentInferPitchTask();
+    void finishInferPitchTask(InferPitchTask &task);
 
     void addInferVarianceTask(InferVarianceTask &task);
     void cancelInferVarianceTask(int taskId);
-    void finishCurrentInferVarianceTask();
+    void finishInferVarianceTask(InferVarianceTask &task);
 
     void addInferAcousticTask(InferAcousticTask &task);
     void cancelInferAcousticTask(int taskId);
-    void finishCurrentInferAcousticTask();
+    void finishInferAcousticTask(InferAcousticTask &task);
 
 private:
     explicit InferController(QObject *parent = nullptr);
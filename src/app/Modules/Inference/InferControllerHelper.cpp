@@ -37,7 +37,7 @@ namespace InferControllerHelper {
         input.paddingStartMs = piece.paddingStartMs;
         input.paddingEndMs = piece.paddingEndMs;
 
-        input.timeline = {{{0, appModel->tempo()}}};
+        input.timeline = appModel->timeline();
         input.notes = buildInferInputNotes(piece.notes);
 
         input.speaker = piece.speaker;
@@ -59,7 +59,7 @@ namespace InferControllerHelper {
         input.paddingStartMs = piece.paddingStartMs;
         input.paddingEndMs = piece.paddingEndMs;
 
-        input.timeline = {{{0, appModel->tempo()}}};
+        input.timeline = appModel->timeline();
         input.notes = buildInferInputNotes(piece.notes);
         input.expressiveness = expr;
 
@@ -83,7 +83,7 @@ namespace InferControllerHelper {
         input.paddingStartMs = piece.paddingStartMs;
         input.paddingEndMs = piece.paddingEndMs;
 
-        input.timeline = {{{0, appModel->tempo()}}};
+        input.timeline = appModel->timeline();
         input.notes = buildInferInputNotes(piece.notes);
         input.pitch = pitch;
 
@@ -137,7 +137,7 @@ namespace InferControllerHelper {
         input.paddingStartMs = piece.paddingStartMs;
         input.paddingEndMs = piece.paddingEndMs;
 
-        input.timeline = {{{0, appModel->tempo()}}};
+        input.timeline = appModel->timeline();
         input.notes = buildInferInputNotes(piece.notes);
         input.pitch = pitch;
         input.breathiness = breathiness;
@@ -8,6 +8,7 @@
 #include "Controller/ModelChangeHandler.h"
 #include "Model/AppModel/SingingClip.h"
 #include "Model/AppStatus/AppStatus.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Task/TaskQueue.h"
 #include "Tasks/InferAcousticTask.h"
 #include "Tasks/InferDurationTask.h"
@@ -35,6 +36,7 @@ public slots:
     void onEditingChanged(AppStatus::EditObjectType type);
     void onInferOptionChanged(AppOptionsGlobal::Option option);
     void onPlaybackStatusChanged(PlaybackGlobal::PlaybackStatus status);
+    void onMaxConcurrentTasksChanged(InferTelemetry::Stage stage, int count);
 
 public:
     void handleTempoChanged(double tempo) override;
@@ -44,6 +46,7 @@ public:
                              SingingClip *clip) override;
     void handleNoteChanged(SingingClip::NoteChangeType type, const QList<Note *> &notes,
                            SingingClip *clip) override;
+    void handleNoteBatchApplied(const QList<Note *> &notes, SingingClip *clip) override;
     void handleParamChanged(ParamInfo::Name name, Param::Type type, SingingClip *clip) override;
 
     void handleLanguageModuleStatusChanged(AppStatus::ModuleStatus status);
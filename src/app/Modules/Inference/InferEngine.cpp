@@ -8,6 +8,7 @@
 #include "Model/AppStatus/AppStatus.h"
 #include "Modules/Task/TaskManager.h"
 #include "Modules/Inference/Models/GenericInferModel.h"
+#include "Modules/Inference/VocoderSessionPool.h"
 #include "Modules/PackageManager/PackageManager.h"
 #include "Tasks/InitInferEngineTask.h"
 
@@ -572,12 +573,11 @@ bool InferEngine::loadInferencesForSinger(const SingerIdentifier &identifier) {
             if (isAboutToQuit()) {
                 return false;
             }
-            if (auto exp2 = loader->createVocoder(); !exp2) {
+            // Loads the session once per vocoder model, and keeps it idle in the pool
+            if (auto exp2 = vocoderSessionPool->acquire(*loader); !exp2) {
                 allLoaded = false;
                 qCritical().noquote().nospace()
                     << "Failed to create vocoder inference: " << exp2.getError();
-            } else {
-                inference.vocoder = std::move(exp2.get());
             }
         } else {
             allLoaded = false;
@@ -599,10 +599,14 @@ bool InferEngine::loadInferencesForSinger(const SingerIdentifier &identifier) {
     return true;
 }
 
+QList<InferEngine::InferenceSet> InferEngine::inferencesSnapshot() const {
+    QReadLocker rdLock(&m_inferenceRwLock);
+    return m_inferences.values();
+}
+
 void InferEngine::terminateInferDurationAll() const {
     qInfo() << "terminateInferDurationAsync";
-    QWriteLocker wrLock(&m_inferenceRwLock);
-    for (const auto &inference : std::as_const(m_inferences)) {
+    for (const auto &inference : inferencesSnapshot()) {
         if (inference.duration) {
             inference.duration->stop();
         }
@@ -611,8 +615,7 @@ void InferEngine::terminateInferDurationAll() const {
 
 void InferEngine::terminateInferPitchAll() const {
     qInfo() << "terminateInferPitchAsync";
-    QWriteLocker wrLock(&m_inferenceRwLock);
-    for (const auto &inference : std::as_const(m_inferences)) {
+    for (const auto &inference : inferencesSnapshot()) {
         if (inference.pitch) {
             inference.pitch->stop();
         }
@@ -621,8 +624,7 @@ void InferEngine::terminateInferPitchAll() const {
 
 void InferEngine::terminateInferVarianceAll() const {
     qInfo() << "terminateInferVarianceAsync";
-    QWriteLocker wrLock(&m_inferenceRwLock);
-    for (const auto &inference : std::as_const(m_inferences)) {
+    for (const auto &inference : inferencesSnapshot()) {
         if (inference.variance) {
             inference.variance->stop();
         }
@@ -631,14 +633,10 @@ void InferEngine::terminateInferVarianceAll() const {
 
 void InferEngine::terminateInferAcousticAll() const {
     qInfo() << "terminateInferAcousticAsync";
-    QWriteLocker wrLock(&m_inferenceRwLock);
-    for (const auto &inference : std::as_const(m_inferences)) {
+    for (const auto &inference : inferencesSnapshot()) {
         if (inference.acoustic) {
             inference.acoustic->stop();
         }
-        if (inference.vocoder) {
-            inference.vocoder->stop();
-        }
     }
 }
 
@@ -654,6 +652,7 @@ void InferEngine::dispose() {
         QWriteLocker wrLock(&m_inferenceRwLock);
         m_inferences.clear();
     }
+    vocoderSessionPool->clear();
     auto packages = m_su.packages();
     for (auto &package : packages) {
         while (package.isLoaded()) {
@@ -79,7 +79,8 @@ private:
     friend class PackageManager;
 
     struct InferenceSet {
-        srt::NO<srt::Inference> duration, pitch, variance, acoustic, vocoder;
+        // Vocoder sessions are shared between singers by VocoderSessionPool
+        srt::NO<srt::Inference> duration, pitch, variance, acoustic;
     };
 
     bool initialize(QString &error);
@@ -94,6 +95,8 @@ private:
     bool loadInferences(const QString &path);
 #endif
     bool loadInferencesForSinger(const SingerIdentifier &identifier);
+    // Copies the sessions under a read lock, so that stopping them does not block loading
+    QList<InferenceSet> inferencesSnapshot() const;
     void terminateInferDurationAll() const;
     void terminateInferPitchAll() const;
     void terminateInferVarianceAll() const;
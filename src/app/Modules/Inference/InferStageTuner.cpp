@@ -0,0 +1,225 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "InferStageTuner.h"
+
+#include "Model/AppOptions/AppOptions.h"
+#include "Utils/JsonUtils.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFileInfo>
+#include <QThread>
+
+#include <limits>
+
+static constexpr int samplesPerCandidate = 4;
+// A higher count must beat the best lower one by this ratio to be tried further
+static constexpr double minImprovement = 1.1;
+
+InferStageTuner::InferStageTuner(QObject *parent) : QObject(parent) {
+    m_clock.start();
+    load();
+}
+
+InferStageTuner::~InferStageTuner() = default;
+
+LITE_SINGLETON_IMPLEMENT_INSTANCE(InferStageTuner)
+
+int InferStageTuner::maxConcurrentTasks(const Stage stage, const SingerIdentifier &identifier) {
+    if (!appOptions->inference()->autoTuneConcurrency)
+        return manualCount(stage);
+
+    QMutexLocker locker(&m_mutex);
+    m_stageModels[stage].insert(modelHash(stage, identifier));
+    return stageCount(stage);
+}
+
+void InferStageTuner::recordRun(const Stage stage, const SingerIdentifier &identifier,
+                                const qint64 ns, const double audioMs) {
+    if (!appOptions->inference()->autoTuneConcurrency || audioMs <= 0)
+        return;
+
+    int oldCount = 0;
+    int newCount = 0;
+    int tunedCount = 0;
+    bool finished = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        const auto hash = modelHash(stage, identifier);
+        auto &entry = m_entries[hash];
+        if (entry.tunedCount > 0)
+            return;
+        const auto endNs = m_clock.nsecsElapsed();
+        // The first run of a model includes one-off allocations of the runtime
+        if (!entry.warmedUp) {
+            entry.warmedUp = true;
+            entry.lastEndNs = endNs;
+            return;
+        }
+        // Runs overlap when several are in progress, count the wall time they cover once and
+        // leave out the time the stage was idle
+        const auto startNs = qMax(endNs - ns, entry.lastEndNs);
+        if (endNs > startNs)
+            entry.busyNs += endNs - startNs;
+        entry.lastEndNs = qMax(entry.lastEndNs, endNs);
+        entry.audioMs += audioMs;
+        if (++entry.runCount < samplesPerCandidate)
+            return;
+        m_stageModels[stage].insert(hash);
+        oldCount = stageCount(stage);
+        finished = advance(entry);
+        tunedCount = currentCount(entry);
+        newCount = stageCount(stage);
+    }
+
+    if (finished) {
+        qInfo() << "Tuned" << InferTelemetry::stageName(stage) << "concurrency for" << identifier
+                << ":" << tunedCount;
+        save();
+    }
+    if (newCount != oldCount)
+        emit maxConcurrentTasksChanged(stage, newCount);
+}
+
+void InferStageTuner::reset() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_entries.clear();
+        m_stageModels.clear();
+    }
+    save();
+}
+
+QString InferStageTuner::modelHash(const Stage stage, const SingerIdentifier &identifier) {
+    // The best count depends on the device as much as on the model
+    const auto option = appOptions->inference();
+    const auto key = QStringList{InferTelemetry::stageName(stage),
+                                 identifier.packageId,
+                                 identifier.packageVersion.toString(),
+                                 identifier.singerId,
+                                 option->executionProvider,
+                                 option->selectedGpuId}
+                         .join('\n');
+    return QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+QList<int> InferStageTuner::candidates() {
+    const auto maxCount = qMax(1, QThread::idealThreadCount() / 2);
+    QList<int> result;
+    for (int count = 1; count <= maxCount; count *= 2)
+        result.append(count);
+    return result;
+}
+
+QString InferStageTuner::savePath() {
+    return appOptions->inference()->cacheDirectory + "/infer-tuning.json";
+}
+
+int InferStageTuner::manualCount(const Stage stage) {
+    const auto option = appOptions->inference();
+    switch (stage) {
+        case InferTelemetry::Duration:
+            return qMax(1, option->durationConcurrency);
+        case InferTelemetry::Pitch:
+            return qMax(1, option->pitchConcurrency);
+        case InferTelemetry::Variance:
+            return qMax(1, option->varianceConcurrency);
+        case InferTelemetry::Acoustic:
+        case InferTelemetry::Vocoder:
+            return qMax(1, option->acousticConcurrency);
+        default:
+            return 1;
+    }
+}
+
+int InferStageTuner::currentCount(const Entry &entry) {
+    if (entry.tunedCount > 0)
+        return entry.tunedCount;
+    return candidates().value(entry.candidateIndex, 1);
+}
+
+int InferStageTuner::stageCount(const Stage stage) {
+    const auto models = m_stageModels.value(stage);
+    if (models.isEmpty())
+        return manualCount(stage);
+    auto count = std::numeric_limits<int>::max();
+    for (const auto &hash : models)
+        count = qMin(count, currentCount(m_entries[hash]));
+    return count;
+}
+
+bool InferStageTuner::advance(Entry &entry) {
+    const auto count = currentCount(entry);
+    // Seconds of audio completed per second of wall time with up to `count` runs side by side
+    const auto busyMs = static_cast<double>(entry.busyNs) / 1000000.0;
+    const auto throughput = busyMs > 0 ? entry.audioMs / busyMs : 0;
+    entry.runCount = 0;
+    entry.audioMs = 0;
+    entry.busyNs = 0;
+
+    double bestThroughput = 0;
+    int bestCount = 1;
+    for (auto it = entry.throughput.cbegin(); it != entry.throughput.cend(); ++it) {
+        if (it.value() > bestThroughput) {
+            bestThroughput = it.value();
+            bestCount = it.key();
+        }
+    }
+
+    entry.throughput.insert(count, throughput);
+    const auto improved = throughput >= bestThroughput * minImprovement;
+    if (improved)
+        bestCount = count;
+
+    if (!improved || entry.candidateIndex + 1 >= candidates().count()) {
+        entry.tunedCount = bestCount;
+        return true;
+    }
+    entry.candidateIndex++;
+    return false;
+}
+
+void InferStageTuner::load() {
+    const auto path = savePath();
+    if (!QFileInfo::exists(path))
+        return;
+
+    QJsonObject object;
+    if (!JsonUtils::load(path, object))
+        return;
+
+    const auto models = object.value("models").toObject();
+    for (auto it = models.constBegin(); it != models.constEnd(); ++it) {
+        const auto modelObject = it.value().toObject();
+        Entry entry;
+        entry.tunedCount = modelObject.value("concurrency").toInt();
+        if (entry.tunedCount <= 0)
+            continue;
+        const auto throughputObject = modelObject.value("throughput").toObject();
+        for (auto t = throughputObject.constBegin(); t != throughputObject.constEnd(); ++t)
+            entry.throughput.insert(t.key().toInt(), t.value().toDouble());
+        m_entries.insert(it.key(), entry);
+    }
+}
+
+void InferStageTuner::save() const {
+    QJsonObject models;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            if (it.value().tunedCount <= 0)
+                continue;
+            QJsonObject throughputObject;
+            for (auto t = it.value().throughput.cbegin(); t != it.value().throughput.cend(); ++t)
+                throughputObject.insert(QString::number(t.key()), t.value());
+            models.insert(it.key(), QJsonObject{
+                                        {"concurrency", it.value().tunedCount},
+                                        {"throughput",  throughputObject     }
+            });
+        }
+    }
+    if (!JsonUtils::save(savePath(), QJsonObject{{"version", 1}, {"models", models}}))
+        qWarning() << "Failed to save inference tuning to" << savePath();
+}
@@ -0,0 +1,85 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef INFERSTAGETUNER_H
+#define INFERSTAGETUNER_H
+
+#define inferStageTuner InferStageTuner::instance()
+
+#include "InferTelemetry.h"
+#include "Models/SingerIdentifier.h"
+#include "Utils/Singleton.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+
+// Decides how many tasks of each infer stage may run at the same time.
+// In manual mode the counts come from the inference options. In auto-tune mode every candidate
+// count is tried on the first runs of a model, and the one with the best throughput (rendered
+// audio length per wall time) is saved per model hash, so later sessions start with it directly.
+// A stage has a single task queue shared by all singers, so its limit is the lowest count of the
+// models that ran on it in this session.
+class InferStageTuner final : public QObject {
+    Q_OBJECT
+
+private:
+    explicit InferStageTuner(QObject *parent = nullptr);
+    ~InferStageTuner() override;
+
+public:
+    LITE_SINGLETON_DECLARE_INSTANCE(InferStageTuner)
+    Q_DISABLE_COPY_MOVE(InferStageTuner)
+
+    using Stage = InferTelemetry::Stage;
+
+    // Registers the model of identifier with the stage and returns the limit of the stage
+    [[nodiscard]] int maxConcurrentTasks(Stage stage, const SingerIdentifier &identifier);
+    // Thread-safe. Call when a run completes, ns is its run time and audioMs the length of the
+    // audio it produced.
+    void recordRun(Stage stage, const SingerIdentifier &identifier, qint64 ns, double audioMs);
+    // Forgets all tuned results and starts tuning again on the next runs
+    void reset();
+
+    [[nodiscard]] static QString modelHash(Stage stage, const SingerIdentifier &identifier);
+    [[nodiscard]] static QList<int> candidates();
+    [[nodiscard]] static QString savePath();
+
+signals:
+    void maxConcurrentTasksChanged(InferTelemetry::Stage stage, int count);
+
+private:
+    class Entry {
+    public:
+        int tunedCount = 0; // 0 while tuning
+        int candidateIndex = 0;
+        bool warmedUp = false;
+        // Measure window of the current candidate: completed runs, the audio they produced and
+        // the wall time during which at least one run was in progress
+        int runCount = 0;
+        double audioMs = 0;
+        qint64 busyNs = 0;
+        qint64 lastEndNs = 0;
+        QMap<int, double> throughput;
+    };
+
+    [[nodiscard]] static int manualCount(Stage stage);
+    [[nodiscard]] static int currentCount(const Entry &entry);
+    // Returns true when the entry has finished tuning
+    static bool advance(Entry &entry);
+    // Requires m_mutex
+    [[nodiscard]] int stageCount(Stage stage);
+    void load();
+    void save() const;
+
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QHash<Stage, QSet<QString>> m_stageModels;
+    QElapsedTimer m_clock;
+};
+
+#endif // INFERSTAGETUNER_H
@@ -0,0 +1,215 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "InferTelemetry.h"
+
+#include "Utils/JsonUtils.h"
+
+#include <bit>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QStandardPaths>
+#include <QThread>
+
+static int bucketIndex(const quint64 us) {
+    const auto index = static_cast<int>(std::bit_width(us));
+    return qMin(index, InferTelemetry::BucketCount - 1);
+}
+
+static double bucketLowerUs(const int index) {
+    return index == 0 ? 0 : static_cast<double>(1ull << (index - 1));
+}
+
+static double bucketUpperUs(const int index) {
+    return static_cast<double>(1ull << index);
+}
+
+double InferTelemetry::Snapshot::meanMs() const {
+    return count == 0 ? 0 : static_cast<double>(totalUs) / static_cast<double>(count) / 1000.0;
+}
+
+double InferTelemetry::Snapshot::maxMs() const {
+    return static_cast<double>(maxUs) / 1000.0;
+}
+
+double InferTelemetry::Snapshot::percentileMs(const double p) const {
+    if (count == 0)
+        return 0;
+    const auto rank = qBound(0.0, p, 1.0) * static_cast<double>(count);
+    quint64 cumulative = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        if (buckets[i] == 0)
+            continue;
+        const auto next = cumulative + buckets[i];
+        if (static_cast<double>(next) >= rank) {
+            const auto ratio =
+                (rank - static_cast<double>(cumulative)) / static_cast<double>(buckets[i]);
+            const auto lower = bucketLowerUs(i);
+            const auto upper = qMin(bucketUpperUs(i), static_cast<double>(maxUs));
+            return (lower + (qMax(upper, lower) - lower) * ratio) / 1000.0;
+        }
+        cumulative = next;
+    }
+    return maxMs();
+}
+
+QJsonObject InferTelemetry::Snapshot::toJson() const {
+    QJsonArray bucketArray;
+    for (const auto value : buckets)
+        bucketArray.append(static_cast<qint64>(value));
+    return QJsonObject{
+        {"count",         static_cast<qint64>(count)},
+        {"meanMs",        meanMs()                  },
+        {"p50Ms",         percentileMs(0.50)        },
+        {"p95Ms",         percentileMs(0.95)        },
+        {"p99Ms",         percentileMs(0.99)        },
+        {"maxMs",         maxMs()                   },
+        {"bucketsLog2Us", bucketArray               }
+    };
+}
+
+void InferTelemetry::Histogram::record(const qint64 ns) {
+    const auto us = static_cast<quint64>(qMax<qint64>(ns, 0) / 1000);
+    m_buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+    auto currentMax = m_maxUs.load(std::memory_order_relaxed);
+    while (us > currentMax &&
+           !m_maxUs.compare_exchange_weak(currentMax, us, std::memory_order_relaxed)) {
+    }
+}
+
+void InferTelemetry::Histogram::reset() {
+    for (auto &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_totalUs.store(0, std::memory_order_relaxed);
+    m_maxUs.store(0, std::memory_order_relaxed);
+}
+
+InferTelemetry::Snapshot InferTelemetry::Histogram::snapshot() const {
+    Snapshot result;
+    // Buckets are read one by one, so the totals may be slightly off when samples are recorded
+    // concurrently
+    for (int i = 0; i < BucketCount; i++) {
+        result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        result.count += result.buckets[i];
+    }
+    result.totalUs = m_totalUs.load(std::memory_order_relaxed);
+    result.maxUs = m_maxUs.load(std::memory_order_relaxed);
+    return result;
+}
+
+InferTelemetry::ScopedTimer::ScopedTimer(const Stage stage, const Phase phase)
+    : m_stage(stage), m_phase(phase) {
+    m_timer.start();
+}
+
+InferTelemetry::ScopedTimer::~ScopedTimer() {
+    inferTelemetry->record(m_stage, m_phase, m_timer.nsecsElapsed());
+}
+
+InferTelemetry::InferTelemetry(QObject *parent) : QObject(parent) {
+    if (const auto app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &InferTelemetry::onAboutToQuit);
+}
+
+InferTelemetry::~InferTelemetry() = default;
+
+LITE_SINGLETON_IMPLEMENT_INSTANCE(InferTelemetry)
+
+void InferTelemetry::record(const Stage stage, const Phase phase, const qint64 ns) {
+    if (stage < 0 || stage >= StageCount || phase < 0 || phase >= PhaseCount)
+        return;
+    m_histograms[stage][phase].record(ns);
+}
+
+InferTelemetry::Snapshot InferTelemetry::snapshot(const Stage stage, const Phase phase) const {
+    return m_histograms[stage][phase].snapshot();
+}
+
+void InferTelemetry::reset() {
+    for (auto &stage : m_histograms)
+        for (auto &histogram : stage)
+            histogram.reset();
+}
+
+QJsonObject InferTelemetry::toJson() const {
+    QJsonObject stages;
+    for (int s = 0; s < StageCount; s++) {
+        QJsonObject phases;
+        for (int p = 0; p < PhaseCount; p++) {
+            const auto stage = static_cast<Stage>(s);
+            const auto phase = static_cast<Phase>(p);
+            phases.insert(phaseName(phase), snapshot(stage, phase).toJson());
+        }
+        stages.insert(stageName(static_cast<Stage>(s)), phases);
+    }
+    return QJsonObject{
+        {"version",     1                                                 },
+        {"time",        QDateTime::currentDateTime().toString(Qt::ISODate)},
+        {"threadCount", QThread::idealThreadCount()                       },
+        {"stages",      stages                                            }
+    };
+}
+
+bool InferTelemetry::dumpToFile(const QString &path) const {
+    const QFileInfo info(path);
+    if (!info.dir().exists() && !info.dir().mkpath("."))
+        return false;
+    return JsonUtils::save(path, toJson());
+}
+
+QString InferTelemetry::defaultDumpPath() {
+    const auto dir =
+        QStandardPaths::standardLocations(QStandardPaths::AppDataLocation).first() + "/Diagnostics";
+    return dir + "/infer-telemetry.json";
+}
+
+QString InferTelemetry::stageName(const Stage stage) {
+    switch (stage) {
+        case Duration:
+            return "duration";
+        case Pitch:
+            return "pitch";
+        case Variance:
+            return "variance";
+        case Acoustic:
+            return "acoustic";
+        case Vocoder:
+            return "vocoder";
+        default:
+            return "unknown";
+    }
+}
+
+QString InferTelemetry::phaseName(const Phase phase) {
+    switch (phase) {
+        case QueueWait:
+            return "queueWait";
+        case SessionAcquire:
+            return "sessionAcquire";
+        case ModelRun:
+            return "modelRun";
+        case CacheLookup:
+            return "cacheLookup";
+        case Io:
+            return "io";
+        case CancelLatency:
+            return "cancelLatency";
+        default:
+            return "unknown";
+    }
+}
+
+void InferTelemetry::onAboutToQuit() const {
+    const auto path = defaultDumpPath();
+    if (dumpToFile(path))
+        qInfo() << "Inference telemetry saved to" << path;
+    else
+        qWarning() << "Failed to save inference telemetry to" << path;
+}
@@ -0,0 +1,113 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef INFERTELEMETRY_H
+#define INFERTELEMETRY_H
+
+#define inferTelemetry InferTelemetry::instance()
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "Utils/Singleton.h"
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+
+// Collects per-stage timing of the inference tasks. Recording is lock-free so that it can be
+// called from any worker thread without disturbing the measured code.
+class InferTelemetry final : public QObject {
+    Q_OBJECT
+
+public:
+    enum Stage { Duration, Pitch, Variance, Acoustic, Vocoder, StageCount };
+    Q_ENUM(Stage)
+    enum Phase {
+        QueueWait,
+        SessionAcquire,
+        ModelRun,
+        CacheLookup,
+        Io,
+        CancelLatency, // From terminate() to the end of the task
+        PhaseCount
+    };
+    Q_ENUM(Phase)
+
+    // Log2 buckets in microseconds: bucket i holds samples in [2^(i-1), 2^i) us
+    static constexpr int BucketCount = 32;
+
+    class Snapshot {
+    public:
+        quint64 count = 0;
+        quint64 totalUs = 0;
+        quint64 maxUs = 0;
+        std::array<quint64, BucketCount> buckets{};
+
+        [[nodiscard]] double meanMs() const;
+        [[nodiscard]] double maxMs() const;
+        // Estimates the percentile by interpolating linearly inside the matching bucket
+        [[nodiscard]] double percentileMs(double p) const;
+        [[nodiscard]] QJsonObject toJson() const;
+    };
+
+    class Histogram {
+    public:
+        void record(qint64 ns);
+        void reset();
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        std::array<std::atomic<quint64>, BucketCount> m_buckets{};
+        std::atomic<quint64> m_totalUs{0};
+        std::atomic<quint64> m_maxUs{0};
+    };
+
+    // Records the lifetime of the object into the given stage and phase
+    class ScopedTimer {
+    public:
+        ScopedTimer(Stage stage, Phase phase);
+        ~ScopedTimer();
+        Q_DISABLE_COPY_MOVE(ScopedTimer)
+
+    private:
+        Stage m_stage;
+        Phase m_phase;
+        QElapsedTimer m_timer;
+    };
+
+private:
+    explicit InferTelemetry(QObject *parent = nullptr);
+    ~InferTelemetry() override;
+
+public:
+    LITE_SINGLETON_DECLARE_INSTANCE(InferTelemetry)
+    Q_DISABLE_COPY_MOVE(InferTelemetry)
+
+    void record(Stage stage, Phase phase, qint64 ns);
+
+    template <typename Func>
+    static decltype(auto) measure(Stage stage, Phase phase, Func &&func) {
+        ScopedTimer timer(stage, phase);
+        return func();
+    }
+
+    [[nodiscard]] Snapshot snapshot(Stage stage, Phase phase) const;
+    void reset();
+
+    [[nodiscard]] QJsonObject toJson() const;
+    bool dumpToFile(const QString &path) const;
+    [[nodiscard]] static QString defaultDumpPath();
+
+    [[nodiscard]] static QString stageName(Stage stage);
+    [[nodiscard]] static QString phaseName(Phase phase);
+
+private:
+    void onAboutToQuit() const;
+
+    std::array<std::array<Histogram, PhaseCount>, StageCount> m_histograms;
+};
+
+#endif // INFERTELEMETRY_H
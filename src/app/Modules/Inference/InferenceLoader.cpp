@@ -161,6 +161,10 @@ const InferenceImportOptionsSet &InferenceLoader::importOptions() const {
     return m_importOptions;
 }
 
+const InferenceSpecSet &InferenceLoader::specs() const {
+    return m_specs;
+}
+
 bool InferenceLoader::hasDuration() const noexcept {
     return m_specs.duration && m_importOptions.duration;
 }
@@ -66,6 +66,7 @@ public:
     QVersionNumber packageVersion() const;
     const srt::SingerSpec *singerSpec() const;
     const InferenceImportOptionsSet &importOptions() const;
+    const InferenceSpecSet &specs() const;
 
     bool hasDuration() const noexcept;
     bool hasPitch() const noexcept;
@@ -101,7 +101,7 @@ void InferAcousticState::handleTaskFinished(InferAcousticTask &task) {
         return;
     }
 
-    inferController->finishCurrentInferAcousticTask();
+    inferController->finishInferAcousticTask(task);
 
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
@@ -102,7 +102,7 @@ void InferDurationState::handleTaskFinished(InferDurationTask &task) {
         return;
     }
 
-    inferController->finishCurrentInferDurationTask();
+    inferController->finishInferDurationTask(task);
 
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
@@ -99,7 +99,7 @@ void InferPitchState::handleTaskFinished(InferPitchTask &task) {
         return;
     }
 
-    inferController->finishCurrentInferPitchTask();
+    inferController->finishInferPitchTask(task);
 
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
@@ -102,7 +102,7 @@ void InferVarianceState::handleTaskFinished(InferVarianceTask &task) {
         return;
     }
 
-    inferController->finishCurrentInferVarianceTask();
+    inferController->finishInferVarianceTask(task);
 
     const auto clip = appModel->findClipById(task.clipId());
     if (task.terminated() || !clip) {
@@ -5,6 +5,7 @@
 #ifndef IINFERTASK_H
 #define IINFERTASK_H
 
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Task/Task.h"
 #include "Utils/Macros.h"
 
@@ -13,6 +14,12 @@ LITE_INTERFACE IInferTask : public Task {
     I_NODSCD(int clipId() const);
     I_NODSCD(int pieceId() const);
     I_NODSCD(bool success() const);
+    I_NODSCD(InferTelemetry::Stage stage() const);
+
+protected:
+    void onCancelLatencyMeasured(const qint64 ns) override {
+        inferTelemetry->record(stage(), InferTelemetry::CancelLatency, ns);
+    }
 };
 
 
@@ -12,10 +12,13 @@
 #include "Model/AppOptions/AppOptions.h"
 #include "Modules/Inference/Models/InferInputNote.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/Inference/InferStageTuner.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Inference/Models/GenericInferModel.h"
 #include "Modules/Inference/Utils/InferTaskHelper.h"
+#include "Modules/Inference/VocoderSessionPool.h"
+#include "Utils/CurveResampler.h"
 #include "Utils/JsonUtils.h"
-#include "Utils/MathUtils.h"
 #include "Utils/StringUtils.h"
 
 #include "InferTaskCommon.h"
@@ -47,7 +50,12 @@ bool InferAcousticTask::success() const {
     return m_success.load(std::memory_order_acquire);
 }
 
+InferTelemetry::Stage InferAcousticTask::stage() const {
+    return InferTelemetry::Acoustic;
+}
+
 InferAcousticTask::InferAcousticTask(InferAcousticInput input) : m_input(std::move(input)) {
+    m_queuedTimer.start();
     setPriority(1);
     buildPreviewText();
     TaskStatus status;
@@ -70,6 +78,8 @@ QString InferAcousticTask::result() const {
 void InferAcousticTask::runTask() {
     qDebug() << "Running task..."
              << "pieceId:" << pieceId() << " clipId:" << clipId() << "taskId:" << id();
+    inferTelemetry->record(InferTelemetry::Acoustic, InferTelemetry::QueueWait,
+                           m_queuedTimer.nsecsElapsed());
     auto newStatus = status();
     newStatus.message = tr("Running inference: %1").arg(m_previewText);
     newStatus.isIndetermine = true;
@@ -77,17 +87,24 @@ void InferAcousticTask::runTask() {
 
     GenericInferModel model;
     const auto input = buildInputJson();
+    QElapsedTimer cacheLookupTimer;
+    cacheLookupTimer.start();
     m_inputHash = input.hashData();
     const auto cacheDir = QDir(appOptions->inference()->cacheDirectory);
-    const auto inputCachePath =
-        cacheDir.filePath(QString("infer-acoustic-input-%1.json").arg(m_inputHash));
-    if (!QFile(inputCachePath).exists())
-        JsonUtils::save(inputCachePath, input.serialize());
     bool useCache = false;
     const auto outputCachePath =
         cacheDir.filePath(QString("infer-acoustic-output-%1.wav").arg(m_inputHash));
     if (QFile(outputCachePath).exists())
         useCache = true;
+    inferTelemetry->record(InferTelemetry::Acoustic, InferTelemetry::CacheLookup,
+                           cacheLookupTimer.nsecsElapsed());
+
+    const auto inputCachePath =
+        cacheDir.filePath(QString("infer-acoustic-input-%1.json").arg(m_inputHash));
+    if (!QFile(inputCachePath).exists()) {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Acoustic, InferTelemetry::Io);
+        JsonUtils::save(inputCachePath, input.serialize());
+    }
 
     QString errorMessage;
     if (useCache) {
@@ -99,7 +116,11 @@ void InferAcousticTask::runTask() {
             abort();
             return;
         }
-        if (!inferEngine->loadInferencesForSinger(m_input.identifier)) {
+        if (!InferTelemetry::measure(InferTelemetry::Acoustic, InferTelemetry::SessionAcquire,
+                                     [this] {
+                                         return inferEngine->loadInferencesForSinger(
+                                             m_input.identifier);
+                                     })) {
             qCritical() << "Task failed" << m_input.identifier << "clipId:" << clipId()
                         << "pieceId:" << pieceId() << "taskId:" << id();
             return;
@@ -161,8 +182,13 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
     }
 
     // Create inference
-    auto expAcoustic = loader->createAcoustic();
-    auto expVocoder = loader->createVocoder();
+    auto expAcoustic = InferTelemetry::measure(InferTelemetry::Acoustic,
+                                               InferTelemetry::SessionAcquire,
+                                               [&loader] { return loader->createAcoustic(); });
+    // Shared with the other singers using the same vocoder
+    auto expVocoder =
+        InferTelemetry::measure(InferTelemetry::Vocoder, InferTelemetry::SessionAcquire,
+                                [&loader] { return vocoderSessionPool->acquire(*loader); });
     if (!expAcoustic || !expVocoder) {
         if (!expAcoustic) {
             qCritical().noquote().nospace() << "inferenceAcoustic: Failed to create acoustic inference for "
@@ -175,12 +201,18 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
         return false;
     }
     inferenceAcoustic = expAcoustic.get();
-    inferenceVocoder = expVocoder.get();
-
-    m_inferenceAcoustic = inferenceAcoustic;
-    m_inferenceVocoder = inferenceVocoder;
-
-    // Infer acoustic
+    const auto vocoderLease = expVocoder.get();
+    inferenceVocoder = vocoderLease.session();
+
+    // Interrupt the session runs as soon as the task is terminated
+    const CancellationToken::Registration stopOnCancel(cancellationToken(), [&] {
+        inferenceAcoustic->stop();
+        inferenceVocoder->stop();
+    });
+
+    // Infer acoustic. The vocoder run is included when tuning the stage.
+    QElapsedTimer runTimer;
+    runTimer.start();
     srt::NO<ds::ITensor> mel;
     srt::NO<ds::ITensor> f0;
     {
@@ -190,7 +222,9 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
             abort();
             return false;
         }
-        if (auto exp = inferenceAcoustic->start(input); !exp) {
+        if (auto exp = InferTelemetry::measure(InferTelemetry::Acoustic, InferTelemetry::ModelRun,
+                                               [&] { return inferenceAcoustic->start(input); });
+            !exp) {
             qCritical().noquote().nospace() << "inferAcoustic: Failed to start acoustic inference for "
                                             << identifier << ": " << exp.error().message();
             return false;
@@ -198,6 +232,10 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
             result = exp.take().as<Ac::AcousticResult>();
         }
 
+        if (isTerminateRequested()) {
+            abort();
+            return false;
+        }
         if (inferenceAcoustic->state() == srt::ITask::Failed) {
             qCritical().noquote().nospace() << "inferAcoustic: Failed to run acoustic inference for "
                                             << identifier << ": " << result->error.message();
@@ -218,7 +256,10 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
             abort();
             return false;
         }
-        if (auto exp = inferenceVocoder->start(vocoderInput); !exp) {
+        if (auto exp =
+                InferTelemetry::measure(InferTelemetry::Vocoder, InferTelemetry::ModelRun,
+                                        [&] { return inferenceVocoder->start(vocoderInput); });
+            !exp) {
             qCritical().noquote().nospace() << "inferAcoustic: Failed to start vocoder inference for "
                                             << identifier << ": " << exp.error().message();
             return false;
@@ -226,11 +267,17 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
             result = exp.take().as<Vo::VocoderResult>();
         }
 
+        if (isTerminateRequested()) {
+            abort();
+            return false;
+        }
         if (inferenceVocoder->state() == srt::ITask::Failed) {
             qCritical().noquote().nospace() << "inferAcoustic: Failed to run vocoder inference for "
                                             << identifier << ": " << result->error.message();
             return false;
         }
+        inferStageTuner->recordRun(InferTelemetry::Acoustic, identifier, runTimer.nsecsElapsed(),
+                                   InferTaskHelper::inputLengthMs(m_input));
         const auto &audioRawData = result->audioData;
 
         const auto outputPathStr = StringUtils::qstr_to_native(outputPath);
@@ -240,6 +287,7 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
             return false;
         }
 
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Acoustic, InferTelemetry::Io);
         SndfileHandle audioFile(outputPathStr.c_str(), SFM_WRITE, SF_FORMAT_WAV | SF_FORMAT_FLOAT,
                                 1, 44100);
         if (audioFile.error() != SF_ERR_NO_ERROR) {
@@ -256,16 +304,6 @@ bool InferAcousticTask::runInference(const GenericInferModel &model, const QStri
     return true;
 }
 
-void InferAcousticTask::terminate() {
-    if (m_inferenceAcoustic) {
-        m_inferenceAcoustic->stop();
-    }
-    if (m_inferenceVocoder) {
-        m_inferenceVocoder->stop();
-    }
-    IInferTask::terminate();
-}
-
 void InferAcousticTask::abort() {
     auto newStatus = status();
     newStatus.message = tr("Terminating: %1").arg(m_previewText);
@@ -292,7 +330,6 @@ GenericInferModel InferAcousticTask::buildInputJson() const {
         totalLength += word.length();
 
     int frames = qRound(totalLength / interval);
-    auto newInterval = m_input.timeline.secToTick(interval);
     InferRetake retake;
     retake.end = frames;
 
@@ -300,46 +337,40 @@ GenericInferModel InferAcousticTask::buildInputJson() const {
     param.dynamic = true;
     param.retake = retake;
 
-    InferParam pitch = param;
-    pitch.tag = "pitch";
-    pitch.values = MathUtils::resample(m_input.pitch.values, 5 /*tick*/, newInterval);
-
-    InferParam breathiness = param;
-    breathiness.tag = "breathiness";
-    breathiness.values = MathUtils::resample(m_input.breathiness.values, 5, newInterval);
-
-    InferParam tension = param;
-    tension.tag = "tension";
-    tension.values = MathUtils::resample(m_input.tension.values, 5, newInterval);
-
-    InferParam voicing = param;
-    voicing.tag = "voicing";
-    voicing.values = MathUtils::resample(m_input.voicing.values, 5, newInterval);
-
-    InferParam energy = param;
-    energy.tag = "energy";
-    energy.values = MathUtils::resample(m_input.energy.values, 5, newInterval);
-
-    InferParam mouthOpening = param;
-    mouthOpening.tag = "mouth_opening";
-    mouthOpening.values = MathUtils::resample(m_input.mouthOpening.values, 5, newInterval);
-
-    InferParam gender = param;
-    gender.tag = "gender";
-    gender.values = MathUtils::resample(m_input.gender.values, 5, newInterval);
-
-    InferParam velocity = param;
-    velocity.tag = "velocity";
-    velocity.values = MathUtils::resample(m_input.velocity.values, 5, newInterval);
-
-    InferParam toneShift = param;
-    toneShift.tag = "tone_shift";
-    toneShift.values = MathUtils::resample(m_input.toneShift.values, 5, newInterval);
+    const QList<std::pair<QString, const QList<double> *>> curves = {
+        {"pitch",         &m_input.pitch.values       },
+        {"breathiness",   &m_input.breathiness.values },
+        {"tension",       &m_input.tension.values     },
+        {"voicing",       &m_input.voicing.values     },
+        {"energy",        &m_input.energy.values      },
+        {"mouth_opening", &m_input.mouthOpening.values},
+        {"gender",        &m_input.gender.values      },
+        {"velocity",      &m_input.velocity.values    },
+        {"tone_shift",    &m_input.toneShift.values   },
+    };
+    QList<const QList<double> *> curveValues;
+    qsizetype maxCount = 0;
+    for (const auto &[tag, values] : curves) {
+        curveValues.append(values);
+        maxCount = qMax(maxCount, values->count());
+    }
+    // Frames are evenly spaced in time, so their spacing in ticks follows the tempo map
+    const auto frameTicks =
+        InferTaskHelper::frameTicks(m_input, interval, static_cast<double>(maxCount - 1) * 5);
+    auto resampled = CurveResampler::resample(curveValues, 5 /*tick*/, frameTicks);
+
+    QList<InferParam> params;
+    for (qsizetype i = 0; i < curves.count(); i++) {
+        InferParam inferParam = param;
+        inferParam.tag = curves[i].first;
+        inferParam.values = std::move(resampled[i]);
+        params.append(inferParam);
+    }
 
     GenericInferModel model;
     model.speaker = m_input.speaker;
     model.words = words;
-    model.params = {pitch, breathiness, tension, voicing, energy, mouthOpening, gender, velocity, toneShift};
+    model.params = params;
     model.steps = appOptions->inference()->samplingSteps;
     model.depth = appOptions->inference()->depth;
     model.identifier = m_input.identifier;
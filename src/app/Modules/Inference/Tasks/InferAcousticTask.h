@@ -7,6 +7,8 @@
 
 #include <atomic>
 
+#include <QElapsedTimer>
+
 #include <synthrt/SVS/Inference.h>
 
 #include "IInferTask.h"
@@ -40,6 +42,7 @@ public:
     [[nodiscard]] int clipId() const override;
     [[nodiscard]] int pieceId() const override;
     [[nodiscard]] bool success() const override;
+    [[nodiscard]] InferTelemetry::Stage stage() const override;
 
     explicit InferAcousticTask(InferAcousticInput input);
     InferAcousticInput input() const;
@@ -48,18 +51,17 @@ public:
 private:
     void runTask() override;
     bool runInference(const GenericInferModel &model, const QString &outputPath, QString &error);
-    void terminate() override;
     void abort();
     void buildPreviewText();
     GenericInferModel buildInputJson() const;
     // bool processOutput(const GenericInferModel &model);
 
-    srt::NO<srt::Inference> m_inferenceAcoustic, m_inferenceVocoder;
     QString m_previewText;
     InferAcousticInput m_input;
     QString m_result;
     QString m_inputHash;
     std::atomic<bool> m_success{false};
+    QElapsedTimer m_queuedTimer;
 };
 
 
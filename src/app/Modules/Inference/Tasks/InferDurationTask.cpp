@@ -8,6 +8,8 @@
 
 #include "Model/AppOptions/AppOptions.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/Inference/InferStageTuner.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Inference/Models/GenericInferModel.h"
 #include "Modules/Inference/Utils/InferTaskHelper.h"
 #include "Utils/JsonUtils.h"
@@ -42,7 +44,12 @@ bool InferDurationTask::success() const {
     return m_success.load(std::memory_order_acquire);
 }
 
+InferTelemetry::Stage InferDurationTask::stage() const {
+    return InferTelemetry::Duration;
+}
+
 InferDurationTask::InferDurationTask(InferDurInput input) : m_input(std::move(input)) {
+    m_queuedTimer.start();
     buildPreviewText();
     TaskStatus status;
     status.title = tr("Infer Duration");
@@ -65,6 +72,8 @@ QList<InferInputNote> InferDurationTask::result() const{
 void InferDurationTask::runTask() {
     qDebug() << "Running task..."
              << "pieceId:" << pieceId() << " clipId:" << clipId() << "taskId:" << id();
+    inferTelemetry->record(InferTelemetry::Duration, InferTelemetry::QueueWait,
+                           m_queuedTimer.nsecsElapsed());
     auto newStatus = status();
     newStatus.message = tr("Running inference: %1").arg(m_previewText);
     newStatus.isIndetermine = true;
@@ -72,12 +81,10 @@ void InferDurationTask::runTask() {
 
     GenericInferModel model;
     const auto input = buildInputJson();
+    QElapsedTimer cacheLookupTimer;
+    cacheLookupTimer.start();
     m_inputHash = input.hashData();
     const auto cacheDir = QDir(appOptions->inference()->cacheDirectory);
-    const auto inputCachePath =
-        cacheDir.filePath(QString("infer-duration-input-%1.json").arg(m_inputHash));
-    if (!QFile(inputCachePath).exists())
-        JsonUtils::save(inputCachePath, input.serialize());
     bool useCache = false;
     const auto outputCachePath =
         cacheDir.filePath(QString("infer-duration-output-%1.json").arg(m_inputHash));
@@ -85,6 +92,15 @@ void InferDurationTask::runTask() {
         QJsonObject obj;
         useCache = JsonUtils::load(outputCachePath, obj) && model.deserialize(obj);
     }
+    inferTelemetry->record(InferTelemetry::Duration, InferTelemetry::CacheLookup,
+                           cacheLookupTimer.nsecsElapsed());
+
+    const auto inputCachePath =
+        cacheDir.filePath(QString("infer-duration-input-%1.json").arg(m_inputHash));
+    if (!QFile(inputCachePath).exists()) {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Duration, InferTelemetry::Io);
+        JsonUtils::save(inputCachePath, input.serialize());
+    }
 
     if (useCache) {
         qInfo() << "Use cached duration inference result:" << outputCachePath;
@@ -95,7 +111,11 @@ void InferDurationTask::runTask() {
             abort();
             return;
         }
-        if (!inferEngine->loadInferencesForSinger(m_input.identifier)) {
+        if (!InferTelemetry::measure(InferTelemetry::Duration, InferTelemetry::SessionAcquire,
+                                     [this] {
+                                         return inferEngine->loadInferencesForSinger(
+                                             m_input.identifier);
+                                     })) {
             qCritical() << "Task failed" << m_input.identifier << "clipId:" << clipId()
                         << "pieceId:" << pieceId() << "taskId:" << id();
             return;
@@ -134,7 +154,10 @@ void InferDurationTask::runTask() {
         return;
     }
 
-    JsonUtils::save(outputCachePath, model.serialize());
+    {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Duration, InferTelemetry::Io);
+        JsonUtils::save(outputCachePath, model.serialize());
+    }
     processOutput(model);
     m_success.store(true, std::memory_order_release);
     qInfo() << "Success:"
@@ -168,23 +191,31 @@ bool InferDurationTask::runInference(const GenericInferModel &model, std::vector
     input->words = convertInputWords(model.words, speakerName, speakerMapping);
 
     // Create inference
-    if (auto exp = loader->createDuration(); !exp) {
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Duration, InferTelemetry::SessionAcquire,
+                                           [&loader] { return loader->createDuration(); });
+        !exp) {
         qCritical().noquote().nospace() << "inferDuration: Failed to create duration inference for "
                                         << identifier << ": " << exp.getError();
         return false;
     } else {
         inferenceDuration = exp.get();
     }
-    m_inferenceDuration = inferenceDuration;
 
     // Run duration
     srt::NO<Dur::DurationResult> result;
+    // Interrupt the session run as soon as the task is terminated
+    const CancellationToken::Registration stopOnCancel(cancellationToken(),
+                                                       [&] { inferenceDuration->stop(); });
     // Start inference
     if (isTerminateRequested()) {
         abort();
         return false;
     }
-    if (auto exp = inferenceDuration->start(input); !exp) {
+    QElapsedTimer runTimer;
+    runTimer.start();
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Duration, InferTelemetry::ModelRun,
+                                           [&] { return inferenceDuration->start(input); });
+        !exp) {
         qCritical().noquote().nospace() << "inferDuration: Failed to start duration inference for "
                                         << identifier << ": " << exp.error().message();
         return false;
@@ -192,24 +223,23 @@ bool InferDurationTask::runInference(const GenericInferModel &model, std::vector
         result = exp.take().as<Dur::DurationResult>();
     }
 
+    if (isTerminateRequested()) {
+        abort();
+        return false;
+    }
     if (inferenceDuration->state() == srt::ITask::Failed) {
         qCritical().noquote().nospace() << "inferDuration: Failed to run duration inference for "
                                         << identifier << ": " << result->error.message();
         return false;
     }
+    inferStageTuner->recordRun(InferTelemetry::Duration, identifier, runTimer.nsecsElapsed(),
+                               InferTaskHelper::inputLengthMs(m_input));
 
     outDuration = std::move(result->durations);
 
     return true;
 }
 
-void InferDurationTask::terminate() {
-    if (m_inferenceDuration) {
-        m_inferenceDuration->stop();
-    }
-    IInferTask::terminate();
-}
-
 void InferDurationTask::abort() {
     auto newStatus = status();
     newStatus.message = tr("Terminating: %1").arg(m_previewText);
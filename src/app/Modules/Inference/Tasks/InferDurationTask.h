@@ -7,6 +7,8 @@
 
 #include <atomic>
 
+#include <QElapsedTimer>
+
 #include <QReadWriteLock>
 
 #include <synthrt/SVS/Inference.h>
@@ -30,6 +32,7 @@ public:
     int clipId() const override;
     int pieceId() const override;
     [[nodiscard]] bool success() const override;
+    [[nodiscard]] InferTelemetry::Stage stage() const override;
 
     explicit InferDurationTask(InferDurInput input);
     InferDurInput input() const;
@@ -39,19 +42,18 @@ private:
     void runTask() override;
     bool runInference(const GenericInferModel &model, std::vector<double> &outDuration,
                       QString &error);
-    void terminate() override;
     void abort();
     void buildPreviewText();
     GenericInferModel buildInputJson() const;
     bool processOutput(const GenericInferModel &model);
 
     mutable QReadWriteLock m_rwLock;
-    srt::NO<srt::Inference> m_inferenceDuration;
     QString m_previewText;
     InferDurInput m_input;
     InferDurInput m_result;
     QString m_inputHash;
     std::atomic<bool> m_success{false};
+    QElapsedTimer m_queuedTimer;
 };
 
 
@@ -8,6 +8,8 @@
 
 #include "Model/AppOptions/AppOptions.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/Inference/InferStageTuner.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Inference/Models/GenericInferModel.h"
 #include "Modules/Inference/Utils/InferTaskHelper.h"
 #include "Utils/JsonUtils.h"
@@ -39,7 +41,12 @@ bool InferPitchTask::success() const {
     return m_success.load(std::memory_order_acquire);
 }
 
+InferTelemetry::Stage InferPitchTask::stage() const {
+    return InferTelemetry::Pitch;
+}
+
 InferPitchTask::InferPitchTask(InferPitchInput input) : m_input(std::move(input)) {
+    m_queuedTimer.start();
     buildPreviewText();
     TaskStatus status;
     status.title = tr("Infer Pitch");
@@ -61,6 +68,8 @@ InferParamCurve InferPitchTask::result() {
 void InferPitchTask::runTask() {
     qDebug() << "Running task..."
              << "pieceId:" << pieceId() << " clipId:" << clipId() << "taskId:" << id();
+    inferTelemetry->record(InferTelemetry::Pitch, InferTelemetry::QueueWait,
+                           m_queuedTimer.nsecsElapsed());
     auto newStatus = status();
     newStatus.message = tr("Running inference: %1").arg(m_previewText);
     newStatus.isIndetermine = true;
@@ -68,12 +77,10 @@ void InferPitchTask::runTask() {
 
     GenericInferModel model;
     const auto input = buildInputJson();
+    QElapsedTimer cacheLookupTimer;
+    cacheLookupTimer.start();
     m_inputHash = input.hashData();
     const auto cacheDir = QDir(appOptions->inference()->cacheDirectory);
-    const auto inputCachePath =
-        cacheDir.filePath(QString("infer-pitch-input-%1.json").arg(m_inputHash));
-    if (!QFile(inputCachePath).exists())
-        JsonUtils::save(inputCachePath, input.serialize());
     bool useCache = false;
     const auto outputCachePath =
         cacheDir.filePath(QString("infer-pitch-output-%1.json").arg(m_inputHash));
@@ -81,6 +88,15 @@ void InferPitchTask::runTask() {
         QJsonObject obj;
         useCache = JsonUtils::load(outputCachePath, obj) && model.deserialize(obj);
     }
+    inferTelemetry->record(InferTelemetry::Pitch, InferTelemetry::CacheLookup,
+                           cacheLookupTimer.nsecsElapsed());
+
+    const auto inputCachePath =
+        cacheDir.filePath(QString("infer-pitch-input-%1.json").arg(m_inputHash));
+    if (!QFile(inputCachePath).exists()) {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Pitch, InferTelemetry::Io);
+        JsonUtils::save(inputCachePath, input.serialize());
+    }
 
     if (useCache) {
         qInfo() << "Use cached pitch inference result:" << outputCachePath;
@@ -91,7 +107,11 @@ void InferPitchTask::runTask() {
             abort();
             return;
         }
-        if (!inferEngine->loadInferencesForSinger(m_input.identifier)) {
+        if (!InferTelemetry::measure(InferTelemetry::Pitch, InferTelemetry::SessionAcquire,
+                                     [this] {
+                                         return inferEngine->loadInferencesForSinger(
+                                             m_input.identifier);
+                                     })) {
             qCritical() << "Task failed" << m_input.identifier << "clipId:" << clipId()
                         << "pieceId:" << pieceId() << "taskId:" << id();
             return;
@@ -119,7 +139,10 @@ void InferPitchTask::runTask() {
         return;
     }
 
-    JsonUtils::save(outputCachePath, model.serialize());
+    {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Pitch, InferTelemetry::Io);
+        JsonUtils::save(outputCachePath, model.serialize());
+    }
     processOutput(model);
     m_success.store(true, std::memory_order_release);
     qInfo() << "Success:"
@@ -164,23 +187,31 @@ bool InferPitchTask::runInference(const GenericInferModel &model, InferParam &ou
     }
 
     // Create inference
-    if (auto exp = loader->createPitch(); !exp) {
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Pitch, InferTelemetry::SessionAcquire,
+                                           [&loader] { return loader->createPitch(); });
+        !exp) {
         qCritical().noquote().nospace() << "inferPitch: Failed to create pitch inference for "
                                         << identifier << ": " << exp.getError();
         return false;
     } else {
         inferencePitch = exp.get();
     }
-    m_inferencePitch = inferencePitch;
 
     // Run pitch
     srt::NO<Pit::PitchResult> result;
+    // Interrupt the session run as soon as the task is terminated
+    const CancellationToken::Registration stopOnCancel(cancellationToken(),
+                                                       [&] { inferencePitch->stop(); });
     // Start inference
     if (isTerminateRequested()) {
         abort();
         return false;
     }
-    if (auto exp = inferencePitch->start(input); !exp) {
+    QElapsedTimer runTimer;
+    runTimer.start();
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Pitch, InferTelemetry::ModelRun,
+                                           [&] { return inferencePitch->start(input); });
+        !exp) {
         qCritical().noquote().nospace() << "inferPitch: Failed to start pitch inference for "
                                         << identifier << ": " << exp.error().message();
         return false;
@@ -188,11 +219,17 @@ bool InferPitchTask::runInference(const GenericInferModel &model, InferParam &ou
         result = exp.take().as<Pit::PitchResult>();
     }
 
+    if (isTerminateRequested()) {
+        abort();
+        return false;
+    }
     if (inferencePitch->state() == srt::ITask::Failed) {
         qCritical().noquote().nospace() << "inferPitch: Failed to run pitch inference for "
                                         << identifier << ": " << result->error.message();
         return false;
     }
+    inferStageTuner->recordRun(InferTelemetry::Pitch, identifier, runTimer.nsecsElapsed(),
+                               InferTaskHelper::inputLengthMs(m_input));
 
     outPitch.tag = "pitch";
     outPitch.interval = result->interval;
@@ -201,13 +238,6 @@ bool InferPitchTask::runInference(const GenericInferModel &model, InferParam &ou
     return true;
 }
 
-void InferPitchTask::terminate() {
-    if (m_inferencePitch) {
-        m_inferencePitch->stop();
-    }
-    IInferTask::terminate();
-}
-
 void InferPitchTask::abort() {
     auto newStatus = status();
     newStatus.message = tr("Terminating: %1").arg(m_previewText);
@@ -234,7 +264,6 @@ GenericInferModel InferPitchTask::buildInputJson() const {
     for (const auto &word : words)
         totalLength += word.length();
 
-    const auto newInterval = m_input.timeline.secToTick(interval);
     const int frames = qRound(totalLength / interval);
     InferRetake retake;
     retake.end = frames;
@@ -245,12 +274,15 @@ GenericInferModel InferPitchTask::buildInputJson() const {
 
     InferParam expr = param;
     expr.tag = "expr";
-    expr.values = MathUtils::resample(m_input.expressiveness.values, 5, newInterval);
+    // Frames are evenly spaced in time, so their spacing in ticks follows the tempo map
+    const auto &exprValues = m_input.expressiveness.values;
+    const auto frameTicks = InferTaskHelper::frameTicks(
+        m_input, interval, static_cast<double>(exprValues.count() - 1) * 5);
+    expr.values = CurveResampler(exprValues.count(), 5, frameTicks).resample(exprValues);
 
     InferParam pitch = param;
     pitch.tag = "pitch";
-    for (int i = 0; i < frames; i++)
-        pitch.values.append(0);
+    pitch.values.fill(0, frames);
 
     GenericInferModel model;
     model.speaker = m_input.speaker;
@@ -263,7 +295,9 @@ GenericInferModel InferPitchTask::buildInputJson() const {
 
 bool InferPitchTask::processOutput(const GenericInferModel &model) {
     const auto oriPitch = Linq::where(model.params, L_PRED(p, p.tag == "pitch")).first();
-    const auto newInterval = m_input.timeline.tickToSec(5);
-    m_result.values = MathUtils::resample(oriPitch.values, oriPitch.interval, newInterval);
+    const auto sampleSecs = InferTaskHelper::sampleSecs(
+        m_input, 5, static_cast<double>(oriPitch.values.count() - 1) * oriPitch.interval);
+    m_result.values = CurveResampler(oriPitch.values.count(), oriPitch.interval, sampleSecs)
+                          .resample(oriPitch.values);
     return true;
 }
\ No newline at end of file
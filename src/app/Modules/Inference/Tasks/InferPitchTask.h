@@ -7,6 +7,8 @@
 
 #include <atomic>
 
+#include <QElapsedTimer>
+
 #include <synthrt/SVS/Inference.h>
 
 #include "IInferTask.h"
@@ -30,6 +32,7 @@ public:
     [[nodiscard]] int clipId() const override;
     [[nodiscard]] int pieceId() const override;
     [[nodiscard]] bool success() const override;
+    [[nodiscard]] InferTelemetry::Stage stage() const override;
 
     explicit InferPitchTask(InferPitchInput input);
     InferPitchInput input() const;
@@ -38,18 +41,17 @@ public:
 private:
     void runTask() override;
     bool runInference(const GenericInferModel &model, InferParam &outPitch, QString &error);
-    void terminate() override;
     void abort();
     void buildPreviewText();
     GenericInferModel buildInputJson() const;
     bool processOutput(const GenericInferModel &model);
 
-    srt::NO<srt::Inference> m_inferencePitch;
     QString m_previewText;
     InferPitchInput m_input;
     InferParamCurve m_result;
     QString m_inputHash;
     std::atomic<bool> m_success{false};
+    QElapsedTimer m_queuedTimer;
 };
 
 
@@ -8,6 +8,8 @@
 
 #include "Model/AppOptions/AppOptions.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/Inference/InferStageTuner.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/Inference/Models/GenericInferModel.h"
 #include "Modules/Inference/Models/InferInputNote.h"
 #include "Modules/Inference/Utils/InferTaskHelper.h"
@@ -39,7 +41,12 @@ bool InferVarianceTask::success() const {
     return m_success.load(std::memory_order_acquire);
 }
 
+InferTelemetry::Stage InferVarianceTask::stage() const {
+    return InferTelemetry::Variance;
+}
+
 InferVarianceTask::InferVarianceTask(InferVarianceInput input) : m_input(std::move(input)) {
+    m_queuedTimer.start();
     buildPreviewText();
     TaskStatus status;
     status.title = tr("Infer Variance");
@@ -61,6 +68,8 @@ InferVarianceTask::InferVarianceResult InferVarianceTask::result() const {
 void InferVarianceTask::runTask() {
     qDebug() << "Running task..."
              << "pieceId:" << pieceId() << " clipId:" << clipId() << "taskId:" << id();
+    inferTelemetry->record(InferTelemetry::Variance, InferTelemetry::QueueWait,
+                           m_queuedTimer.nsecsElapsed());
     auto newStatus = status();
     newStatus.message = tr("Running inference: %1").arg(m_previewText);
     newStatus.isIndetermine = true;
@@ -68,12 +77,10 @@ void InferVarianceTask::runTask() {
 
     GenericInferModel model;
     const auto input = buildInputJson();
+    QElapsedTimer cacheLookupTimer;
+    cacheLookupTimer.start();
     m_inputHash = input.hashData();
     const auto cacheDir = QDir(appOptions->inference()->cacheDirectory);
-    const auto inputCachePath =
-        cacheDir.filePath(QString("infer-variance-input-%1.json").arg(m_inputHash));
-    if (!QFile(inputCachePath).exists())
-        JsonUtils::save(inputCachePath, input.serialize());
     bool useCache = false;
     const auto outputCachePath =
         cacheDir.filePath(QString("infer-variance-output-%1.json").arg(m_inputHash));
@@ -81,6 +88,15 @@ void InferVarianceTask::runTask() {
         QJsonObject obj;
         useCache = JsonUtils::load(outputCachePath, obj) && model.deserialize(obj);
     }
+    inferTelemetry->record(InferTelemetry::Variance, InferTelemetry::CacheLookup,
+                           cacheLookupTimer.nsecsElapsed());
+
+    const auto inputCachePath =
+        cacheDir.filePath(QString("infer-variance-input-%1.json").arg(m_inputHash));
+    if (!QFile(inputCachePath).exists()) {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Variance, InferTelemetry::Io);
+        JsonUtils::save(inputCachePath, input.serialize());
+    }
 
     if (useCache) {
         qInfo() << "Use cached variance inference result:" << outputCachePath;
@@ -91,7 +107,11 @@ void InferVarianceTask::runTask() {
             abort();
             return;
         }
-        if (!inferEngine->loadInferencesForSinger(m_input.identifier)) {
+        if (!InferTelemetry::measure(InferTelemetry::Variance, InferTelemetry::SessionAcquire,
+                                     [this] {
+                                         return inferEngine->loadInferencesForSinger(
+                                             m_input.identifier);
+                                     })) {
             qCritical() << "Task failed" << m_input.identifier << "clipId:" << clipId()
                         << "pieceId:" << pieceId() << "taskId:" << id();
             return;
@@ -121,7 +141,10 @@ void InferVarianceTask::runTask() {
         return;
     }
 
-    JsonUtils::save(outputCachePath, model.serialize());
+    {
+        InferTelemetry::ScopedTimer ioTimer(InferTelemetry::Variance, InferTelemetry::Io);
+        JsonUtils::save(outputCachePath, model.serialize());
+    }
     processOutput(model);
     m_success.store(true, std::memory_order_release);
     qInfo() << "Success:"
@@ -166,23 +189,31 @@ bool InferVarianceTask::runInference(const GenericInferModel &model, QList<Infer
     }
 
     // Create inference
-    if (auto exp = loader->createVariance(); !exp) {
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Variance, InferTelemetry::SessionAcquire,
+                                           [&loader] { return loader->createVariance(); });
+        !exp) {
         qCritical().noquote().nospace() << "inferVariance: Failed to create variance inference for "
                                         << identifier << ": " << exp.getError();
         return false;
     } else {
         inferenceVariance = exp.get();
     }
-    m_inferenceVariance = inferenceVariance;
 
     // Run variance
     srt::NO<Var::VarianceResult> result;
+    // Interrupt the session run as soon as the task is terminated
+    const CancellationToken::Registration stopOnCancel(cancellationToken(),
+                                                       [&] { inferenceVariance->stop(); });
     // Start inference
     if (isTerminateRequested()) {
         abort();
         return false;
     }
-    if (auto exp = inferenceVariance->start(input); !exp) {
+    QElapsedTimer runTimer;
+    runTimer.start();
+    if (auto exp = InferTelemetry::measure(InferTelemetry::Variance, InferTelemetry::ModelRun,
+                                           [&] { return inferenceVariance->start(input); });
+        !exp) {
         qCritical().noquote().nospace() << "inferVariance: Failed to start variance inference for "
                                         << identifier << ": " << exp.error().message();
         return false;
@@ -190,11 +221,17 @@ bool InferVarianceTask::runInference(const GenericInferModel &model, QList<Infer
         result = exp.take().as<Var::VarianceResult>();
     }
 
+    if (isTerminateRequested()) {
+        abort();
+        return false;
+    }
     if (inferenceVariance->state() == srt::ITask::Failed) {
         qCritical().noquote().nospace() << "inferVariance: Failed to run variance inference for "
                                         << identifier << ": " << result->error.message();
         return false;
     }
+    inferStageTuner->recordRun(InferTelemetry::Variance, identifier, runTimer.nsecsElapsed(),
+                               InferTaskHelper::inputLengthMs(m_input));
     outParams.reserve(result->predictions.size());
     for (const auto &param : result->predictions) {
         InferParam inferParam;
@@ -207,13 +244,6 @@ bool InferVarianceTask::runInference(const GenericInferModel &model, QList<Infer
     return true;
 }
 
-void InferVarianceTask::terminate() {
-    if (m_inferenceVariance) {
-        m_inferenceVariance->stop();
-    }
-    IInferTask::terminate();
-}
-
 void InferVarianceTask::abort() {
     auto newStatus = status();
     newStatus.message = tr("Terminating: %1").arg(m_previewText);
@@ -249,8 +279,12 @@ GenericInferModel InferVarianceTask::buildInputJson() const {
 
     InferParam pitch = param;
     pitch.tag = "pitch";
+    // Frames are evenly spaced in time, so their spacing in ticks follows the tempo map
+    const auto &pitchValues = m_input.pitch.values;
+    const auto frameTicks = InferTaskHelper::frameTicks(
+        m_input, interval, static_cast<double>(pitchValues.count() - 1) * 5);
     pitch.values =
-        MathUtils::resample(m_input.pitch.values, 5 /*tick*/, m_input.timeline.secToTick(interval));
+        CurveResampler(pitchValues.count(), 5 /*tick*/, frameTicks).resample(pitchValues);
 
     InferParam breathiness = param;
     breathiness.tag = "breathiness";
@@ -262,13 +296,13 @@ GenericInferModel InferVarianceTask::buildInputJson() const {
     energy.tag = "energy";
     InferParam mouthOpening = param;
     mouthOpening.tag = "mouth_opening";
-    for (int i = 0; i < frames; i++) {
-        breathiness.values.append(0);
-        tension.values.append(0);
-        voicing.values.append(0);
-        energy.values.append(0);
-        mouthOpening.values.append(0);
-    }
+    // Placeholders for the predicted curves, sharing one zero-filled buffer
+    const QList<double> zeros(frames, 0);
+    breathiness.values = zeros;
+    tension.values = zeros;
+    voicing.values = zeros;
+    energy.values = zeros;
+    mouthOpening.values = zeros;
 
     GenericInferModel model;
     model.speaker = m_input.speaker;
@@ -280,24 +314,29 @@ GenericInferModel InferVarianceTask::buildInputJson() const {
 }
 
 bool InferVarianceTask::processOutput(const GenericInferModel &model) {
-    const auto newInterval = m_input.timeline.tickToSec(5);
-
-    const auto breathiness = Linq::where(model.params, L_PRED(p, p.tag == "breathiness")).first();
-    m_result.breathiness.values =
-        MathUtils::resample(breathiness.values, breathiness.interval, newInterval);
-
-    const auto tension = Linq::where(model.params, L_PRED(p, p.tag == "tension")).first();
-    m_result.tension.values = MathUtils::resample(tension.values, tension.interval, newInterval);
-
-    const auto voicing = Linq::where(model.params, L_PRED(p, p.tag == "voicing")).first();
-    m_result.voicing.values = MathUtils::resample(voicing.values, voicing.interval, newInterval);
-
-    const auto energy = Linq::where(model.params, L_PRED(p, p.tag == "energy")).first();
-    m_result.energy.values = MathUtils::resample(energy.values, energy.interval, newInterval);
-
-    const auto mouthOpening =
-        Linq::where(model.params, L_PRED(p, p.tag == "mouth_opening")).first();
-    m_result.mouthOpening.values =
-        MathUtils::resample(mouthOpening.values, mouthOpening.interval, newInterval);
+    const auto paramOf = [&](const QString &tag) {
+        return Linq::where(model.params, L_PRED(p, p.tag == tag)).first();
+    };
+    const auto breathiness = paramOf("breathiness");
+    const auto tension = paramOf("tension");
+    const auto voicing = paramOf("voicing");
+    const auto energy = paramOf("energy");
+    const auto mouthOpening = paramOf("mouth_opening");
+
+    // The tick samples are at the same times for every curve, whatever its frame interval
+    double lengthSec = 0;
+    for (const auto &param : {breathiness, tension, voicing, energy, mouthOpening})
+        lengthSec =
+            qMax(lengthSec, static_cast<double>(param.values.count() - 1) * param.interval);
+    const auto sampleSecs = InferTaskHelper::sampleSecs(m_input, 5, lengthSec);
+    const auto resample = [&](const InferParam &param) {
+        return CurveResampler(param.values.count(), param.interval, sampleSecs)
+            .resample(param.values);
+    };
+    m_result.breathiness.values = resample(breathiness);
+    m_result.tension.values = resample(tension);
+    m_result.voicing.values = resample(voicing);
+    m_result.energy.values = resample(energy);
+    m_result.mouthOpening.values = resample(mouthOpening);
     return true;
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 #include <atomic>
 
+#include <QElapsedTimer>
+
 #include <synthrt/SVS/Inference.h>
 
 #include "IInferTask.h"
@@ -40,6 +42,7 @@ public:
     [[nodiscard]] int clipId() const override;
     [[nodiscard]] int pieceId() const override;
     [[nodiscard]] bool success() const override;
+    [[nodiscard]] InferTelemetry::Stage stage() const override;
 
     explicit InferVarianceTask(InferVarianceInput input);
     InferVarianceInput input() const;
@@ -48,18 +51,17 @@ public:
 private:
     void runTask() override;
     bool runInference(const GenericInferModel &model, QList<InferParam> &outParams, QString &error);
-    void terminate() override;
     void abort();
     void buildPreviewText();
     GenericInferModel buildInputJson() const;
     bool processOutput(const GenericInferModel &model);
 
-    srt::NO<srt::Inference> m_inferenceVariance;
     QString m_previewText;
     InferVarianceInput m_input;
     InferVarianceResult m_result;
     QString m_inputHash;
     std::atomic<bool> m_success{false};
+    QElapsedTimer m_queuedTimer;
 };
 
 #endif // INFERVARIANCETASK_H
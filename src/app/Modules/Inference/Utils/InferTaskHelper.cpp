@@ -8,6 +8,8 @@
 #include "Modules/Inference/Models/InferInputBase.h"
 #include "Modules/Inference/Models/InferInputNote.h"
 
+#include <QtMath>
+
 QList<InferWord> InferTaskHelper::buildWords(const InferInputBase &input, bool useOffsetInfo) {
     const auto &notes = input.notes;
     const auto &timeline = input.timeline;
@@ -51,8 +53,8 @@ QList<InferWord> InferTaskHelper::buildWords(const InferInputBase &input, bool u
         const auto &note = notes.at(noteIndex);
         lastKey = note.key;
         wordStart = timeline.tickToSec(note.start);
-        wordLen = timeline.tickToSec(note.start + note.length) - wordStart;
-        noteBuffer.append({note.key, 0, timeline.tickToSec(note.length), note.isRest});
+        wordLen = timeline.tickLengthToSec(note.start, note.length);
+        noteBuffer.append({note.key, 0, wordLen, note.isRest});
 
         for (int i = 0; i < note.normalNames.count(); i++) {
             auto name = note.normalNames.at(i);
@@ -75,10 +77,9 @@ QList<InferWord> InferTaskHelper::buildWords(const InferInputBase &input, bool u
             bool reachLast = false;
             while (notes.at(noteIndex + 1).isSlur) {
                 const auto &nextNote = notes.at(noteIndex + 1);
-                noteBuffer.append(
-                    {nextNote.key, 0, timeline.tickToSec(nextNote.length), nextNote.isRest});
-                wordLen += timeline.tickToSec(nextNote.start + nextNote.length) -
-                           timeline.tickToSec(nextNote.start);
+                const auto nextNoteLen = timeline.tickLengthToSec(nextNote.start, nextNote.length);
+                noteBuffer.append({nextNote.key, 0, nextNoteLen, nextNote.isRest});
+                wordLen += nextNoteLen;
                 noteIndex++;
                 if (noteIndex == notes.size() - 1) { // 查找找到了最后一个音符
                     reachLast = true;
@@ -129,4 +130,55 @@ QList<InferWord> InferTaskHelper::buildWords(const InferInputBase &input, bool u
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+double InferTaskHelper::inputLengthMs(const InferInputBase &input) {
+    if (input.notes.isEmpty())
+        return 0;
+    const auto &first = input.notes.first();
+    const auto &last = input.notes.last();
+    const auto &timeline = input.timeline;
+    return timeline.tickToMs(last.start + last.length) - timeline.tickToMs(first.start) +
+           input.paddingStartMs + input.paddingEndMs;
+}
+
+double InferTaskHelper::startSec(const InferInputBase &input) {
+    if (input.notes.isEmpty())
+        return 0;
+    return input.timeline.tickToSec(input.notes.first().start) - input.paddingStartMs / 1000.0;
+}
+
+QList<double> InferTaskHelper::frameTicks(const InferInputBase &input, const double frameSec,
+                                          const double lengthTicks) {
+    const auto &timeline = input.timeline;
+    const auto startMs = startSec(input) * 1000;
+    const auto startTick = timeline.msToTick(startMs);
+    const auto lengthMs = timeline.tickToMs(startTick + lengthTicks) - startMs;
+    const auto count = qMax<qsizetype>(0, qCeil(lengthMs / (frameSec * 1000)));
+    QList<double> ms(count);
+    for (qsizetype i = 0; i < count; i++)
+        ms[i] = startMs + static_cast<double>(i) * frameSec * 1000;
+    QList<double> ticks(count);
+    timeline.msToTick(std::span(ms.constData(), ms.size()), std::span(ticks.data(), ticks.size()));
+    for (auto &tick : ticks)
+        tick -= startTick;
+    return ticks;
+}
+
+QList<double> InferTaskHelper::sampleSecs(const InferInputBase &input, const int tickInterval,
+                                          const double lengthSec) {
+    const auto &timeline = input.timeline;
+    const auto start = startSec(input);
+    const auto startTick = timeline.secToTick(start);
+    const auto lengthTicks = timeline.secToTick(start + lengthSec) - startTick;
+    const auto count = qMax<qsizetype>(0, qCeil(lengthTicks / tickInterval));
+    QList<double> ticks(count);
+    for (qsizetype i = 0; i < count; i++)
+        ticks[i] = startTick + static_cast<double>(i * tickInterval);
+    QList<double> secs(count);
+    timeline.tickToMs(std::span(ticks.constData(), ticks.size()),
+                      std::span(secs.data(), secs.size()));
+    for (auto &sec : secs)
+        sec = sec / 1000 - start;
+    return secs;
+}
@@ -13,6 +13,18 @@ class InferWord;
 class InferTaskHelper {
 public:
     static QList<InferWord> buildWords(const InferInputBase &input, bool useOffsetInfo = false);
+    // Length of the audio covered by the input notes, including paddings
+    static double inputLengthMs(const InferInputBase &input);
+    // Time of the first inference frame on the timeline, the start of the padding
+    static double startSec(const InferInputBase &input);
+    // Ticks from startSec of frames taken every frameSec seconds over lengthTicks, to resample
+    // tick curves onto frames through the tempo map
+    static QList<double> frameTicks(const InferInputBase &input, double frameSec,
+                                    double lengthTicks);
+    // Seconds from startSec of samples taken every tickInterval ticks over lengthSec, to resample
+    // frame curves back onto ticks
+    static QList<double> sampleSecs(const InferInputBase &input, int tickInterval,
+                                    double lengthSec);
 };
 
 #endif // INFERTASKHELPER_H
@@ -0,0 +1,174 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "VocoderSessionPool.h"
+
+#include "InferenceLoader.h"
+#include "Utils/StringUtils.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+class VocoderSessionPool::Lease::Data {
+public:
+    Data(QString hash, const quint64 generation, srt::NO<srt::Inference> session)
+        : hash(std::move(hash)), generation(generation), session(std::move(session)) {
+    }
+
+    ~Data() {
+        // Sessions without a hash can not be shared
+        if (!hash.isEmpty())
+            vocoderSessionPool->release(hash, generation, std::move(session));
+    }
+
+    Q_DISABLE_COPY_MOVE(Data)
+
+    QString hash;
+    quint64 generation;
+    srt::NO<srt::Inference> session;
+};
+
+const srt::NO<srt::Inference> &VocoderSessionPool::Lease::session() const {
+    static const srt::NO<srt::Inference> null;
+    return m_data ? m_data->session : null;
+}
+
+QString VocoderSessionPool::Lease::contentHash() const {
+    return m_data ? m_data->hash : QString();
+}
+
+VocoderSessionPool::VocoderSessionPool() = default;
+
+VocoderSessionPool::~VocoderSessionPool() = default;
+
+LITE_SINGLETON_IMPLEMENT_INSTANCE(VocoderSessionPool)
+
+auto VocoderSessionPool::acquire(const InferenceLoader &loader) -> Result {
+    const auto hash = contentHash(loader);
+    quint64 generation = 0;
+    if (!hash.isEmpty()) {
+        QMutexLocker locker(&m_mutex);
+        generation = m_generation;
+        if (auto it = m_idleSessions.find(hash); it != m_idleSessions.end() && !it->isEmpty()) {
+            Lease lease;
+            lease.m_data = std::make_shared<Lease::Data>(hash, generation, it->takeLast());
+            return lease;
+        }
+    }
+
+    // Created outside the lock, loading a model takes a while
+    auto exp = loader.createVocoder();
+    if (!exp)
+        return exp.getError();
+    qDebug() << "Created vocoder session for" << loader.singerIdentifier() << "hash:" << hash;
+    Lease lease;
+    lease.m_data = std::make_shared<Lease::Data>(hash, generation, std::move(exp.get()));
+    return lease;
+}
+
+void VocoderSessionPool::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_idleSessions.clear();
+    m_generation++;
+}
+
+int VocoderSessionPool::idleSessionCount() const {
+    QMutexLocker locker(&m_mutex);
+    int count = 0;
+    for (const auto &sessions : m_idleSessions)
+        count += static_cast<int>(sessions.count());
+    return count;
+}
+
+QStringList VocoderSessionPool::vocoderFiles(const srt::InferenceSpec &spec) {
+    const QFileInfo specInfo(StringUtils::path_to_qstr(spec.path()));
+    const QDir dir(specInfo.isDir() ? specInfo.absoluteFilePath() : specInfo.absolutePath());
+
+    // The model and config files the vocoder manifest names, e.g. "model": "vocoder.onnx"
+    QStringList files;
+    if (specInfo.isFile())
+        files.append(specInfo.absoluteFilePath());
+    const auto &configuration = spec.manifestConfiguration();
+    for (auto it = configuration.begin(); it != configuration.end(); ++it) {
+        if (!it->second.isString())
+            continue;
+        const QFileInfo info(dir.absoluteFilePath(QString::fromUtf8(it->second.toString())));
+        if (info.isFile())
+            files.append(info.absoluteFilePath());
+    }
+
+    // Manifests without file references: only the files next to the spec, other models of the
+    // package usually live in sub directories
+    if (files.isEmpty()) {
+        for (const auto &info : dir.entryInfoList(QDir::Files))
+            files.append(info.absoluteFilePath());
+    }
+
+    // Sorted, so that the hash does not depend on the order of the manifest entries
+    files.sort();
+    files.removeDuplicates();
+    return files;
+}
+
+QString VocoderSessionPool::contentHash(const InferenceLoader &loader) {
+    const auto spec = loader.specs().vocoder;
+    if (!spec)
+        return {};
+    const auto key = StringUtils::path_to_qstr(spec->path());
+
+    QStringList files;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const auto cached = m_hashCache.constFind(key); cached != m_hashCache.constEnd())
+            files = cached->files;
+    }
+    if (files.isEmpty())
+        files = vocoderFiles(*spec);
+    if (files.isEmpty())
+        return {};
+
+    QList<FileStamp> stamps;
+    stamps.reserve(files.size());
+    for (const auto &path : std::as_const(files)) {
+        const QFileInfo info(path);
+        stamps.append({info.size(), info.lastModified()});
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (const auto cached = m_hashCache.constFind(key);
+            cached != m_hashCache.constEnd() && cached->stamps == stamps)
+            return cached->hash;
+    }
+
+    // The file names are included, so that a renamed model changes the hash
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto &path : std::as_const(files)) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Failed to read vocoder file" << path;
+            return {};
+        }
+        hash.addData(QFileInfo(path).fileName().toUtf8());
+        hash.addData(&file);
+    }
+    const auto result = QString::fromLatin1(hash.result().toHex());
+
+    QMutexLocker locker(&m_mutex);
+    m_hashCache.insert(key, {files, stamps, result});
+    return result;
+}
+
+void VocoderSessionPool::release(const QString &hash, const quint64 generation,
+                                 srt::NO<srt::Inference> session) {
+    if (!session)
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (generation != m_generation)
+        return;
+    m_idleSessions[hash].append(std::move(session));
+}
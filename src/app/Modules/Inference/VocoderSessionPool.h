@@ -0,0 +1,91 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef VOCODERSESSIONPOOL_H
+#define VOCODERSESSIONPOOL_H
+
+#define vocoderSessionPool VocoderSessionPool::instance()
+
+#include "Utils/Expected.h"
+#include "Utils/Singleton.h"
+
+#include <memory>
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <synthrt/SVS/Inference.h>
+#include <synthrt/SVS/InferenceContrib.h>
+
+class InferenceLoader;
+
+// Many voicebanks ship the same vocoder. Vocoder sessions are pooled by the content hash of the
+// vocoder model files instead of by singer, so singers sharing a vocoder share its resident
+// sessions. A session is used by one task at a time; idle sessions stay loaded until clear().
+class VocoderSessionPool {
+private:
+    VocoderSessionPool();
+    ~VocoderSessionPool();
+
+public:
+    LITE_SINGLETON_DECLARE_INSTANCE(VocoderSessionPool)
+    Q_DISABLE_COPY_MOVE(VocoderSessionPool)
+
+    // A borrowed session. It goes back to the pool when the last copy is destroyed.
+    class Lease {
+    public:
+        Lease() = default;
+        [[nodiscard]] const srt::NO<srt::Inference> &session() const;
+        [[nodiscard]] QString contentHash() const;
+
+    private:
+        friend class VocoderSessionPool;
+        class Data;
+        std::shared_ptr<Data> m_data;
+    };
+
+    using Result = Expected<Lease, QString>;
+
+    // Thread-safe. Reuses an idle session with the same content hash, or creates one with loader.
+    [[nodiscard]] Result acquire(const InferenceLoader &loader);
+    // Releases all idle sessions. Leased sessions are released when they come back.
+    void clear();
+    [[nodiscard]] int idleSessionCount() const;
+
+    // Hash of the vocoder model and config files. Returns an empty string if they can not be read
+    [[nodiscard]] QString contentHash(const InferenceLoader &loader);
+
+private:
+    class FileStamp {
+    public:
+        qint64 size = 0;
+        QDateTime lastModified;
+
+        bool operator==(const FileStamp &other) const {
+            return size == other.size && lastModified == other.lastModified;
+        }
+    };
+
+    class CachedHash {
+    public:
+        QStringList files;
+        QList<FileStamp> stamps; // Of files, the hash is recomputed when one changes
+        QString hash;
+    };
+
+    // The vocoder config and model files, not the other models of the package
+    static QStringList vocoderFiles(const srt::InferenceSpec &spec);
+
+    void release(const QString &hash, quint64 generation, srt::NO<srt::Inference> session);
+
+    mutable QMutex m_mutex;
+    QHash<QString, QList<srt::NO<srt::Inference>>> m_idleSessions;
+    quint64 m_generation = 0; // Sessions leased before clear() are dropped when released
+    QHash<QString, CachedHash> m_hashCache; // By vocoder spec path
+};
+
+#endif // VOCODERSESSIONPOOL_H
@@ -96,9 +96,7 @@ bool AProjectConverter::load(const QString &path, AppModel *model, QString &errM
                 singingClip->setLength(objClip.value("dur").toInt());
                 singingClip->setClipLen(objClip.value("clipDur").toInt());
                 auto arrNotes = objClip.value("notes").toArray();
-                auto notes = decodeNotes(arrNotes);
-                for (const auto &note : notes)
-                    singingClip->insertNote(note);
+                singingClip->insertNotes(decodeNotes(arrNotes));
                 dsTack->insertClip(singingClip);
             } else if (type == "audio") {
                 const auto audioClip = new AudioClip;
@@ -6,10 +6,23 @@
 
 #include "Model/AppModel/AnchorCurve.h"
 #include "Model/AppModel/AudioClip.h"
+#include "Model/AppOptions/AppOptions.h"
 #include "Model/AppStatus/AppStatus.h"
+#include "Utils/PackedCurveCodec.h"
 
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonObject>
 #include <QMessageBox>
 
+#include <filesystem>
+
+#ifdef Q_OS_WIN
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
 #include "opendspx/qdspxmodel.h"
 #include "Model/AppModel/Track.h"
 
@@ -19,17 +32,47 @@
 #include "Model/AppModel/DrawCurve.h"
 #include "Model/AppModel/SingingClip.h"
 
+// Clip workspace entry holding the packed values of dense free curves, keyed by packedCurveKey()
+static const QString packedCurvesKey = "diffscope.packedCurves";
+// Free curves with fewer values are always saved as plain JSON numbers
+static constexpr qsizetype packedCurveMinValues = 256;
+
+static QString packedCurveKey(const QString &paramName, const QString &type,
+                              const qsizetype index) {
+    return QString("%1.%2.%3").arg(paramName, type).arg(index);
+}
+
 bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &errMsg,
                                 ImportMode mode) {
-    auto decodeCurves = [&](const QList<QDspx::ParamCurveRef> &dspxCurveRefs, const int offset) {
+    // Values of packed curves are only checked for their count here, and decoded by the curve
+    // on first access
+    auto decodePackedValues = [](DrawCurve *curve, const QJsonObject &packed) {
+        const auto count = packed.value("count").toInteger();
+        const auto data = QByteArray::fromBase64Encoding(
+            packed.value("data").toString().toLatin1(), QByteArray::AbortOnBase64DecodingErrors);
+        if (!data || PackedCurveCodec::countValues(*data) != count) {
+            qCritical() << "Failed to decode packed curve values";
+            return;
+        }
+        curve->setPackedValues(*data, static_cast<int>(count));
+    };
+
+    auto decodeCurves = [&](const QList<QDspx::ParamCurveRef> &dspxCurveRefs, const int offset,
+                            const QJsonObject &packedCurves, const QString &paramName,
+                            const QString &type) {
         QVector<Curve *> curves;
-        for (const QDspx::ParamCurveRef &dspxCurveRef : dspxCurveRefs) {
+        for (qsizetype i = 0; i < dspxCurveRefs.count(); i++) {
+            const QDspx::ParamCurveRef &dspxCurveRef = dspxCurveRefs.at(i);
             if (dspxCurveRef->type == QDspx::ParamCurve::Type::Free) {
                 const auto castCurveRef = dspxCurveRef.dynamicCast<QDspx::ParamFree>();
                 const auto curve = new DrawCurve;
                 curve->setLocalStart(castCurveRef->start - offset);
                 curve->step = castCurveRef->step;
-                curve->setValues(castCurveRef->values);
+                const auto packed = packedCurves.value(packedCurveKey(paramName, type, i));
+                if (castCurveRef->values.isEmpty() && packed.isObject())
+                    decodePackedValues(curve, packed.toObject());
+                else
+                    curve->setValues(castCurveRef->values);
                 curves.append(curve);
             } else if (dspxCurveRef->type == QDspx::ParamCurve::Type::Anchor) {
                 const auto castCurveRef = dspxCurveRef.dynamicCast<QDspx::ParamAnchor>();
@@ -54,26 +97,34 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
     };
 
     auto decodeSingingParam = [&](const QDspx::ParamInfo &dspxParam, const int offset,
-                                  SingingClip *clip) {
+                                  SingingClip *clip, const QJsonObject &packedCurves,
+                                  const QString &name) {
         Param param;
-        param.setCurves(Param::Original, decodeCurves(dspxParam.org, offset), clip);
-        param.setCurves(Param::Edited, decodeCurves(dspxParam.edited, offset), clip);
-        param.setCurves(Param::Envelope, decodeCurves(dspxParam.envelope, offset), clip);
+        param.setCurves(Param::Original,
+                        decodeCurves(dspxParam.org, offset, packedCurves, name, "org"), clip);
+        param.setCurves(Param::Edited,
+                        decodeCurves(dspxParam.edited, offset, packedCurves, name, "edited"),
+                        clip);
+        param.setCurves(Param::Envelope,
+                        decodeCurves(dspxParam.envelope, offset, packedCurves, name, "envelope"),
+                        clip);
         return param;
     };
 
     auto decodeSingingParams = [&](const QDspx::SingleParam &dspxParams, const int offset,
-                                   SingingClip *clip) {
+                                   SingingClip *clip, const QJsonObject &packed) {
         ParamInfo params(clip);
-        params.pitch = std::move(decodeSingingParam(dspxParams.pitch, offset, clip));
-        params.expressiveness =
-            std::move(decodeSingingParam(dspxParams.expressiveness, offset, clip));
-        params.energy = std::move(decodeSingingParam(dspxParams.energy, offset, clip));
-        params.breathiness = std::move(decodeSingingParam(dspxParams.breathiness, offset, clip));
-        params.voicing = std::move(decodeSingingParam(dspxParams.voicing, offset, clip));
-        params.tension = std::move(decodeSingingParam(dspxParams.tension, offset, clip));
-        params.gender = std::move(decodeSingingParam(dspxParams.gender, offset, clip));
-        params.velocity = std::move(decodeSingingParam(dspxParams.velocity, offset, clip));
+        params.pitch = decodeSingingParam(dspxParams.pitch, offset, clip, packed, "pitch");
+        params.expressiveness = decodeSingingParam(dspxParams.expressiveness, offset, clip,
+                                                   packed, "expressiveness");
+        params.energy = decodeSingingParam(dspxParams.energy, offset, clip, packed, "energy");
+        params.breathiness =
+            decodeSingingParam(dspxParams.breathiness, offset, clip, packed, "breathiness");
+        params.voicing = decodeSingingParam(dspxParams.voicing, offset, clip, packed, "voicing");
+        params.tension = decodeSingingParam(dspxParams.tension, offset, clip, packed, "tension");
+        params.gender = decodeSingingParam(dspxParams.gender, offset, clip, packed, "gender");
+        params.velocity =
+            decodeSingingParam(dspxParams.velocity, offset, clip, packed, "velocity");
         return params;
     };
 
@@ -109,8 +160,11 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
         }
         return notes;
     };
-    auto decodeClips = [&](const QList<QDspx::ClipRef> &dspxClips, Track *track) {
-        for (const auto &dspxClip : dspxClips) {
+    // Clips are taken out of the parsed document one by one, so the parsed data of a clip is freed
+    // as soon as its model is built instead of living alongside the whole model
+    auto decodeClips = [&](QList<QDspx::ClipRef> &dspxClips, Track *track) {
+        while (!dspxClips.isEmpty()) {
+            const auto dspxClip = dspxClips.takeFirst();
             if (dspxClip->type == QDspx::Clip::Type::Singing) {
                 const auto castClip = dspxClip.dynamicCast<QDspx::SingingClip>();
                 const auto clip = new SingingClip;
@@ -122,12 +176,12 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
                 clip->setClipLen(castClip->time.clipLen);
                 clip->setGain(castClip->control.gain);
                 clip->setMute(castClip->control.mute);
-                auto notes = decodeNotes(castClip->notes, castClip->time.start);
-                for (const auto &note : notes)
-                    clip->insertNote(note);
-                clip->params =
-                    std::move(decodeSingingParams(castClip->params, castClip->time.start, clip));
-                clip->workspace() = castClip->workspace;
+                clip->insertNotes(decodeNotes(castClip->notes, castClip->time.start));
+                auto workspace = castClip->workspace;
+                const auto packedCurves = workspace.take(packedCurvesKey);
+                clip->params = decodeSingingParams(castClip->params, castClip->time.start, clip,
+                                                   packedCurves);
+                clip->workspace() = workspace;
                 track->insertClip(clip);
             } else if (dspxClip->type == QDspx::Clip::Type::Audio) {
                 const auto castClip = dspxClip.dynamicCast<QDspx::AudioClip>();
@@ -146,9 +200,10 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
         }
     };
 
-    auto decodeTracks = [&](const QList<QDspx::Track> &dspxTracks, AppModel *model) {
+    auto decodeTracks = [&](QList<QDspx::Track> &dspxTracks, AppModel *model) {
         int i = 0;
-        for (const auto &dspxTrack : dspxTracks) {
+        while (!dspxTracks.isEmpty()) {
+            auto dspxTrack = dspxTracks.takeFirst();
             const auto track = new Track;
             auto trackControl = TrackControl();
             trackControl.setGain(dspxTrack.control.gain);
@@ -169,7 +224,12 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
     if (returnCode.type == QDspx::Result::Success) {
         // dspxModel.content.global.centShift
         // TODO: where should I use centShift in the editor?
-        const auto timeline = dspxModel.content.timeline;
+        const auto &timeline = dspxModel.content.timeline;
+        // AppModel keeps a single tempo and time signature for now
+        if (timeline.tempos.count() > 1 || timeline.timeSignatures.count() > 1)
+            qWarning() << "Only the first tempo and time signature are loaded, tempos:"
+                       << timeline.tempos.count()
+                       << "time signatures:" << timeline.timeSignatures.count();
         model->setTimeSignature(
             TimeSignature(timeline.timeSignatures[0].num, timeline.timeSignatures[0].den));
         model->setTempo(timeline.tempos[0].value);
@@ -196,17 +256,34 @@ bool DspxProjectConverter::load(const QString &path, AppModel *model, QString &e
 }
 
 bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &errMsg) {
+    auto snapshot = takeSnapshot(model);
+    if (!writeSnapshot(snapshot, path, errMsg)) {
+        QMessageBox::warning(nullptr, "Warning", errMsg);
+        return false;
+    }
+    return true;
+}
+
+DspxProjectConverter::Snapshot DspxProjectConverter::takeSnapshot(const AppModel *model) {
+    Snapshot snapshot;
+    snapshot.m_packDenseCurves = appOptions->general()->packDenseCurves;
 
-    auto encodeCurves = [&](const QList<Curve *> &dsCurves, QList<QDspx::ParamCurveRef> &curves) {
-        for (const auto &dsCurve : dsCurves) {
+    // Free curves are copied as is and encoded later by encodeFreeCurves()
+    auto encodeCurves = [&](const QList<Curve *> &dsCurves, QList<QDspx::ParamCurveRef> &curves,
+                            Snapshot::ClipCurves &freeCurves, const QString &paramName,
+                            const QString &type) {
+        for (qsizetype i = 0; i < dsCurves.count(); i++) {
+            const auto dsCurve = dsCurves.at(i);
             if (dsCurve->type() == Curve::CurveType::Draw) {
                 const auto castCurve = dynamic_cast<DrawCurve *>(dsCurve);
                 const auto curve = QDspx::ParamFreeRef::create();
                 curve->start = castCurve->globalStart();
                 curve->step = castCurve->step;
-                for (const auto v : castCurve->values()) {
-                    curve->values.append(v);
-                }
+                Snapshot::FreeCurve freeCurve{curve, packedCurveKey(paramName, type, i),
+                                              *castCurve};
+                // The copy is only read on the saving thread, it must not reference the clip
+                freeCurve.curve.setClip(nullptr);
+                freeCurves.curves.append(freeCurve);
                 curves.append(curve);
             } else if (dsCurve->type() == Curve::CurveType::Anchor) {
                 const auto castCurve = dynamic_cast<AnchorCurve *>(dsCurve);
@@ -232,21 +309,25 @@ bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &e
         }
     };
 
-    auto encodeSingingParam = [&](const Param &dsParam, QDspx::ParamInfo &param) {
-        encodeCurves(dsParam.curves(Param::Original), param.org);
-        encodeCurves(dsParam.curves(Param::Edited), param.edited);
-        encodeCurves(dsParam.curves(Param::Envelope), param.envelope);
+    auto encodeSingingParam = [&](const Param &dsParam, QDspx::ParamInfo &param,
+                                  Snapshot::ClipCurves &freeCurves, const QString &name) {
+        encodeCurves(dsParam.curves(Param::Original), param.org, freeCurves, name, "org");
+        encodeCurves(dsParam.curves(Param::Edited), param.edited, freeCurves, name, "edited");
+        encodeCurves(dsParam.curves(Param::Envelope), param.envelope, freeCurves, name,
+                     "envelope");
     };
 
-    auto encodeSingingParams = [&](const ParamInfo &dsParams, QDspx::SingleParam &params) {
-        encodeSingingParam(dsParams.pitch, params.pitch);
-        encodeSingingParam(dsParams.expressiveness, params.expressiveness);
-        encodeSingingParam(dsParams.energy, params.energy);
-        encodeSingingParam(dsParams.breathiness, params.breathiness);
-        encodeSingingParam(dsParams.voicing, params.voicing);
-        encodeSingingParam(dsParams.tension, params.tension);
-        encodeSingingParam(dsParams.gender, params.gender);
-        encodeSingingParam(dsParams.velocity, params.velocity);
+    auto encodeSingingParams = [&](const ParamInfo &dsParams, QDspx::SingleParam &params,
+                                   Snapshot::ClipCurves &freeCurves) {
+        encodeSingingParam(dsParams.pitch, params.pitch, freeCurves, "pitch");
+        encodeSingingParam(dsParams.expressiveness, params.expressiveness, freeCurves,
+                           "expressiveness");
+        encodeSingingParam(dsParams.energy, params.energy, freeCurves, "energy");
+        encodeSingingParam(dsParams.breathiness, params.breathiness, freeCurves, "breathiness");
+        encodeSingingParam(dsParams.voicing, params.voicing, freeCurves, "voicing");
+        encodeSingingParam(dsParams.tension, params.tension, freeCurves, "tension");
+        encodeSingingParam(dsParams.gender, params.gender, freeCurves, "gender");
+        encodeSingingParam(dsParams.velocity, params.velocity, freeCurves, "velocity");
     };
 
     // auto encodePhonemes = [&](const QList<Phoneme> &dsPhonemes, QList<QDspx::Phoneme> &phonemes)
@@ -266,7 +347,7 @@ bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &e
     //     }
     // };
 
-    auto encodeNotes = [&](const OverlappableSerialList<Note> &dsNotes, QList<QDspx::Note> &notes) {
+    auto encodeNotes = [&](const FlatOverlappableList<Note> &dsNotes, QList<QDspx::Note> &notes) {
         for (const auto dsNote : dsNotes) {
             QDspx::Note note;
             note.pos = dsNote->globalStart();
@@ -299,7 +380,10 @@ bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &e
                 singClip->control.mute = clip->mute();
                 singClip->workspace = clip->workspace();
                 encodeNotes(singingClip->notes(), singClip->notes);
-                encodeSingingParams(singingClip->params, singClip->params);
+                Snapshot::ClipCurves freeCurves{singClip, {}};
+                encodeSingingParams(singingClip->params, singClip->params, freeCurves);
+                if (!freeCurves.curves.isEmpty())
+                    snapshot.m_freeCurves.append(freeCurves);
                 track.clips.append(singClip);
             } else if (clip->clipType() == Clip::Audio) {
                 const auto audioClip = dynamic_cast<AudioClip *>(clip);
@@ -333,7 +417,7 @@ bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &e
         }
     };
 
-    QDspx::Model dspxModel;
+    auto &dspxModel = snapshot.model;
     dspxModel.content.global.centShift = 0; // TODO: where should I use centShift in the editor?
     auto &timeline = dspxModel.content.timeline;
     timeline.tempos.append(QDspx::Tempo(0, model->tempo()));
@@ -345,16 +429,71 @@ bool DspxProjectConverter::save(const QString &path, AppModel *model, QString &e
     // Save loop settings to workspace
     const auto loopSettings = appStatus->loopSettings.get();
     dspxModel.content.workspace["loop"] = loopSettings.serialize();
+    return snapshot;
+}
 
-    const auto returnCode = dspxModel.save(path);
+void DspxProjectConverter::encodeFreeCurves(Snapshot &snapshot) {
+    // Dense free curves may be packed into the clip workspace, leaving the curve without values.
+    // Curves still packed since loading are written back without being decoded.
+    for (auto &clipCurves : snapshot.m_freeCurves) {
+        QJsonObject packedCurves;
+        for (auto &freeCurve : clipCurves.curves) {
+            const auto &curve = freeCurve.curve;
+            if (snapshot.m_packDenseCurves && curve.valueCount() >= packedCurveMinValues) {
+                const auto packed = curve.packedValues().isNull()
+                                        ? PackedCurveCodec::pack(curve.values())
+                                        : curve.packedValues();
+                const QJsonObject packedCurve{
+                    {"count", curve.valueCount()                   },
+                    {"data",  QString::fromLatin1(packed.toBase64())}
+                };
+                packedCurves.insert(freeCurve.packedKey, packedCurve);
+            } else
+                freeCurve.ref->values = curve.values();
+        }
+        if (!packedCurves.isEmpty())
+            clipCurves.clip->workspace.insert(packedCurvesKey, packedCurves);
+    }
+    snapshot.m_freeCurves.clear();
+}
+
+// Makes sure the data of the file is on disk before it replaces the previous file
+static bool flushToDisk(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
 
+bool DspxProjectConverter::writeSnapshot(Snapshot &snapshot, const QString &path,
+                                         QString &errMsg) {
+    encodeFreeCurves(snapshot);
+    // Written next to the project first: a failed or interrupted save leaves the previous file
+    // intact, and the rename replaces it atomically.
+    const auto tempPath = path + ".saving";
+    const auto returnCode = snapshot.model.save(tempPath);
     if (returnCode.type != QDspx::Result::Success) {
-        QMessageBox::warning(
-            nullptr, "Warning",
-            QString("Failed to save project file.\r\npath: %1\r\ntype: %2 code: %3")
-                .arg(path)
-                .arg(returnCode.type)
-                .arg(returnCode.code));
+        QFile::remove(tempPath);
+        errMsg = QString("Failed to save project file.\r\npath: %1\r\ntype: %2 code: %3")
+                     .arg(path)
+                     .arg(returnCode.type)
+                     .arg(returnCode.code);
+        return false;
+    }
+    if (!flushToDisk(tempPath))
+        qWarning() << "Failed to flush project file to disk:" << tempPath;
+
+    std::error_code error;
+    std::filesystem::rename(QFileInfo(tempPath).filesystemAbsoluteFilePath(),
+                            QFileInfo(path).filesystemAbsoluteFilePath(), error);
+    if (error) {
+        QFile::remove(tempPath);
+        errMsg = QString("Failed to replace project file.\r\npath: %1\r\n%2")
+                     .arg(path, QString::fromStdString(error.message()));
         return false;
     }
     return true;
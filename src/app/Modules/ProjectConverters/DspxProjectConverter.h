@@ -6,6 +6,9 @@
 #define DSPXPROJECTCONVERTER_H
 
 #include "IProjectConverter.h"
+#include "Model/AppModel/DrawCurve.h"
+
+#include "opendspx/qdspxmodel.h"
 
 using ImportMode = IProjectConverter::ImportMode;
 
@@ -13,6 +16,40 @@ class DspxProjectConverter final : public IProjectConverter {
 public:
     bool load(const QString &path, AppModel *model, QString &errMsg, ImportMode mode) override;
     bool save(const QString &dsParam, AppModel *phonemes, QString &errMsg) override;
+
+    // Project copied on the GUI thread. Free curves are kept as copies sharing their value chunks
+    // with the model, and are only flattened or packed by writeSnapshot().
+    class Snapshot {
+    public:
+        QDspx::Model model;
+
+    private:
+        friend class DspxProjectConverter;
+
+        class FreeCurve {
+        public:
+            QDspx::ParamFreeRef ref;
+            QString packedKey;
+            DrawCurve curve;
+        };
+
+        class ClipCurves {
+        public:
+            QDspx::SingingClipRef clip;
+            QList<FreeCurve> curves;
+        };
+
+        QList<ClipCurves> m_freeCurves;
+        bool m_packDenseCurves = false;
+    };
+
+    // Copies the model into a self-contained snapshot, cheap enough for the GUI thread
+    static Snapshot takeSnapshot(const AppModel *model);
+    // Encodes the free curves and serializes the snapshot to path. Safe to call on any thread.
+    static bool writeSnapshot(Snapshot &snapshot, const QString &path, QString &errMsg);
+
+private:
+    static void encodeFreeCurves(Snapshot &snapshot);
 };
 
 #endif // DSPXPROJECTCONVERTER_H
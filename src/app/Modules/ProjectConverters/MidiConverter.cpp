@@ -88,10 +88,7 @@ void convertClips(const QDspx::Track &track, Track *dsTrack, const QString &lang
             singingClip->setClipLen(clip->time.clipLen + 960);
             singingClip->setDefaultLanguage(language);
 
-            auto notes = convertNotes(singClip->notes, singClip->time.start, language);
-            for (const auto note : notes) {
-                singingClip->insertNote(note);
-            }
+            singingClip->insertNotes(convertNotes(singClip->notes, singClip->time.start, language));
             dsTrack->insertClip(singingClip);
         } else if (clip->type == QDspx::Clip::Type::Audio) {
             const auto audioClip = new AudioClip;
@@ -117,7 +114,7 @@ void convertTracks(const QDspx::Model &dspx, AppModel *model, const QString &lan
     }
 }
 
-QList<QDspx::Note> encodeNotes(const OverlappableSerialList<Note> &notes) {
+QList<QDspx::Note> encodeNotes(const FlatOverlappableList<Note> &notes) {
     QList<QDspx::Note> arrNotes;
     for (const auto &note : notes) {
         QDspx::Note dsNote;
@@ -10,7 +10,8 @@
 
 #include <QDebug>
 
-SliceResult SingingClipSlicer::slice(const Timeline &timeline, const NoteList &source) {
+SliceResult SingingClipSlicer::slice(const Timeline &timeline, const NoteList &source,
+                                     const double previousTailEndMs) {
     // 切分选项
     auto headerLengthMax = SingingClipSlicerGlobal::headerAvailableLengthMax;
     auto padBaseLength = SingingClipSlicerGlobal::padBaseLength;
@@ -63,7 +64,7 @@ SliceResult SingingClipSlicer::slice(const Timeline &timeline, const NoteList &s
     };
 
     QList<Segment> segments;
-    double lastTailEndInMs = 0;
+    double lastTailEndInMs = previousTailEndMs;
 
     NoteList buffer;
     for (int i = 0; i < source.count(); i++) {
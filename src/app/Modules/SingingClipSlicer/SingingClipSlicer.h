@@ -13,7 +13,10 @@ class Timeline;
 namespace SingingClipSlicer {
     using NoteList = QList<Note *>;
 
-    SliceResult slice(const Timeline &timeline, const NoteList &source);
+    // previousTailEndMs is where the tail of the segment before source ends, when only a part of
+    // a clip is sliced. The head available length of the first segment is measured from it.
+    SliceResult slice(const Timeline &timeline, const NoteList &source,
+                      double previousTailEndMs = 0);
     // SliceResult simpleSlice(const NoteList &source, double threshold = 200);
 };
 
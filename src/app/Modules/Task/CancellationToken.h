@@ -0,0 +1,96 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef CANCELLATIONTOKEN_H
+#define CANCELLATIONTOKEN_H
+
+#include <atomic>
+#include <functional>
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+
+// Lets a task hand its blocking calls (e.g. a model session run) a way to be interrupted.
+// Callbacks registered before cancellation run on the cancelling thread as soon as cancel() is
+// called; callbacks registered afterwards run immediately, so no request is lost in between.
+// Callbacks run under the token's lock: once a Registration is destroyed its callback is neither
+// running nor will run, so it may capture locals by reference. Callbacks must be non-blocking.
+class CancellationToken {
+public:
+    // Keeps a callback registered for the lifetime of the object
+    class Registration {
+    public:
+        Registration(CancellationToken &token, std::function<void()> callback)
+            : m_token(token), m_id(token.addCallback(std::move(callback))) {
+        }
+
+        ~Registration() {
+            m_token.removeCallback(m_id);
+        }
+
+        Q_DISABLE_COPY_MOVE(Registration)
+
+    private:
+        CancellationToken &m_token;
+        int m_id;
+    };
+
+    CancellationToken() {
+        m_clock.start();
+    }
+
+    Q_DISABLE_COPY_MOVE(CancellationToken)
+
+    [[nodiscard]] bool isCancelled() const {
+        return m_cancelled.load(std::memory_order_acquire);
+    }
+
+    void cancel() {
+        QMutexLocker locker(&m_mutex);
+        if (m_cancelled.load(std::memory_order_relaxed))
+            return;
+        m_cancelledAtNs = m_clock.nsecsElapsed();
+        m_cancelled.store(true, std::memory_order_release);
+        for (const auto &callback : std::as_const(m_callbacks))
+            callback();
+        m_callbacks.clear();
+    }
+
+    // Returns the time since cancel() was called, or -1 if not cancelled
+    [[nodiscard]] qint64 nsecsSinceCancelled() const {
+        QMutexLocker locker(&m_mutex);
+        if (!m_cancelled.load(std::memory_order_relaxed))
+            return -1;
+        return m_clock.nsecsElapsed() - m_cancelledAtNs;
+    }
+
+private:
+    int addCallback(std::function<void()> callback) {
+        QMutexLocker locker(&m_mutex);
+        if (m_cancelled.load(std::memory_order_relaxed)) {
+            callback();
+            return -1;
+        }
+        const auto id = m_nextId++;
+        m_callbacks.insert(id, std::move(callback));
+        return id;
+    }
+
+    void removeCallback(const int id) {
+        if (id < 0)
+            return;
+        QMutexLocker locker(&m_mutex);
+        m_callbacks.remove(id);
+    }
+
+    std::atomic<bool> m_cancelled{false};
+    mutable QMutex m_mutex;
+    QMap<int, std::function<void()>> m_callbacks;
+    int m_nextId = 0;
+    QElapsedTimer m_clock;
+    qint64 m_cancelledAtNs = 0;
+};
+
+#endif // CANCELLATIONTOKEN_H
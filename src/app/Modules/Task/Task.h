@@ -13,6 +13,7 @@
 #include <QRunnable>
 #include <QReadWriteLock>
 
+#include "CancellationToken.h"
 #include "Global/TaskGlobal.h"
 #include "Utils/UniqueObject.h"
 
@@ -50,8 +51,10 @@ public:
     //     terminate();
     // };
 
+    // Must not block: it is called on the thread that cancels the task
     virtual void terminate() {
         setFlag(TaskAbortRequested);
+        m_cancellationToken.cancel();
     }
 
     [[nodiscard]] bool started() const {
@@ -66,6 +69,11 @@ public:
         return checkFlag(TaskAbortRequested);
     }
 
+    // Time from the terminate request until runTask() returned, or -1 if not terminated
+    [[nodiscard]] qint64 cancelLatencyNs() const {
+        return m_cancelLatencyNs.load(std::memory_order_acquire);
+    }
+
     int priority() const {
         return m_priority.load(std::memory_order_acquire);
     }
@@ -94,6 +102,16 @@ protected:
         return checkFlag(TaskAbortRequested);
     }
 
+    // Register the stop function of a blocking call here, so that terminate() interrupts it
+    CancellationToken &cancellationToken() {
+        return m_cancellationToken;
+    }
+
+    // Called on the worker thread when a terminated task returns from runTask()
+    virtual void onCancelLatencyMeasured(qint64 ns) {
+        Q_UNUSED(ns)
+    }
+
     std::atomic<int> m_priority{0};
 
 private:
@@ -125,6 +143,10 @@ private:
                                                     std::memory_order_acquire));
 
         runTask();
+        if (const auto latency = m_cancellationToken.nsecsSinceCancelled(); latency >= 0) {
+            m_cancelLatencyNs.store(latency, std::memory_order_release);
+            onCancelLatencyMeasured(latency);
+        }
         emit finished();
 
         setFlag(TaskStopped);
@@ -133,6 +155,8 @@ private:
     TaskStatus m_status;
     mutable QReadWriteLock m_statusLock;
     std::atomic<FlagType> m_taskFlags{0};
+    CancellationToken m_cancellationToken;
+    std::atomic<qint64> m_cancelLatencyNs{-1};
 };
 
 #endif // TASK_H
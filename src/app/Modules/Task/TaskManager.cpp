@@ -80,6 +80,11 @@ void TaskManager::removeTask(Task *task) {
         qWarning() << "Can not remove task: " << task->objectName();
 }
 
+bool TaskManager::tryTakeTask(Task *task) {
+    Q_D(TaskManager);
+    return d->threadPool->tryTake(task);
+}
+
 void TaskManager::startAllTasks() {
     Q_D(TaskManager);
     for (const auto &task : d->m_tasks)
@@ -41,6 +41,9 @@ public slots:
     void startTask(Task *task);
     void addAndStartTask(Task *task);
     void removeTask(Task *task);
+    // Removes a task that is started but still waiting for a thread. Returns false if it already
+    // runs, in which case it must be terminated instead.
+    bool tryTakeTask(Task *task);
     // void startTask(int taskId);
     void startAllTasks();
     static void terminateTask(Task *task);
@@ -16,37 +16,39 @@ template <typename T>
 class TaskQueue {
 public:
     Queue<T *> pending;
-    T *current = nullptr;
+    QList<T *> running;
 
     void add(T *task);
     void cancelAll();
     void cancelIf(std::function<bool(T *task)> pred);
     void disposePendingTasks();
-    void onCurrentFinished();
+    void onTaskFinished(T *task);
+
+    [[nodiscard]] int maxConcurrentTasks() const;
+    // Tasks beyond the limit wait in the pending queue. Defaults to 1 (strictly serial).
+    void setMaxConcurrentTasks(int count);
 
 private:
     void runNext();
     void disposePendingTask(T *task);
+
+    int m_maxConcurrentTasks = 1;
 };
 
 template <typename T>
 void TaskQueue<T>::add(T *task) {
     taskManager->addTask(task);
     pending.enqueue(task);
-    if (!current)
-        runNext();
+    runNext();
 }
 
 template <typename T>
 void TaskQueue<T>::runNext() {
-    current = nullptr;
-    if (pending.count() <= 0) {
-        // qWarning() << "Task queue is empty";
-        return;
+    while (running.count() < m_maxConcurrentTasks && pending.count() > 0) {
+        const auto task = pending.dequeue();
+        running.append(task);
+        taskManager->startTask(task);
     }
-    const auto task = pending.dequeue();
-    taskManager->startTask(task);
-    current = task;
 }
 
 template <typename T>
@@ -54,10 +56,10 @@ void TaskQueue<T>::cancelAll() {
     for (const auto task : pending) {
         disposePendingTask(task);
     }
-    if (current) {
-        taskManager->terminateTask(current);
-        qDebug() << "Terminate current task: "
-                 << "taskId:" << current->id();
+    for (const auto task : running) {
+        taskManager->terminateTask(task);
+        qDebug() << "Terminate running task: "
+                 << "taskId:" << task->id();
     }
 }
 
@@ -66,23 +68,29 @@ void TaskQueue<T>::cancelIf(std::function<bool(T *task)> pred) {
     for (const auto task : Linq::where(pending, pred)) {
         disposePendingTask(task);
     }
-    if (current && pred(current)) {
-        // Save current task to local variable for lambda capture
-        T *taskToCancel = current;
-        
+    const auto tasksToCancel = Linq::where(running, pred);
+    for (T *taskToCancel : tasksToCancel) {
+        running.removeOne(taskToCancel);
+        // Still queued in the thread pool: drop it without waiting for a worker thread
+        if (taskManager->tryTakeTask(taskToCancel)) {
+            qDebug() << "Take back unstarted task: taskId:" << taskToCancel->id();
+            taskManager->removeTask(taskToCancel);
+            taskToCancel->disconnect();
+            taskToCancel->deleteLater();
+            continue;
+        }
         // Connect task finished signal for safe cleanup
         QObject::connect(taskToCancel, &Task::finished, taskToCancel, [taskToCancel]() {
             qDebug() << "Cancelled task finished, safe cleanup: taskId:" << taskToCancel->id();
             taskManager->removeTask(taskToCancel);
             taskToCancel->deleteLater();
         }, Qt::QueuedConnection);
-        
-        taskManager->terminateTask(taskToCancel);
-        qDebug() << "Terminate current task and wait for cleanup: taskId:" << taskToCancel->id();
 
-        current = nullptr;
-        runNext();
+        taskManager->terminateTask(taskToCancel);
+        qDebug() << "Terminate running task and wait for cleanup: taskId:" << taskToCancel->id();
     }
+    if (!tasksToCancel.isEmpty())
+        runNext();
 }
 
 template <typename T>
@@ -92,15 +100,27 @@ void TaskQueue<T>::disposePendingTasks() {
 }
 
 template <typename T>
-void TaskQueue<T>::onCurrentFinished() {
-    current->disconnect();
-    taskManager->removeTask(current);
-    current = nullptr;
+void TaskQueue<T>::onTaskFinished(T *task) {
+    if (!running.removeOne(task))
+        qWarning() << "Finished task is not running: taskId:" << task->id();
+    task->disconnect();
+    taskManager->removeTask(task);
 
     // Automatically run the next task in the queue
     runNext();
 }
 
+template <typename T>
+int TaskQueue<T>::maxConcurrentTasks() const {
+    return m_maxConcurrentTasks;
+}
+
+template <typename T>
+void TaskQueue<T>::setMaxConcurrentTasks(const int count) {
+    m_maxConcurrentTasks = qMax(1, count);
+    runNext();
+}
+
 template <typename T>
 void TaskQueue<T>::disposePendingTask(T *task) {
     qDebug() << "Dispose pending task: "
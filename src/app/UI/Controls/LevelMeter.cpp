@@ -138,6 +138,13 @@ void LevelMeter::mousePressEvent(QMouseEvent *event) {
 }
 
 void LevelMeter::setValue(const double valueL, const double valueR) {
+    const auto lastPixelL = levelToDevicePixel(m_leftChannel.currentLevel);
+    const auto lastPixelR = levelToDevicePixel(m_rightChannel.currentLevel);
+    const auto lastPeakL = m_leftChannel.displayedPeak;
+    const auto lastPeakR = m_rightChannel.displayedPeak;
+    const auto lastClippedL = m_leftChannel.clipped;
+    const auto lastClippedR = m_rightChannel.clipped;
+
     m_leftChannel.currentLevel = VolumeUtils::dBToLinear(valueL);
     m_rightChannel.currentLevel = VolumeUtils::dBToLinear(valueR);
     auto clippedValueL = m_leftChannel.currentLevel;
@@ -155,7 +162,12 @@ void LevelMeter::setValue(const double valueL, const double valueR) {
     updatePeakValue(m_leftChannel, clippedValueL);
     updatePeakValue(m_rightChannel, clippedValueR);
 
-    update();
+    // Meters are fed at the display refresh rate, only repaint when a bar moves by a pixel
+    if (levelToDevicePixel(m_leftChannel.currentLevel) != lastPixelL ||
+        levelToDevicePixel(m_rightChannel.currentLevel) != lastPixelR ||
+        m_leftChannel.displayedPeak != lastPeakL || m_rightChannel.displayedPeak != lastPeakR ||
+        m_leftChannel.clipped != lastClippedL || m_rightChannel.clipped != lastClippedR)
+        update();
 }
 
 double LevelMeter::peakValue() const {
@@ -307,6 +319,12 @@ void LevelMeter::drawPeakHold(QPainter &painter, const QRectF &rect, double leve
     painter.drawLine({p1, p2});
 }
 
+int LevelMeter::levelToDevicePixel(const double level) const {
+    if (level > 1)
+        return -1; // Drawn as clipped
+    return qRound(level * channelLength * devicePixelRatioF());
+}
+
 void LevelMeter::startDecayAnimation(ChannelData &channel) {
     // qInfo() << "LevelMeter::startDecayAnimation";
     if (channel.displayedPeak <= 0.0)
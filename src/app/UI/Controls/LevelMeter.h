@@ -61,6 +61,7 @@ private:
     void drawSegmentedBar(QPainter &painter, const QRectF &rect, const double &level) const;
     void drawGradientBar(QPainter &painter, const QRectF &rect, const double &level) const;
     void drawPeakHold(QPainter &painter, const QRectF &rect, double level) const;
+    [[nodiscard]] int levelToDevicePixel(double level) const;
 
     static void startDecayAnimation(ChannelData &channel);
     void updatePeakValue(ChannelData &channel, double clippedValue);
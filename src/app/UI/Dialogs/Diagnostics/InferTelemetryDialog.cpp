@@ -0,0 +1,103 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "InferTelemetryDialog.h"
+
+#include "Modules/Inference/InferTelemetry.h"
+#include "UI/Controls/AccentButton.h"
+#include "UI/Controls/Toast.h"
+
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+InferTelemetryDialog::InferTelemetryDialog(QWidget *parent) : Dialog(parent) {
+    setWindowTitle(tr("Inference Diagnostics"));
+    setTitle(tr("Inference timing per stage"));
+    setMessage(tr("Latency statistics collected since launch. Values are in milliseconds."));
+    setMinimumSize(760, 480);
+
+    const QStringList headers = {tr("Stage"), tr("Phase"), tr("Count"), tr("Mean"),
+                                 tr("P50"),   tr("P95"),   tr("P99"),   tr("Max")};
+    m_table = new QTableWidget(InferTelemetry::StageCount * InferTelemetry::PhaseCount,
+                               static_cast<int>(headers.count()));
+    m_table->setHorizontalHeaderLabels(headers);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+    const auto layout = new QVBoxLayout;
+    layout->addWidget(m_table);
+    layout->setContentsMargins({});
+    body()->setLayout(layout);
+
+    const auto btnClose = new AccentButton(tr("Close"));
+    connect(btnClose, &Button::clicked, this, &Dialog::accept);
+    setPositiveButton(btnClose);
+
+    const auto btnExport = new Button(tr("Export..."));
+    connect(btnExport, &Button::clicked, this, &InferTelemetryDialog::onExport);
+    setNegativeButton(btnExport);
+
+    const auto btnReset = new Button(tr("Reset"));
+    connect(btnReset, &Button::clicked, this, &InferTelemetryDialog::onReset);
+    setNeutralButton(btnReset);
+
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &InferTelemetryDialog::refresh);
+    m_refreshTimer->start();
+    refresh();
+}
+
+void InferTelemetryDialog::refresh() const {
+    auto setCell = [this](const int row, const int column, const QString &text) {
+        auto item = m_table->item(row, column);
+        if (!item) {
+            item = new QTableWidgetItem;
+            m_table->setItem(row, column, item);
+        }
+        item->setText(text);
+    };
+    auto ms = [](const double value) { return QString::number(value, 'f', 2); };
+
+    int row = 0;
+    for (int s = 0; s < InferTelemetry::StageCount; s++) {
+        for (int p = 0; p < InferTelemetry::PhaseCount; p++) {
+            const auto stage = static_cast<InferTelemetry::Stage>(s);
+            const auto phase = static_cast<InferTelemetry::Phase>(p);
+            const auto snapshot = inferTelemetry->snapshot(stage, phase);
+            setCell(row, 0, InferTelemetry::stageName(stage));
+            setCell(row, 1, InferTelemetry::phaseName(phase));
+            setCell(row, 2, QString::number(snapshot.count));
+            setCell(row, 3, ms(snapshot.meanMs()));
+            setCell(row, 4, ms(snapshot.percentileMs(0.50)));
+            setCell(row, 5, ms(snapshot.percentileMs(0.95)));
+            setCell(row, 6, ms(snapshot.percentileMs(0.99)));
+            setCell(row, 7, ms(snapshot.maxMs()));
+            row++;
+        }
+    }
+}
+
+void InferTelemetryDialog::onReset() const {
+    inferTelemetry->reset();
+    refresh();
+}
+
+void InferTelemetryDialog::onExport() {
+    const auto path = QFileDialog::getSaveFileName(this, tr("Export inference telemetry"),
+                                                   InferTelemetry::defaultDumpPath(),
+                                                   tr("JSON Files (*.json)"));
+    if (path.isEmpty())
+        return;
+    if (inferTelemetry->dumpToFile(path))
+        Toast::show(tr("Telemetry exported"));
+    else
+        Toast::show(tr("Failed to export telemetry"));
+}
@@ -0,0 +1,29 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef INFERTELEMETRYDIALOG_H
+#define INFERTELEMETRYDIALOG_H
+
+#include "UI/Dialogs/Base/Dialog.h"
+
+class QTableWidget;
+class QTimer;
+
+class InferTelemetryDialog final : public Dialog {
+    Q_OBJECT
+
+public:
+    explicit InferTelemetryDialog(QWidget *parent = nullptr);
+
+private slots:
+    void refresh() const;
+    void onReset() const;
+    void onExport();
+
+private:
+    QTableWidget *m_table;
+    QTimer *m_refreshTimer;
+};
+
+#endif // INFERTELEMETRYDIALOG_H
@@ -27,6 +27,9 @@ void AppearancePage::modifyOption() {
     option->animationLevel =
         static_cast<AnimationGlobal::AnimationLevels>(m_cbxAnimationLevel->currentIndex());
     option->animationTimeScale = m_leAnimationTimeScale->text().toDouble();
+    option->showFrameTime = m_swShowFrameTime->value();
+    option->virtualizeNoteViews = m_swVirtualizeNoteViews->value();
+    option->smoothPlaybackFollow = m_swSmoothPlaybackFollow->value();
     appOptions->saveAndNotify(AppOptionsGlobal::Appearance);
 }
 
@@ -65,6 +68,26 @@ QWidget *AppearancePage::createContentWidget() {
     animationCard->addItem(tr("Level"), m_cbxAnimationLevel);
     animationCard->addItem(tr("Duration scale"), m_leAnimationTimeScale);
 
+    m_swShowFrameTime = new SwitchButton(option->showFrameTime);
+    connect(m_swShowFrameTime, &SwitchButton::toggled, this, &AppearancePage::modifyOption);
+
+    m_swVirtualizeNoteViews = new SwitchButton(option->virtualizeNoteViews);
+    connect(m_swVirtualizeNoteViews, &SwitchButton::toggled, this, &AppearancePage::modifyOption);
+
+    m_swSmoothPlaybackFollow = new SwitchButton(option->smoothPlaybackFollow);
+    connect(m_swSmoothPlaybackFollow, &SwitchButton::toggled, this, &AppearancePage::modifyOption);
+
+    const auto renderingCard = new OptionListCard(tr("Rendering"));
+    renderingCard->addItem(tr("Show frame time"),
+                           tr("Paint time and frame rate of the track and clip editors"),
+                           m_swShowFrameTime);
+    renderingCard->addItem(tr("Only create visible notes"),
+                           tr("Piano roll creates note items around the visible area only"),
+                           m_swVirtualizeNoteViews);
+    renderingCard->addItem(tr("Scroll smoothly with the playhead"),
+                           tr("Scroll continuously instead of by page while playing"),
+                           m_swSmoothPlaybackFollow);
+
 #if defined(WITH_DIRECT_MANIPULATION)
     const auto touchCard = new OptionListCard(tr("Touch"));
     m_swEnableDirectManipulation = new SwitchButton(option->enableDirectManipulation);
@@ -76,6 +99,7 @@ QWidget *AppearancePage::createContentWidget() {
     const auto mainLayout = new QVBoxLayout;
     mainLayout->addWidget(windowCard);
     mainLayout->addWidget(animationCard);
+    mainLayout->addWidget(renderingCard);
 #if defined(WITH_DIRECT_MANIPULATION)
     mainLayout->addWidget(touchCard);
 #endif
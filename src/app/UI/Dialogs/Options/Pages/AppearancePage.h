@@ -26,6 +26,9 @@ private:
     SwitchButton *m_swUseNativeFrame;
     ComboBox *m_cbxAnimationLevel;
     LineEdit *m_leAnimationTimeScale;
+    SwitchButton *m_swShowFrameTime;
+    SwitchButton *m_swVirtualizeNoteViews;
+    SwitchButton *m_swSmoothPlaybackFollow;
 #if defined(WITH_DIRECT_MANIPULATION)
     SwitchButton *m_swEnableDirectManipulation;
 #endif
@@ -5,6 +5,7 @@
 #include "GeneralPage.h"
 
 #include "Model/AppOptions/AppOptions.h"
+#include "Modules/History/HistoryManager.h"
 #include "UI/Controls/Button.h"
 #include "UI/Controls/CardView.h"
 #include "UI/Controls/DirSelector.h"
@@ -12,6 +13,8 @@
 #include "UI/Controls/LineEdit.h"
 #include "UI/Controls/OptionListCard.h"
 #include "UI/Controls/PathEditor.h"
+#include "UI/Controls/SeekBarSpinboxGroup.h"
+#include "UI/Controls/SwitchButton.h"
 #include "UI/Views/Common/LanguageComboBox.h"
 #include "Global/AppOptionsGlobal.h"
 
@@ -39,6 +42,10 @@ void GeneralPage::modifyOption() {
 
     option->somePath = m_fsSomePath->path();
     option->rmvpePath = m_fsRmvpePath->path();
+    option->historyMaxSteps = m_historyMaxSteps->spinbox->value();
+    option->historyMemoryLimitMb = m_historyMemoryLimit->spinbox->value();
+    option->packDenseCurves = m_swPackDenseCurves->value();
+    option->autoSaveIntervalMin = m_autoSaveInterval->spinbox->value();
     appOptions->saveAndNotify(AppOptionsGlobal::Option::General);
 }
 
@@ -136,11 +143,57 @@ QWidget *GeneralPage::createContentWidget() {
     modelCard->addItem(tr("Some Model Path"), m_fsSomePath);
     modelCard->addItem(tr("Rmvpe Model Path"), m_fsRmvpePath);
 
+    m_historyMaxSteps = new SeekBarSpinboxGroup(0, 10000, 100, option->historyMaxSteps);
+    m_historyMaxSteps->seekbar->setFixedWidth(256);
+    connect(m_historyMaxSteps, &SeekBarSpinboxGroup::editFinished, this,
+            &GeneralPage::modifyOption);
+
+    m_historyMemoryLimit = new SeekBarSpinboxGroup(0, 8192, 64, option->historyMemoryLimitMb);
+    m_historyMemoryLimit->seekbar->setFixedWidth(256);
+    connect(m_historyMemoryLimit, &SeekBarSpinboxGroup::editFinished, this,
+            &GeneralPage::modifyOption);
+
+    m_lbHistoryMemoryUsage = new QLabel;
+    const auto updateHistoryMemoryUsage = [this](const qsizetype bytes, const int stepCount) {
+        m_lbHistoryMemoryUsage->setText(tr("%1 MB in %2 steps")
+                                            .arg(static_cast<double>(bytes) / (1024 * 1024), 0,
+                                                 'f', 1)
+                                            .arg(stepCount));
+    };
+    updateHistoryMemoryUsage(historyManager->memoryUsage(), historyManager->stepCount());
+    connect(historyManager, &HistoryManager::memoryUsageChanged, m_lbHistoryMemoryUsage,
+            updateHistoryMemoryUsage);
+
+    const auto historyCard = new OptionListCard(tr("Undo History"));
+    historyCard->addItem(tr("Max Steps"), tr("0 for unlimited"),
+                         {m_historyMaxSteps->seekbar, m_historyMaxSteps->spinbox});
+    historyCard->addItem(tr("Memory Limit (MB)"), tr("0 for unlimited"),
+                         {m_historyMemoryLimit->seekbar, m_historyMemoryLimit->spinbox});
+    historyCard->addItem(tr("Memory Usage"), m_lbHistoryMemoryUsage);
+
+    m_swPackDenseCurves = new SwitchButton(option->packDenseCurves);
+    connect(m_swPackDenseCurves, &SwitchButton::toggled, this, &GeneralPage::modifyOption);
+
+    m_autoSaveInterval = new SeekBarSpinboxGroup(0, 60, 1, option->autoSaveIntervalMin);
+    m_autoSaveInterval->seekbar->setFixedWidth(256);
+    connect(m_autoSaveInterval, &SeekBarSpinboxGroup::editFinished, this,
+            &GeneralPage::modifyOption);
+
+    const auto projectFileCard = new OptionListCard(tr("Project File"));
+    projectFileCard->addItem(tr("Auto Save Interval (min)"), tr("0 to disable"),
+                             {m_autoSaveInterval->seekbar, m_autoSaveInterval->spinbox});
+    projectFileCard->addItem(
+        tr("Pack Dense Curves"),
+        tr("Smaller files that open faster. Other editors will not see these parameter curves."),
+        m_swPackDenseCurves);
+
     const auto mainLayout = new QVBoxLayout;
     mainLayout->addWidget(configFileCard);
     mainLayout->addWidget(singingCard);
     mainLayout->addWidget(packagePathsCard);
     mainLayout->addWidget(modelCard);
+    mainLayout->addWidget(historyCard);
+    mainLayout->addWidget(projectFileCard);
     mainLayout->addStretch();
     mainLayout->setContentsMargins({});
 
@@ -14,6 +14,9 @@ class LanguageComboBox;
 class DirSelector;
 class FileSelector;
 class PathEditor;
+class SeekBarSpinboxGroup;
+class SwitchButton;
+class QLabel;
 
 class GeneralPage : public IOptionPage {
     Q_OBJECT
@@ -39,6 +42,13 @@ private:
 
     FileSelector *m_fsSomePath;
     FileSelector *m_fsRmvpePath;
+
+    SeekBarSpinboxGroup *m_historyMaxSteps;
+    SeekBarSpinboxGroup *m_historyMemoryLimit;
+    QLabel *m_lbHistoryMemoryUsage;
+
+    SwitchButton *m_swPackDenseCurves;
+    SeekBarSpinboxGroup *m_autoSaveInterval;
 };
 
 #endif // GENERALPAGE_H
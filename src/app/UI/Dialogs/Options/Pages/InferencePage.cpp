@@ -52,6 +52,7 @@ void InferencePage::modifyOption() {
     option->depth = m_dsDepthSlider->spinbox->value();
     option->runVocoderOnCpu = m_swRunVocoderOnCpu->value();
     option->autoStartInfer = m_autoStartInfer->value();
+    option->autoTuneConcurrency = m_swAutoTuneConcurrency->value();
     appOptions->saveAndNotify(AppOptionsGlobal::Inference);
 }
 
@@ -168,6 +169,10 @@ QWidget *InferencePage::createContentWidget() {
     m_autoStartInfer = new SwitchButton(appOptions->inference()->autoStartInfer);
     connect(m_autoStartInfer, &SwitchButton::toggled, this, &InferencePage::modifyOption);
 
+    // Render - auto tune concurrency
+    m_swAutoTuneConcurrency = new SwitchButton(appOptions->inference()->autoTuneConcurrency);
+    connect(m_swAutoTuneConcurrency, &SwitchButton::toggled, this, &InferencePage::modifyOption);
+
     // Render - pitch smooth kernel size
     m_smoothSlider = new SeekBarSpinboxGroup(0, 50, 1, option->pitch_smooth_kernel_size);
     m_smoothSlider->seekbar->setFixedWidth(256);
@@ -184,6 +189,9 @@ QWidget *InferencePage::createContentWidget() {
     renderCard->addItem(tr("Run Vocoder on CPU"), tr("For compatibility with legacy vocoders"),
                         m_swRunVocoderOnCpu);
     renderCard->addItem(tr("Auto Start Infer"), m_autoStartInfer);
+    renderCard->addItem(tr("Auto Tune Concurrency"),
+                        tr("Find the fastest number of parallel tasks for each model"),
+                        m_swAutoTuneConcurrency);
     renderCard->addItem(tr("Pitch Smooth Kernel Size"),
                         tr("Smooth the pitch curve with a sinusoidal kernel"),
                         {m_smoothSlider->seekbar, m_smoothSlider->spinbox});
@@ -29,6 +29,7 @@ private:
     DoubleSeekBarSpinboxGroup *m_dsDepthSlider;
     SwitchButton *m_swRunVocoderOnCpu;
     SwitchButton *m_autoStartInfer;
+    SwitchButton *m_swAutoTuneConcurrency;
     SeekBarSpinboxGroup *m_smoothSlider;
     QTreeView *m_treeView;
 };
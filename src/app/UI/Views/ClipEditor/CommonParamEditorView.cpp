@@ -8,19 +8,61 @@
 #include "Model/AppModel/ParamProperties.h"
 #include "Model/AppModel/SingingClip.h"
 #include "Model/AppStatus/AppStatus.h"
+#include "UI/Views/Common/FrameProfiler.h"
 #include "UI/Views/Common/TimeGraphicsScene.h"
 #include "Utils/AppModelUtils.h"
 #include "Utils/MathUtils.h"
 
 #include <QElapsedTimer>
 #include <QGraphicsSceneMouseEvent>
+#include <QGraphicsView>
 #include <QKeyEvent>
 #include <QPainter>
+#include <QScreen>
+#include <QtMath>
+
+namespace {
+
+// Samples per device pixel from which curves are drawn from their min/max envelope
+constexpr double envelopeThreshold = CurveEnvelope::samplesPerLevel0;
+
+// Calls func(x, min, max) for every device pixel column of the curve from startIndex to endX,
+// reading the envelope level that matches the zoom. Columns are aligned to device pixels of
+// scene x, so that tiles rendered separately join up.
+template <typename Func>
+void forEachEnvelopeColumn(const DrawCurve &curve, const int startIndex, const double startX,
+                           const double interval, const double endX, const double dpr,
+                           Func func) {
+    const auto &level = curve.envelope().levelFor(1 / (interval * dpr));
+    const qsizetype count = curve.valueCount();
+    const auto firstColumn = qFloor((startX + startIndex * interval) * dpr);
+    const auto lastColumn = qCeil(endX * dpr);
+    for (auto column = firstColumn; column <= lastColumn; column++) {
+        const auto x = column / dpr;
+        const auto first = qMax<qsizetype>(startIndex, qCeil((x - startX) / interval));
+        const auto last = qMin<qsizetype>(count, qCeil((x + 1 / dpr - startX) / interval));
+        if (first >= count)
+            break;
+        if (first >= last)
+            continue;
+        const auto [min, max] = CurveEnvelope::rangeOf(level, first, last);
+        func(x, min, max);
+    }
+}
+
+} // namespace
 
 CommonParamEditorView::CommonParamEditorView(const ParamProperties &properties)
     : m_properties(&properties) {
     // setBackgroundColor(Qt::transparent);
     setPixelsPerQuarterNote(ClipEditorGlobal::pixelsPerQuarterNote);
+    m_applyTimer.setSingleShot(true);
+    m_applyTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_applyTimer, &QTimer::timeout, this, &CommonParamEditorView::applyPendingPoints);
+}
+
+CommonParamEditorView::~CommonParamEditorView() {
+    qDeleteAll(m_mergedCurves);
 }
 
 void CommonParamEditorView::setParamProperties(const ParamProperties &properties) {
@@ -29,16 +71,22 @@ void CommonParamEditorView::setParamProperties(const ParamProperties &properties
 }
 
 void CommonParamEditorView::loadOriginal(const QList<DrawCurve *> &curves) {
+    invalidateFilledCurves();
+    invalidateTiles(m_drawCurvesOriginal);
     for (const auto curve : m_drawCurvesOriginal)
         delete curve;
     AppModelUtils::copyCurves(curves, m_drawCurvesOriginal);
+    invalidateTiles(m_drawCurvesOriginal);
     update();
 }
 
 void CommonParamEditorView::loadEdited(const QList<DrawCurve *> &curves) {
+    invalidateFilledCurves();
+    invalidateTiles(m_drawCurvesEdited);
     for (const auto curve : m_drawCurvesEdited)
         delete curve;
     AppModelUtils::copyCurves(curves, m_drawCurvesEdited);
+    invalidateTiles(m_drawCurvesEdited);
     update();
 }
 
@@ -49,6 +97,8 @@ void CommonParamEditorView::clearParams() {
         delete curve;
     m_drawCurvesOriginal.clear();
     m_drawCurvesEdited.clear();
+    invalidateFilledCurves();
+    m_tileCache.invalidate();
     update();
 }
 
@@ -68,7 +118,11 @@ void CommonParamEditorView::discardAction() {
         // qWarning() << "Discard action called, but current edit type is None";
         return;
     }
+    m_pendingPoints.clear();
+    m_applyTimer.stop();
     m_drawCurvesEdited = m_drawCurvesEditedBak;
+    invalidateFilledCurves();
+    m_tileCache.invalidate();
     m_mouseMoved = false;
     m_newCurveCreated = false;
     cancelRequested = true;
@@ -80,6 +134,7 @@ void CommonParamEditorView::discardAction() {
 
 void CommonParamEditorView::commitAction() {
     // qDebug() << "commitAction";
+    applyPendingPoints();
     if (m_mouseMoved) {
         qDebug() << "Edit completed";
         emit editCompleted(editedCurves());
@@ -145,9 +200,28 @@ void CommonParamEditorView::drawGraduates(QPainter *painter, const QStyleOptionG
 
 void CommonParamEditorView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                                   QWidget *widget) {
-    QElapsedTimer mstimer;
-    mstimer.start();
+    FrameProfiler::Scope profilerScope(FrameProfiler::Curves);
     drawGraduates(painter, option, widget);
+
+    // Curves are cached in tiles of scene x, which stay valid as long as the zoom and the mapping
+    // of values to item y do not change
+    const bool foreground = !transparentMouseEvents();
+    if (foreground != m_tilesForeground) {
+        m_tilesForeground = foreground;
+        m_tileCache.invalidate();
+    }
+    m_tileCache.setLayout(tickToSceneX(480) - tickToSceneX(0), pos().y(), scene()->height());
+    m_tileCache.draw(painter, rect(), visibleRect().left(),
+                     [this](QPainter *tilePainter, const double left, const double width) {
+                         renderTile(tilePainter, left, width);
+                     });
+}
+
+void CommonParamEditorView::renderTile(QPainter *painter, const double left,
+                                       const double width) const {
+    // Render a bit of the neighbouring tiles, so that lines crossing the borders are complete
+    const auto rangeStart = sceneXToTick(left - 2);
+    const auto rangeEnd = sceneXToTick(left + width + 2);
     painter->setBrush(Qt::NoBrush);
 
     // auto dpr = painter->device()->devicePixelRatio();
@@ -165,12 +239,12 @@ void CommonParamEditorView::paint(QPainter *painter, const QStyleOptionGraphicsI
         if (!m_drawCurvesOriginal.isEmpty()) {
             pen.setColor(QColor(255, 255, 255, 96));
             painter->setPen(pen);
-            drawCurveBorder(painter, m_drawCurvesOriginal);
+            drawCurveBorder(painter, m_drawCurvesOriginal, rangeStart, rangeEnd);
         }
         if (!m_drawCurvesEdited.isEmpty()) {
             pen.setColor(QColor(255, 255, 255, 230));
             painter->setPen(pen);
-            drawCurveBorder(painter, m_drawCurvesEdited);
+            drawCurveBorder(painter, m_drawCurvesEdited, rangeStart, rangeEnd);
         }
     } else {
         // 绘制填充图形
@@ -193,32 +267,23 @@ void CommonParamEditorView::paint(QPainter *painter, const QStyleOptionGraphicsI
             painter->setBrush(QColor(41, 44, 54));
         }
 
-        DrawCurveList base;
-        DrawCurve *baseCurve = nullptr;
-        if (m_properties->valueType == ParamProperties::ValueType::Relative) {
-            const int start = MathUtils::roundDown(qRound(startTick()), 5);
-            const int end = MathUtils::round(qRound(endTick()), 5) + 5;
-            baseCurve = new DrawCurve(-1);
-            baseCurve->setLocalStart(start);
+        const auto curves =
+            AppModelUtils::curvesIn(filledCurves(), qFloor(rangeStart), qCeil(rangeEnd));
+        if (!curves.isEmpty())
+            drawCurvePolygon(painter, curves, rangeStart, rangeEnd);
+
+        if (m_properties->valueType == ParamProperties::ValueType::Relative &&
+            m_properties->showDefaultValue) {
+            const int start = MathUtils::roundDown(qRound(rangeStart), 5);
+            const int end = MathUtils::round(qRound(rangeEnd), 5) + 5;
+            DrawCurve baseCurve(-1);
+            baseCurve.setLocalStart(start);
             for (int i = start; i <= end; i += 5)
-                baseCurve->appendValue(m_properties->defaultValue);
-            base.append(baseCurve);
-        } else {
-            base = m_drawCurvesOriginal;
-        }
-        const auto overlay = m_drawCurvesEdited;
-        auto curves = AppModelUtils::mergeCurves(base, overlay);
-        if (!curves.isEmpty()) {
-            drawCurvePolygon(painter, curves);
-            for (const auto curve : curves)
-                delete curve;
-        }
-
-        if (baseCurve && m_properties->showDefaultValue) {
+                baseCurve.appendValue(m_properties->defaultValue);
             painter->setBrush(Qt::NoBrush);
             pen.setColor(foreground ? QColor(155, 186, 255) : QColor(41, 44, 54));
             painter->setPen(pen);
-            drawCurveBorder(painter, base);
+            drawCurveBorder(painter, {&baseCurve}, rangeStart, rangeEnd);
         }
 
         // 绘制已编辑描边
@@ -226,12 +291,9 @@ void CommonParamEditorView::paint(QPainter *painter, const QStyleOptionGraphicsI
             painter->setBrush(Qt::NoBrush);
             pen.setColor(QColor(255, 255, 255));
             painter->setPen(pen);
-            drawCurveBorder(painter, m_drawCurvesEdited);
+            drawCurveBorder(painter, m_drawCurvesEdited, rangeStart, rangeEnd);
         }
     }
-
-    // const auto time = static_cast<double>(mstimer.nsecsElapsed()) / 1000000.0;
-    // Logger::d(className, "Render time: " + QString::number(time));
 }
 
 void CommonParamEditorView::mousePressEvent(QGraphicsSceneMouseEvent *event) {
@@ -288,45 +350,54 @@ void CommonParamEditorView::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
     m_mouseMoved = true;
     const auto scenePos = event->scenePos();
     auto tick = MathUtils::round(static_cast<int>(sceneXToTick(scenePos.x())), 5);
-    if (tick < 0) {
+    if (tick < 0)
         tick = 0;
-        qDebug() << "mouseMoveEvent: Negative tick, clipped to 0";
-    }
     const auto value = static_cast<int>(sceneYToValue(scenePos.y()));
     const auto curPos = QPoint(tick, value);
-    qDebug() << "Draw at tick:" << tick << "value:"
-             << m_properties->valueToString(value, m_properties->hasUnit(),
-                                            m_properties->displayPrecision);
-
-    int startTick;
-    int endTick;
-    if (m_prevPos.x() < curPos.x()) {
-        startTick = m_prevPos.x();
-        endTick = curPos.x();
-    } else {
-        endTick = m_prevPos.x();
-        startTick = curPos.x();
+    const auto lastPos = m_pendingPoints.isEmpty() ? m_prevPos : m_pendingPoints.last();
+    if (curPos == lastPos)
+        return;
+
+    m_pendingPoints.append(curPos);
+    if (!m_applyTimer.isActive()) {
+        const auto views = scene()->views();
+        const auto screen = views.isEmpty() ? nullptr : views.first()->screen();
+        const auto refreshRate = screen ? screen->refreshRate() : 60;
+        m_applyTimer.start(qMax(1, qFloor(1000 / refreshRate)));
+    }
+}
+
+void CommonParamEditorView::applyPendingPoints() {
+    m_applyTimer.stop();
+    if (m_pendingPoints.isEmpty())
+        return;
+
+    // The segments are contiguous, so together they touch a single tick range
+    int startTick = m_prevPos.x();
+    int endTick = m_prevPos.x();
+    for (const auto &point : std::as_const(m_pendingPoints)) {
+        startTick = qMin(startTick, point.x());
+        endTick = qMax(endTick, point.x());
     }
 
-    auto overlappedCurves = AppModelUtils::curvesIn(m_drawCurvesEdited, startTick, endTick);
     if (m_editType == Erase) {
-        if (!overlappedCurves.isEmpty()) {
-            for (auto curve : overlappedCurves) {
-                if (curve->localStart() >= startTick && curve->localEndTick() <= endTick) {
-                    // 区间覆盖整条曲线，直接移除该曲线
-                    m_drawCurvesEdited.removeOne(curve);
-                    qDebug() << "Erase: Remove curve #" << curve->id();
-                } else if (curve->localStart() < startTick && curve->localEndTick() > endTick) {
-                    // 区间在曲线内，将曲线切成两段
-                    const auto newCurve = new DrawCurve;
-                    newCurve->setLocalStart(endTick);
-                    auto rightPoints = curve->mid(endTick);
-                    newCurve->setValues(rightPoints); // 将区间右端点之后的点移动到新曲线上
-                    curve->eraseTailFrom(startTick);
-                    MathUtils::binaryInsert(m_drawCurvesEdited, newCurve);
-                } else {
-                    curve->erase(startTick, endTick);
-                }
+        const auto overlappedCurves =
+            AppModelUtils::curvesIn(m_drawCurvesEdited, startTick, endTick);
+        for (auto curve : overlappedCurves) {
+            if (curve->localStart() >= startTick && curve->localEndTick() <= endTick) {
+                // 区间覆盖整条曲线，直接移除该曲线
+                m_drawCurvesEdited.removeOne(curve);
+                qDebug() << "Erase: Remove curve #" << curve->id();
+            } else if (curve->localStart() < startTick && curve->localEndTick() > endTick) {
+                // 区间在曲线内，将曲线切成两段
+                const auto newCurve = new DrawCurve;
+                newCurve->setLocalStart(endTick);
+                auto rightPoints = curve->mid(endTick);
+                newCurve->setValues(rightPoints); // 将区间右端点之后的点移动到新曲线上
+                curve->eraseTailFrom(startTick);
+                MathUtils::binaryInsert(m_drawCurvesEdited, newCurve);
+            } else {
+                curve->erase(startTick, endTick);
             }
         }
     } else {
@@ -341,21 +412,28 @@ void CommonParamEditorView::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
             m_newCurveCreated = true;
         }
 
-        drawLine(m_prevPos, curPos, *m_editingCurve);
-        if (!overlappedCurves.isEmpty()) {
-            for (auto curve : overlappedCurves) {
-                if (curve == m_editingCurve)
-                    continue;
-
-                m_editingCurve->mergeWithCurrentPriority(*curve);
-                m_drawCurvesEdited.removeOne(curve);
-                // delete curve;
-            }
+        // Later segments overwrite earlier ones, as if each mouse move was applied on its own
+        auto prevPos = m_prevPos;
+        for (const auto &point : std::as_const(m_pendingPoints)) {
+            drawLine(prevPos, point, *m_editingCurve);
+            prevPos = point;
+        }
+        // Curves reached by the stroke are merged once per frame
+        const auto overlappedCurves =
+            AppModelUtils::curvesIn(m_drawCurvesEdited, startTick, endTick);
+        for (auto curve : overlappedCurves) {
+            if (curve == m_editingCurve)
+                continue;
+
+            m_editingCurve->mergeWithCurrentPriority(*curve);
+            m_drawCurvesEdited.removeOne(curve);
+            // delete curve;
         }
     }
 
-    m_prevPos = curPos;
-    update();
+    m_prevPos = m_pendingPoints.last();
+    m_pendingPoints.clear();
+    invalidateTiles(startTick, endTick);
 }
 
 void CommonParamEditorView::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
@@ -387,53 +465,177 @@ DrawCurve *CommonParamEditorView::curveAt(const double tick) {
     return nullptr;
 }
 
-void CommonParamEditorView::drawCurveBorder(QPainter *painter,
-                                            const QList<DrawCurve *> &curves) const {
-    auto drawCurve = [painter, this](const DrawCurve &curve) {
+void CommonParamEditorView::invalidateTiles(const double startTick, const double endTick) {
+    updateFilledCurves(qFloor(startTick), qCeil(endTick));
+    // Segments to the neighbouring points and the pen width reach a bit beyond the range
+    constexpr int step = 5;
+    constexpr int margin = 2;
+    const auto left = tickToSceneX(startTick - step) - margin;
+    const auto right = tickToSceneX(endTick + step) + margin;
+    m_tileCache.invalidate(left, right);
+    update(QRectF(sceneXToItemX(left), 0, right - left, rect().height()));
+}
+
+void CommonParamEditorView::invalidateTiles(const QList<DrawCurve *> &curves) {
+    for (const auto curve : curves)
+        invalidateTiles(curve->localStart(), curve->localEndTick());
+}
+
+const QList<DrawCurve *> &CommonParamEditorView::filledCurves() const {
+    // Relative values are filled from the default value, where the default base curve adds
+    // nothing, so the edited curves are drawn as they are
+    if (m_properties->valueType == ParamProperties::ValueType::Relative)
+        return m_drawCurvesEdited;
+    if (!m_mergedCurvesValid) {
+        qDeleteAll(m_mergedCurves);
+        m_mergedCurves = AppModelUtils::mergeCurves(m_drawCurvesOriginal, m_drawCurvesEdited);
+        m_mergedCurvesValid = true;
+    }
+    return m_mergedCurves;
+}
+
+void CommonParamEditorView::invalidateFilledCurves() {
+    m_mergedCurvesValid = false;
+}
+
+void CommonParamEditorView::updateFilledCurves(const int startTick, const int endTick) {
+    if (!m_mergedCurvesValid || m_properties->valueType == ParamProperties::ValueType::Relative)
+        return;
+
+    // Values of the range as merged from the sources, edited ones first
+    constexpr int step = 5;
+    const auto start = startTick / step * step;
+    const auto end = (endTick / step + 1) * step;
+    const auto count = (end - start) / step;
+    QList<int> values(count);
+    QList<bool> covered(count, false);
+    auto fillFrom = [&](const QList<DrawCurve *> &curves) {
+        for (const auto curve : AppModelUtils::curvesIn(curves, start, end)) {
+            const auto first = qMax(start, curve->localStart());
+            const auto last = qMin(end, curve->localEndTick());
+            for (auto tick = first; tick < last; tick += step) {
+                values[(tick - start) / step] = curve->valueAt((tick - curve->localStart()) / step);
+                covered[(tick - start) / step] = true;
+            }
+        }
+    };
+    fillFrom(m_drawCurvesOriginal);
+    fillFrom(m_drawCurvesEdited);
+
+    // A single covered run keeping all the values of the only merged curve reached is written
+    // into that curve, so that only the envelope entries of the range are rebuilt
+    const auto overlappedCurves = AppModelUtils::curvesIn(m_mergedCurves, start, end);
+    const auto firstCovered = covered.indexOf(true);
+    const auto lastCovered = covered.lastIndexOf(true);
+    if (overlappedCurves.count() == 1 && firstCovered >= 0 &&
+        !covered.mid(firstCovered, lastCovered - firstCovered + 1).contains(false)) {
+        const auto curve = overlappedCurves.first();
+        const auto runStart = start + static_cast<int>(firstCovered) * step;
+        const auto runEnd = start + static_cast<int>(lastCovered + 1) * step;
+        if (runStart <= qMax(start, curve->localStart()) &&
+            runEnd >= qMin(end, curve->localEndTick())) {
+            DrawCurve patch(-1);
+            patch.setLocalStart(runStart);
+            patch.setValues(values.mid(firstCovered, lastCovered - firstCovered + 1));
+            curve->mergeWithOtherPriority(patch);
+            return;
+        }
+    }
+
+    // The range was cut or joined: merge again the sources connected to it
+    auto first = start;
+    auto last = end;
+    QList<DrawCurve *> mergedCurves;
+    QList<DrawCurve *> originalCurves;
+    QList<DrawCurve *> editedCurves;
+    while (true) {
+        mergedCurves = AppModelUtils::curvesIn(m_mergedCurves, first, last);
+        originalCurves = AppModelUtils::curvesIn(m_drawCurvesOriginal, first, last);
+        editedCurves = AppModelUtils::curvesIn(m_drawCurvesEdited, first, last);
+        auto newFirst = first;
+        auto newLast = last;
+        for (const auto &curves : {mergedCurves, originalCurves, editedCurves})
+            for (const auto curve : curves) {
+                newFirst = qMin(newFirst, curve->localStart());
+                newLast = qMax(newLast, curve->localEndTick());
+            }
+        if (newFirst == first && newLast == last)
+            break;
+        first = newFirst;
+        last = newLast;
+    }
+    for (const auto curve : mergedCurves) {
+        m_mergedCurves.removeOne(curve);
+        delete curve;
+    }
+    for (const auto curve : AppModelUtils::mergeCurves(originalCurves, editedCurves))
+        MathUtils::binaryInsert(m_mergedCurves, curve);
+}
+
+void CommonParamEditorView::drawCurveBorder(QPainter *painter, const QList<DrawCurve *> &curves,
+                                            const double rangeStart,
+                                            const double rangeEnd) const {
+    auto drawCurve = [painter, rangeStart, rangeEnd, this](const DrawCurve &curve) {
         const auto dpr = painter->device()->devicePixelRatio();
-        // bool peakMode = ((endTick() - startTick()) / 5 / (visibleRect().width() * dpr) > 1);
 
         const int start = curve.localStart();
         const int startIndex =
-            start >= startTick()
+            start >= rangeStart
                 ? 0
-                : (MathUtils::roundDown(static_cast<int>(startTick()), curve.step) - start) /
+                : (MathUtils::roundDown(static_cast<int>(rangeStart), curve.step) - start) /
                       curve.step;
 
         // TODO: 重新设计计算方法
-        if (startIndex >= curve.values().count())
+        if (startIndex >= curve.valueCount())
             return;
 
-        const auto x = tickToItemX(start + startIndex * curve.step);
-        const auto y = valueToItemY(curve.values().at(startIndex));
+        const auto x = tickToSceneX(start + startIndex * curve.step);
+        const auto y = valueToItemY(curve.valueAt(startIndex));
         const QPointF visibleFirstPoint(x, y);
 
         if (m_showDebugInfo) {
-            const auto firstValue = curve.values().first();
-            const auto firstPos = QPointF(tickToItemX(start), valueToItemY(firstValue));
+            const auto firstValue = curve.valueAt(0);
+            const auto firstPos = QPointF(tickToSceneX(start), valueToItemY(firstValue));
             painter->drawText(firstPos, QString("#%1").arg(curve.id()));
         }
 
+        const double tempEndTick = rangeEnd;
+        const double startX = tickToSceneX(start);
+        const double interval = tickToSceneX(start + curve.step) - startX;
+
+        if (1 / (interval * dpr) >= envelopeThreshold) {
+            // Zoomed out: a vertical stroke over the value range of each pixel column, entered
+            // from the end closer to the previous column
+            QPainterPath envelopePath;
+            auto lastY = y;
+            envelopePath.moveTo(visibleFirstPoint);
+            forEachEnvelopeColumn(curve, startIndex, startX, interval, tickToSceneX(rangeEnd),
+                                  dpr, [&](const double columnX, const int min, const int max) {
+                                      const auto yMin = valueToItemY(min);
+                                      const auto yMax = valueToItemY(max);
+                                      const auto minFirst = qAbs(yMin - lastY) < qAbs(yMax - lastY);
+                                      envelopePath.lineTo(columnX, minFirst ? yMin : yMax);
+                                      lastY = minFirst ? yMax : yMin;
+                                      envelopePath.lineTo(columnX, lastY);
+                                  });
+            painter->drawPath(envelopePath);
+            return;
+        }
+
         int pointCount = 0;
         QPainterPath curvePath;
         curvePath.moveTo(visibleFirstPoint);
 
-        const double startTick = start;
-        const double tempEndTick = endTick();
-        const double step = curve.step;
-        const double startX = tickToItemX(startTick);
-        const double endX = tickToItemX(tempEndTick);
-        const double interval = (endX - startX) / ((tempEndTick - startTick) / step);
-
         double lastLineToX = visibleFirstPoint.x();
         bool breakFlag = false;
-        for (int i = startIndex; i < curve.values().count(); i++) {
+        for (int i = startIndex; i < curve.valueCount(); i++) {
             const auto pos = start + curve.step * i;
-            const auto value = curve.values().at(i);
+            const auto value = curve.valueAt(i);
             if (pos > tempEndTick)
                 breakFlag = true;
             const double currentX = startX + i * interval;
-            if (qAbs(lastLineToX - currentX) > dpr) {
+            // The point past the range always ends the path, so that tiles join up
+            if (qAbs(lastLineToX - currentX) > dpr || breakFlag) {
                 curvePath.lineTo(currentX, valueToItemY(value));
                 lastLineToX = currentX;
             }
@@ -445,33 +647,33 @@ void CommonParamEditorView::drawCurveBorder(QPainter *painter,
         painter->drawPath(curvePath);
     };
     for (const auto curve : curves) {
-        if (curve->localEndTick() < startTick())
+        if (curve->localEndTick() < rangeStart)
             continue;
-        if (curve->localStart() > endTick())
+        if (curve->localStart() > rangeEnd)
             break;
         drawCurve(*curve);
     }
 }
 
-void CommonParamEditorView::drawCurvePolygon(QPainter *painter,
-                                             const QList<DrawCurve *> &curves) const {
-    auto drawCurve = [painter, this](const DrawCurve &curve) {
+void CommonParamEditorView::drawCurvePolygon(QPainter *painter, const QList<DrawCurve *> &curves,
+                                             const double rangeStart,
+                                             const double rangeEnd) const {
+    auto drawCurve = [painter, rangeStart, rangeEnd, this](const DrawCurve &curve) {
         const auto dpr = painter->device()->devicePixelRatio();
-        // bool peakMode = ((endTick() - startTick()) / 5 / (visibleRect().width() * dpr) > 1);
 
         const int start = curve.localStart();
         const int startIndex =
-            start >= startTick()
+            start >= rangeStart
                 ? 0
-                : (MathUtils::roundDown(static_cast<int>(startTick()), curve.step) - start) /
+                : (MathUtils::roundDown(static_cast<int>(rangeStart), curve.step) - start) /
                       curve.step;
 
         // TODO: 重新设计计算方法
-        if (startIndex >= curve.values().count())
+        if (startIndex >= curve.valueCount())
             return;
 
-        const auto visibleFirstPoint = QPointF(tickToItemX(start + startIndex * curve.step),
-                                               valueToItemY(curve.values().at(startIndex)));
+        const auto visibleFirstPoint = QPointF(tickToSceneX(start + startIndex * curve.step),
+                                               valueToItemY(curve.valueAt(startIndex)));
 
         const auto fillFromBottom =
             m_properties->displayMode == ParamProperties::DisplayMode::FillFromBottom;
@@ -482,26 +684,39 @@ void CommonParamEditorView::drawCurvePolygon(QPainter *painter,
         fillPath.moveTo(visibleFirstPoint.x(), baseValue);
         fillPath.lineTo(visibleFirstPoint);
 
-        const double startTick = start;
-        const double tempEndTick = endTick();
-        const double step = curve.step;
-        const double startX = tickToItemX(startTick);
-        const double endX = tickToItemX(tempEndTick);
-        const double interval = (endX - startX) / ((tempEndTick - startTick) / step);
-
-        double lastX = 0;
+        const double tempEndTick = rangeEnd;
+        const double startX = tickToSceneX(start);
+        const double interval = tickToSceneX(start + curve.step) - startX;
+
+        double lastX = visibleFirstPoint.x();
+
+        if (1 / (interval * dpr) >= envelopeThreshold) {
+            // Zoomed out: fill each pixel column up to the extreme farthest from the base
+            forEachEnvelopeColumn(curve, startIndex, startX, interval, tickToSceneX(rangeEnd),
+                                  dpr, [&](const double columnX, const int min, const int max) {
+                                      const auto yMin = valueToItemY(min);
+                                      const auto yMax = valueToItemY(max);
+                                      const auto farthest =
+                                          qAbs(yMin - baseValue) > qAbs(yMax - baseValue) ? yMin
+                                                                                          : yMax;
+                                      fillPath.lineTo(columnX, farthest);
+                                      lastX = columnX;
+                                  });
+            fillPath.lineTo(lastX, baseValue);
+            painter->drawPath(fillPath);
+            return;
+        }
 
         double lastLineToX = startX;
         bool breakFlag = false;
-        for (int i = startIndex; i < curve.values().count(); i++) {
+        for (int i = startIndex; i < curve.valueCount(); i++) {
             const auto pos = start + curve.step * i;
-            const auto value = curve.values().at(i);
+            const auto value = curve.valueAt(i);
             if (pos > tempEndTick)
                 breakFlag = true;
             const double x = startX + i * interval;
             // 只有在视图上两点距离达到一个像素以上时才绘制
-            // TODO: 使用峰值模式来绘制
-            if (qAbs(lastLineToX - x) > dpr) {
+            if (qAbs(lastLineToX - x) > dpr || breakFlag) {
                 fillPath.lineTo(x, valueToItemY(value));
                 lastLineToX = x;
             }
@@ -515,9 +730,9 @@ void CommonParamEditorView::drawCurvePolygon(QPainter *painter,
     };
 
     for (const auto curve : curves) {
-        if (curve->localEndTick() < startTick())
+        if (curve->localEndTick() < rangeStart)
             continue;
-        if (curve->localStart() > endTick())
+        if (curve->localStart() > rangeEnd)
             break;
         drawCurve(*curve);
     }
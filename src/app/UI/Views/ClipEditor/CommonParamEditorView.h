@@ -7,8 +7,11 @@
 
 #include "Interface/IAtomicAction.h"
 #include "Model/AppModel/DrawCurve.h"
+#include "UI/Views/Common/TileCache.h"
 #include "UI/Views/Common/TimeOverlayView.h"
 
+#include <QTimer>
+
 class ParamProperties;
 
 class CommonParamEditorView : public TimeOverlayView, public IAtomicAction {
@@ -18,6 +21,7 @@ public:
     enum EditMode { Free, Anchor, Off };
 
     explicit CommonParamEditorView(const ParamProperties &properties);
+    ~CommonParamEditorView() override;
 
     void setParamProperties(const ParamProperties &properties);
     void loadOriginal(const QList<DrawCurve *> &curves);
@@ -41,10 +45,22 @@ private:
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
+    void applyPendingPoints();
     void updateRectAndPos() override;
-    void drawCurveBorder(QPainter *painter, const QList<DrawCurve *> &curves) const;
-    void drawCurvePolygon(QPainter *painter, const QList<DrawCurve *> &curves) const;
+    void renderTile(QPainter *painter, double left, double width) const;
+    // Drops the tiles of the tick range and repaints only its scene rect
+    void invalidateTiles(double startTick, double endTick);
+    void invalidateTiles(const QList<DrawCurve *> &curves);
+    void drawCurveBorder(QPainter *painter, const QList<DrawCurve *> &curves, double rangeStart,
+                         double rangeEnd) const;
+    void drawCurvePolygon(QPainter *painter, const QList<DrawCurve *> &curves, double rangeStart,
+                          double rangeEnd) const;
     static void drawLine(const QPoint &p1, const QPoint &p2, DrawCurve &curve);
+    // The curves the filled shape is drawn from, merged on the first call after a reload
+    [[nodiscard]] const QList<DrawCurve *> &filledCurves() const;
+    void invalidateFilledCurves();
+    // Merges the sources again over the tick range only, keeping the other merged curves
+    void updateFilledCurves(int startTick, int endTick);
 
     bool m_showDebugInfo = false;
 
@@ -62,6 +78,17 @@ private:
     QList<DrawCurve *> m_drawCurvesEdited;
     QList<DrawCurve *> m_drawCurvesOriginal;
     QList<DrawCurve *> m_drawCurvesEditedBak;
+    // Kept across edits and patched over the edited range, so that their envelopes are only
+    // rebuilt there
+    mutable QList<DrawCurve *> m_mergedCurves;
+    mutable bool m_mergedCurvesValid = false;
+    // Mouse positions not applied yet. Moves are coalesced to the display refresh rate, as
+    // tablets may report several hundred per second.
+    QList<QPoint> m_pendingPoints;
+    QTimer m_applyTimer;
+
+    TileCache m_tileCache;
+    bool m_tilesForeground = false;
 
     [[nodiscard]] double valueToItemY(double value) const;
     DrawCurve *curveAt(double tick);
@@ -5,6 +5,7 @@
 #include "ClipRangeOverlay.h"
 
 #include "UI/Views/ClipEditor/ClipEditorGlobal.h"
+#include "UI/Views/Common/FrameProfiler.h"
 
 #include <QPainter>
 
@@ -27,6 +28,7 @@ void ClipRangeOverlay::updateRectAndPos() {
 
 void ClipRangeOverlay::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                              QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Overlays);
     painter->setPen(Qt::NoPen);
     constexpr auto fillColor = QColor(0, 0, 0, 64);
     if (m_clipStart > startTick()) {
@@ -8,13 +8,13 @@
 #include "Global/AppGlobal.h"
 #include "UI/Views/ClipEditor/ClipEditorGlobal.h"
 #include "UI/Views/Common/AbstractGraphicsRectItem.h"
+#include "UI/Views/Common/FrameProfiler.h"
+#include "UI/Views/Common/TextCache.h"
 
 #include <QGraphicsSceneContextMenuEvent>
 #include <QPainter>
-#include <QTextOption>
 #include <QMWidgets/cmenu.h>
 #include <QDebug>
-#include <QElapsedTimer>
 #include <QGraphicsProxyWidget>
 #include <QLineEdit>
 #include <QKeyEvent>
@@ -34,6 +34,12 @@ NoteView::~NoteView() {
     }
 }
 
+void NoteView::setId(const int itemId) {
+    m_id = itemId;
+    if (m_pronView)
+        m_pronView->m_id = itemId;
+}
+
 int NoteView::rStart() const {
     return m_rStart;
 }
@@ -131,8 +137,7 @@ void NoteView::resetOffset() {
 }
 
 void NoteView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
-    QElapsedTimer timer;
-    timer.start();
+    FrameProfiler::Scope profilerScope(FrameProfiler::Notes);
 
     constexpr auto backgroundColorNormal = QColor(155, 186, 255);
     constexpr auto backgroundColorEditingPitch = QColor(53, 59, 74);
@@ -233,18 +238,15 @@ void NoteView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
         auto textRectHeight = paddedRect.height();
         auto textRect = QRectF(textRectLeft, textRectTop, textRectWidth, textRectHeight);
 
-        auto fontMetrics = painter->fontMetrics();
-        auto textHeight = fontMetrics.height();
-        auto lyricTextWidth = fontMetrics.horizontalAdvance(m_lyric);
-        auto pronTextWidth = fontMetrics.horizontalAdvance(m_pronunciation);
-        QTextOption textOption(Qt::AlignVCenter);
-        textOption.setWrapMode(QTextOption::NoWrap);
+        const auto textCache = TextCache::instance();
+        const auto lyricTextSize = textCache->textSize(font, m_lyric);
+        const auto pronTextSize = textCache->textSize(font, m_pronunciation);
+        auto textHeight = painter->fontMetrics().height();
+        auto lyricTextWidth = lyricTextSize.width();
+        auto pronTextWidth = pronTextSize.width();
 
         if (!m_editingLyric && qMax(lyricTextWidth, pronTextWidth) < textRectWidth && textHeight < textRectHeight) {
-            // auto time1 = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
-            painter->drawText(textRect, m_lyric, textOption);
-            // auto time2 = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
-            // qDebug() << "Lyric painted in" << time2 - time1 << "ms";
+            textCache->drawText(painter, textRect, m_lyric, Qt::AlignVCenter);
             if (m_pronView) {
                 // adjustPronView();
                 m_pronView->setTextVisible(true);
@@ -259,9 +261,6 @@ void NoteView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
         drawRectOnly();
     else
         drawFullNote();
-
-    // const auto time = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
-    // qDebug() << "NoteView painted in" << time << "ms";
 }
 
 // void NoteView::hoverMoveEvent(QGraphicsSceneHoverEvent *event) {
@@ -22,6 +22,8 @@ class NoteView final : public AbstractGraphicsRectItem,
 public:
     explicit NoteView(int itemId, QGraphicsItem *parent = nullptr);
     ~NoteView() override;
+    // Rebinds a pooled view and its pronunciation view to another note
+    void setId(int itemId);
     [[nodiscard]] int rStart() const;
     void setRStart(int rStart);
     [[nodiscard]] int length() const;
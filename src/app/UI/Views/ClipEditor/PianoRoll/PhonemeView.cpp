@@ -10,6 +10,7 @@
 #include "Model/AppStatus/AppStatus.h"
 #include "Utils/Linq.h"
 #include "Utils/MathUtils.h"
+#include "UI/Views/Common/TextCache.h"
 
 #include <QElapsedTimer>
 #include <QMouseEvent>
@@ -118,7 +119,8 @@ void PhonemeView::paintEvent(QPaintEvent *event) {
 
     if (!canEdit()) {
         painter.setPen(QColor(255, 255, 255, 80));
-        painter.drawText(rect(), tr("Zoom in to edit phonemes"), QTextOption(Qt::AlignCenter));
+        TextCache::instance()->drawText(&painter, rect(), tr("Zoom in to edit phonemes"),
+                                        Qt::AlignCenter);
         return;
     }
 
@@ -167,10 +169,7 @@ void PhonemeView::paintEvent(QPaintEvent *event) {
         else
             text = phoneme->name;
 
-        const auto &cache = edited ? m_editedTextCache : m_originalTextCache;
-        if (!cache.contains(text) || cache[text].isNull())
-            cacheText(text, edited, painter);
-        painter.drawPixmap(textRect.topLeft(), cache[text]);
+        TextCache::instance()->drawText(&painter, textRect.topLeft(), text);
     };
 
     // Draw notes' word boundary
@@ -521,21 +520,4 @@ void PhonemeView::handleAdjustCompleted(const PhonemeViewModel *phVm) {
         m_curPhoneme = nullptr;
     }
     clipController->onAdjustPhonemeOffset(phVm->noteId, type, offsets);
-}
-
-void PhonemeView::cacheText(const QString &text, const bool edited, const QPainter &painter) {
-    // qDebug() << "cacheText:" << text;
-    const QSize textSize = painter.fontMetrics().size(Qt::TextSingleLine, text);
-    QPixmap pixmap(textSize * painter.device()->devicePixelRatio());
-    pixmap.setDevicePixelRatio(painter.device()->devicePixelRatio());
-    pixmap.fill(Qt::transparent);
-
-    QPainter cachePainter(&pixmap);
-    cachePainter.setPen(painter.pen());
-    cachePainter.drawText(pixmap.rect(), text);
-
-    if (edited)
-        m_editedTextCache.insert(text, pixmap);
-    else
-        m_originalTextCache.insert(text, pixmap);
 }
\ No newline at end of file
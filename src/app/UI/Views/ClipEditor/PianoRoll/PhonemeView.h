@@ -87,8 +87,6 @@ private:
     bool m_showDebugInfo = false;
     int m_canEditTicksPerPixelThreshold = 6;
     bool m_mouseMoved = false;
-    QMap<QString, QPixmap> m_originalTextCache;
-    QMap<QString, QPixmap> m_editedTextCache;
 
     SingingClip *m_clip = nullptr;
 
@@ -98,8 +96,6 @@ private:
     void resetPhonemeList();
     void clearHoverEffects(const PhonemeViewModel *except = nullptr);
     void handleAdjustCompleted(const PhonemeViewModel *phVm);
-
-    void cacheText(const QString &text, bool edited, const QPainter &painter);
 };
 
 
@@ -6,6 +6,7 @@
 
 #include "PianoPaintUtils.h"
 #include "UI/Views/ClipEditor/ClipEditorGlobal.h"
+#include "UI/Views/Common/FrameProfiler.h"
 
 #include <QPainter>
 
@@ -13,6 +14,7 @@ using namespace ClipEditorGlobal;
 
 void PianoRollBackground::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                                 QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Background);
     // Draw background
     painter->setPen(Qt::NoPen);
     painter->setBrush(m_whiteKeyColor);
@@ -52,6 +52,8 @@ PianoRollGraphicsView::PianoRollGraphicsView(PianoRollGraphicsScene *scene, cons
     setScaleXMax(5);
     setPixelsPerQuarterNote(pixelsPerQuarterNote);
     setSceneVisibility(false);
+    // PianoRollBackground covers the viewport whenever the scene is shown
+    setSceneFillsViewport(true);
     setDragBehavior(DragBehavior::RectSelect);
     setMinimumHeight(0);
     // QScroller::grabGesture(this, QScroller::TouchGesture);
@@ -85,11 +87,26 @@ PianoRollGraphicsView::PianoRollGraphicsView(PianoRollGraphicsScene *scene, cons
 
     connect(appStatus, &AppStatus::noteSelectionChanged, d,
             &PianoRollGraphicsViewPrivate::onNoteSelectionChanged);
+
+    connect(this, &TimeGraphicsView::scaleChanged, d,
+            &PianoRollGraphicsViewPrivate::updateMaterializedNotes);
+    connect(this, &TimeGraphicsView::visibleRectChanged, d,
+            &PianoRollGraphicsViewPrivate::updateMaterializedNotes);
+
+    d->setVirtualized(appOptions->appearance()->virtualizeNoteViews);
+    connect(appOptions, &AppOptions::optionsChanged, this,
+            [this](const AppOptionsGlobal::Option option) {
+                if (option != AppOptionsGlobal::All && option != AppOptionsGlobal::Appearance)
+                    return;
+                Q_D(PianoRollGraphicsView);
+                d->setVirtualized(appOptions->appearance()->virtualizeNoteViews);
+            });
 }
 
 PianoRollGraphicsView::~PianoRollGraphicsView() {
     Q_D(PianoRollGraphicsView);
     delete d->m_pitchEditor;
+    qDeleteAll(d->m_noteViewPool);
     delete d_ptr;
 }
 
@@ -168,7 +185,7 @@ void PianoRollGraphicsView::mousePressEvent(QMouseEvent *event) {
          d->m_editMode == SplitNote)) {
         d->m_mouseMoveBehavior = PianoRollGraphicsViewPrivate::None;
         if (const auto noteView = d->noteViewAt(event->pos())) {
-            if (d->selectedNoteItems().count() <= 1 || !d->selectedNoteItems().contains(noteView))
+            if (d->selectedNoteCount() <= 1 || !d->selectedNoteItems().contains(noteView))
                 clearNoteSelections();
             noteView->setSelected(true);
         } else {
@@ -454,11 +471,14 @@ QList<int> PianoRollGraphicsView::selectedNotesId() const {
         if (noteView->isSelected())
             list.append(noteView->id());
     }
+    for (const auto id : d->m_hiddenSelectedNotes)
+        list.append(id);
     return list;
 }
 
 void PianoRollGraphicsView::clearNoteSelections(const NoteView *except) {
     Q_D(PianoRollGraphicsView);
+    d->m_hiddenSelectedNotes.clear();
     for (const auto noteView : d->noteViews) {
         if (noteView != except && noteView->isSelected())
             noteView->setSelected(false);
@@ -610,6 +630,7 @@ void PianoRollGraphicsViewPrivate::onNoteChanged(const SingingClip::NoteChangeTy
     }
 
     updateOverlappedState();
+    updateMaterializedNotes();
 }
 
 void PianoRollGraphicsViewPrivate::onNoteSelectionChanged() {
@@ -705,26 +726,35 @@ void PianoRollGraphicsViewPrivate::onNoteTabKeyPressed(NoteView *noteView) {
     }
 }
 
-NoteView *PianoRollGraphicsViewPrivate::findNextNoteView(NoteView *currentNoteView) const {
+NoteView *PianoRollGraphicsViewPrivate::findNextNoteView(NoteView *currentNoteView) {
     if (!m_clip || !currentNoteView)
         return nullptr;
 
     const int currentRStart = currentNoteView->rStart();
-    NoteView *nextNoteView = nullptr;
+    const Note *nextNote = nullptr;
     int minRStart = INT_MAX;
 
-    // Find all Notes after current Note, select the one with smallest rStart
-    for (const auto view : noteViews) {
-        if (view == currentNoteView || view->rStart() <= currentRStart)
+    // Find all Notes after current Note, select the one with smallest rStart. The notes are
+    // searched instead of the views, as the next note may have no view in virtualized mode.
+    for (const auto note : m_notes) {
+        if (note->id() == currentNoteView->id() || note->localStart() <= currentRStart)
             continue;
 
-        if (view->rStart() < minRStart) {
-            minRStart = view->rStart();
-            nextNoteView = view;
+        if (note->localStart() < minRStart) {
+            minRStart = note->localStart();
+            nextNote = note;
         }
     }
 
-    return nextNoteView;
+    if (!nextNote)
+        return nullptr;
+    if (const auto noteView = findNoteViewById(nextNote->id()))
+        return noteView;
+    const auto barrier = m_selectionChangeBarrier;
+    m_selectionChangeBarrier = true;
+    const auto noteView = materializeNoteView(*nextNote);
+    m_selectionChangeBarrier = barrier;
+    return noteView;
 }
 
 CMenu *PianoRollGraphicsViewPrivate::buildNoteContextMenu(NoteView *noteView,
@@ -822,7 +852,7 @@ void PianoRollGraphicsViewPrivate::prepareForEditingNotes(const QMouseEvent *eve
     appStatus->currentEditObject = AppStatus::EditObjectType::Note;
     const bool ctrlDown = event->modifiers() == Qt::ControlModifier;
     if (!ctrlDown) {
-        if (selectedNoteItems().count() <= 1 || !selectedNoteItems().contains(noteItem))
+        if (selectedNoteCount() <= 1 || !selectedNoteItems().contains(noteItem))
             q->clearNoteSelections();
         noteItem->setSelected(true);
     } else {
@@ -931,33 +961,38 @@ void PianoRollGraphicsViewPrivate::updateSceneSelectionState() {
     q->clearNoteSelections();
 
     for (const auto id : appStatus->selectedNotes.get()) {
-        const auto noteItem = findNoteViewById(id);
-        Q_ASSERT(noteItem);
-        noteItem->setSelected(true);
+        if (const auto noteItem = findNoteViewById(id))
+            noteItem->setSelected(true);
+        else {
+            Q_ASSERT(m_virtualized);
+            m_hiddenSelectedNotes.insert(id);
+        }
     }
     m_selectionChangeBarrier = false;
 }
 
 void PianoRollGraphicsViewPrivate::updateOverlappedState() {
     Q_Q(PianoRollGraphicsView);
-    for (const auto note : m_notes) {
-        const auto noteView = findNoteViewById(note->id());
-        Q_ASSERT(noteView);
+    for (const auto noteView : noteViews + noteViewsToErase) {
+        const auto note = m_noteById.value(noteView->id());
+        Q_ASSERT(note);
         noteView->setOverlapped(note->overlapped());
     }
     q->update();
 }
 
 void PianoRollGraphicsViewPrivate::updateNoteTimeAndKey(const Note *note) const {
-    const auto noteView = findNoteViewById(note->id());
-    Q_ASSERT(noteView);
-    Helper::updateNoteTimeAndKey(*noteView, *note);
+    if (const auto noteView = findNoteViewById(note->id()))
+        Helper::updateNoteTimeAndKey(*noteView, *note);
+    else
+        Q_ASSERT(m_virtualized);
 }
 
 void PianoRollGraphicsViewPrivate::updateNoteWord(const Note *note) const {
-    const auto noteView = findNoteViewById(note->id());
-    Q_ASSERT(noteView);
-    Helper::updateNoteWord(*noteView, *note);
+    if (const auto noteView = findNoteViewById(note->id()))
+        Helper::updateNoteWord(*noteView, *note);
+    else
+        Q_ASSERT(m_virtualized);
 }
 
 double PianoRollGraphicsViewPrivate::keyIndexToSceneY(const double index) const {
@@ -992,11 +1027,15 @@ void PianoRollGraphicsViewPrivate::resetSelectedNotesOffset() const {
 }
 
 void PianoRollGraphicsViewPrivate::updateMoveDeltaKeyRange() {
-    auto selectedNotes = selectedNoteItems();
+    QList<int> keys;
+    for (const auto note : selectedNoteItems())
+        keys.append(note->keyIndex());
+    for (const auto id : m_hiddenSelectedNotes)
+        if (const auto note = m_noteById.value(id))
+            keys.append(note->keyIndex());
     int highestKey = 0;
     int lowestKey = 127;
-    for (const auto note : selectedNotes) {
-        const auto key = note->keyIndex();
+    for (const auto key : keys) {
         if (key > highestKey)
             highestKey = key;
         if (key < lowestKey)
@@ -1025,6 +1064,10 @@ QList<NoteView *> PianoRollGraphicsViewPrivate::selectedNoteItems() const {
     return Linq::where(noteViews, L_PRED(n, n->isSelected()));
 }
 
+qsizetype PianoRollGraphicsViewPrivate::selectedNoteCount() const {
+    return selectedNoteItems().count() + m_hiddenSelectedNotes.count();
+}
+
 void PianoRollGraphicsViewPrivate::setPitchEditMode(const bool on, const bool isErase) {
     Q_Q(PianoRollGraphicsView);
     if (on)
@@ -1062,24 +1105,27 @@ NoteView *PianoRollGraphicsViewPrivate::findNoteViewById(const int id) const {
 }
 
 void PianoRollGraphicsViewPrivate::handleNoteInserted(Note *note) {
-    Q_Q(PianoRollGraphicsView);
     m_selectionChangeBarrier = true;
-    const auto noteView = Helper::buildNoteView(*note);
-    noteView->fontPixelSize = q->m_noteFontPixelSize;
-    noteView->setEditingPitch(m_isEditPitchMode);
-    addNoteViewToScene(noteView);
+    if (!m_virtualized ||
+        isNoteInRange(note->localStart(), note->length(), note->keyIndex(), materializedRange()))
+        materializeNoteView(*note);
     m_notes.append(note);
+    m_noteById.insert(note->id(), note);
     m_selectionChangeBarrier = false;
 }
 
 void PianoRollGraphicsViewPrivate::handleNoteRemoved(Note *note) {
     m_selectionChangeBarrier = true;
     // qDebug() << "PianoRollGraphicsView::removeNote" << note->id() << note->lyric();
-    const auto noteView = findNoteViewById(note->id());
-    Q_ASSERT(noteView);
-    removeNoteViewFromScene(noteView);
-    delete noteView;
+    if (const auto noteView = findNoteViewById(note->id())) {
+        removeNoteViewFromScene(noteView);
+        noteViewsToErase.removeOne(noteView);
+        delete noteView;
+    } else
+        Q_ASSERT(m_virtualized);
+    m_hiddenSelectedNotes.remove(note->id());
     m_notes.removeOne(note);
+    m_noteById.remove(note->id());
     disconnect(note, nullptr, this, nullptr);
     m_selectionChangeBarrier = false;
 }
@@ -1100,6 +1146,115 @@ void PianoRollGraphicsViewPrivate::removeNoteViewFromScene(NoteView *view) {
     noteViews.removeOne(view);
 }
 
+void PianoRollGraphicsViewPrivate::setVirtualized(const bool on) {
+    if (m_virtualized == on)
+        return;
+    m_virtualized = on;
+    if (!m_clip)
+        return;
+    if (on) {
+        updateMaterializedNotes();
+        return;
+    }
+
+    const auto barrier = m_selectionChangeBarrier;
+    m_selectionChangeBarrier = true;
+    QSet<int> materialized;
+    for (const auto noteView : noteViews + noteViewsToErase)
+        materialized.insert(noteView->id());
+    for (const auto note : m_notes)
+        if (!materialized.contains(note->id()))
+            materializeNoteView(*note);
+    m_selectionChangeBarrier = barrier;
+    qDeleteAll(m_noteViewPool);
+    m_noteViewPool.clear();
+}
+
+// The visible area in local ticks (x) and key indexes (y), grown by half a screen on both sides
+// and an octave above and below, so that short scrolls reuse the views already in the scene
+QRectF PianoRollGraphicsViewPrivate::materializedRange() const {
+    Q_Q(const PianoRollGraphicsView);
+    const auto visibleRect = q->visibleRect();
+    const auto startTick = q->sceneXToTick(visibleRect.left());
+    const auto endTick = q->sceneXToTick(visibleRect.right());
+    const auto margin = (endTick - startTick) / 2;
+    const auto lowKey = q->bottomKeyIndex() - 12;
+    const auto highKey = q->topKeyIndex() + 12;
+    return {startTick - margin, lowKey, endTick - startTick + 2 * margin, highKey - lowKey};
+}
+
+bool PianoRollGraphicsViewPrivate::isNoteInRange(const int rStart, const int length,
+                                                 const int keyIndex, const QRectF &range) {
+    return rStart < range.right() && rStart + length > range.left() && keyIndex >= range.top() &&
+           keyIndex <= range.bottom();
+}
+
+// Views being dragged or edited keep their note even when it leaves the range
+bool PianoRollGraphicsViewPrivate::isNoteViewPinned(const NoteView *view) const {
+    return view->isEditingLyric() || (m_mouseDown && view == m_currentEditingNote);
+}
+
+void PianoRollGraphicsViewPrivate::updateMaterializedNotes() {
+    if (!m_virtualized || !m_clip)
+        return;
+
+    const auto range = materializedRange();
+    const auto barrier = m_selectionChangeBarrier;
+    m_selectionChangeBarrier = true;
+
+    QSet<int> materialized;
+    for (const auto noteView : QList(noteViews)) {
+        if (isNoteViewPinned(noteView) ||
+            isNoteInRange(noteView->rStart(), noteView->length(), noteView->keyIndex(), range))
+            materialized.insert(noteView->id());
+        else
+            recycleNoteView(noteView);
+    }
+
+    const auto interval = std::make_tuple(static_cast<qsizetype>(std::floor(range.left())),
+                                          static_cast<qsizetype>(std::ceil(range.right())));
+    for (const auto note : m_clip->notes().findOverlappedItems(interval)) {
+        if (materialized.contains(note->id()) || m_notesToErase.contains(note->id()))
+            continue;
+        if (isNoteInRange(note->localStart(), note->length(), note->keyIndex(), range))
+            materializeNoteView(*note);
+    }
+    m_selectionChangeBarrier = barrier;
+}
+
+NoteView *PianoRollGraphicsViewPrivate::materializeNoteView(const Note &note) {
+    Q_Q(PianoRollGraphicsView);
+    NoteView *noteView;
+    if (m_noteViewPool.isEmpty())
+        noteView = Helper::buildNoteView(note);
+    else {
+        noteView = m_noteViewPool.takeLast();
+        Helper::bindNoteView(*noteView, note);
+    }
+    noteView->fontPixelSize = q->m_noteFontPixelSize;
+    noteView->setEditingPitch(m_isEditPitchMode);
+    addNoteViewToScene(noteView);
+
+    // Restore the selection of a note scrolled back in, following a move in progress
+    if (m_hiddenSelectedNotes.remove(note.id())) {
+        noteView->setSelected(true);
+        if (m_mouseDown && m_mouseMoveBehavior == Move && m_movedBeforeMouseUp) {
+            noteView->setStartOffset(m_deltaTick);
+            noteView->setKeyOffset(m_deltaKey);
+        }
+    }
+    return noteView;
+}
+
+void PianoRollGraphicsViewPrivate::recycleNoteView(NoteView *view) {
+    if (view->isSelected()) {
+        m_hiddenSelectedNotes.insert(view->id());
+        view->setSelected(false);
+    }
+    removeNoteViewFromScene(view);
+    m_noteViewPool.append(view);
+}
+
 void PianoRollGraphicsViewPrivate::onHoverEnter(QHoverEvent *event) {
 }
 
@@ -43,18 +43,18 @@ void PianoRollGraphicsViewHelper::editPitch(const QList<DrawCurve *> &curves) {
 NoteView *PianoRollGraphicsViewHelper::buildNoteView(const Note &note) {
     const auto noteView = new NoteView(note.id());
     noteView->setPronunciationView(new PronunciationView(note.id()));
-    noteView->setRStart(note.localStart());
-    noteView->setLength(note.length());
-    noteView->setKeyIndex(note.keyIndex());
-    noteView->setLyric(note.lyric());
-    const auto original = note.pronunciation().original;
-    const auto edited = note.pronunciation().edited;
-    const auto isEdited = note.pronunciation().isEdited();
-    noteView->setPronunciation(isEdited ? edited : original, isEdited);
-    noteView->setOverlapped(note.overlapped());
+    bindNoteView(*noteView, note);
     return noteView;
 }
 
+void PianoRollGraphicsViewHelper::bindNoteView(NoteView &noteView, const Note &note) {
+    noteView.setId(note.id());
+    noteView.resetOffset();
+    updateNoteTimeAndKey(noteView, note);
+    updateNoteWord(noteView, note);
+    noteView.setOverlapped(note.overlapped());
+}
+
 void PianoRollGraphicsViewHelper::updateNoteTimeAndKey(NoteView &noteView, const Note &note) {
     noteView.setRStart(note.localStart());
     noteView.setLength(note.length());
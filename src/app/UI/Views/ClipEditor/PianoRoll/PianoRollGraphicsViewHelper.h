@@ -21,6 +21,7 @@ namespace PianoRollGraphicsViewHelper {
     void drawNote(int rStart, int length, int keyIndex);
     void editPitch(const QList<DrawCurve *> &curves);
     NoteView *buildNoteView(const Note &note);
+    void bindNoteView(NoteView &noteView, const Note &note);
     void updateNoteTimeAndKey(NoteView &noteView, const Note &note);
     void updateNoteWord(NoteView &noteView, const Note &note);
     void updatePitch(Param::Type paramType, const Param &param, PitchEditorView &pitchEditor);
@@ -10,7 +10,9 @@
 
 #include <QObject>
 #include <QPointF>
+#include <QRectF>
 #include <QColor>
+#include <QSet>
 
 class ClipRangeOverlay;
 class PitchEditorView;
@@ -36,6 +38,7 @@ public:
     SingingClip *m_clip = nullptr;
     int m_offset = 0; // Clip 's "start" property
     QList<Note *> m_notes;
+    QHash<int, Note *> m_noteById;
 
     enum MouseMoveBehavior { ResizeLeft, Move, ResizeRight, UpdateDrawingNote, EraseNotes, None };
 
@@ -43,6 +46,12 @@ public:
     PianoRollBackground *m_gridItem = nullptr;
     QList<NoteView *> noteViews;
 
+    // In virtualized mode only the notes around the visible area have a view. Views scrolled out
+    // are recycled through the pool, the selection of notes without a view is kept by id.
+    bool m_virtualized = false;
+    QList<NoteView *> m_noteViewPool;
+    QSet<int> m_hiddenSelectedNotes;
+
     PitchEditorView *m_pitchEditor = nullptr;
     ClipRangeOverlay *m_clipRangeOverlay = nullptr;
     QGraphicsPathItem *m_splitLineIndicator = nullptr;
@@ -109,6 +118,7 @@ public:
     [[nodiscard]] double sceneYToKeyIndexDouble(double y) const;
     [[nodiscard]] int sceneYToKeyIndexInt(double y) const;
     [[nodiscard]] QList<NoteView *> selectedNoteItems() const;
+    [[nodiscard]] qsizetype selectedNoteCount() const;
     void setPitchEditMode(bool on, bool isErase);
     [[nodiscard]] NoteView *noteViewAt(const QPoint &pos);
     [[nodiscard]] PronunciationView *pronViewAt(const QPoint &pos);
@@ -119,6 +129,15 @@ public:
     void addNoteViewToScene(NoteView *view);
     void removeNoteViewFromScene(NoteView *view);
 
+    void setVirtualized(bool on);
+    [[nodiscard]] QRectF materializedRange() const;
+    [[nodiscard]] static bool isNoteInRange(int rStart, int length, int keyIndex,
+                                            const QRectF &range);
+    [[nodiscard]] bool isNoteViewPinned(const NoteView *view) const;
+    void updateMaterializedNotes();
+    NoteView *materializeNoteView(const Note &note);
+    void recycleNoteView(NoteView *view);
+
     void onHoverEnter(QHoverEvent *event);
     void onHoverLeave(QHoverEvent *event);
     void onHoverMove(const QHoverEvent *event);
@@ -134,7 +153,7 @@ public slots:
     void onStartEditingNoteLyric(NoteView *noteView);
     void onNoteLyricEditingFinished(NoteView *noteView, const QString &lyric);
     void onNoteTabKeyPressed(NoteView *noteView);
-    NoteView *findNextNoteView(NoteView *currentNoteView) const;
+    NoteView *findNextNoteView(NoteView *currentNoteView);
 
 private:
     PianoRollGraphicsView *q_ptr;
@@ -4,7 +4,9 @@
 
 #include "PronunciationView.h"
 
-#include <QElapsedTimer>
+#include "UI/Views/Common/FrameProfiler.h"
+#include "UI/Views/Common/TextCache.h"
+
 #include <QPainter>
 
 PronunciationView::PronunciationView(const int noteId, QGraphicsItem *parent)
@@ -27,11 +29,10 @@ void PronunciationView::setTextVisible(const bool visible) {
 
 void PronunciationView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                               QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Notes);
     if (!m_textVisible)
         return;
 
-    QElapsedTimer timer;
-    timer.start();
     constexpr auto pronColorOriginal = QColor(200, 200, 200);
     constexpr auto pronColorEdited = QColor(155, 186, 255);
     constexpr auto penWidth = 1.5f;
@@ -51,10 +52,7 @@ void PronunciationView::paint(QPainter *painter, const QStyleOptionGraphicsItem
     pen.setWidthF(penWidth);
     pen.setColor(m_pronunciationEdited ? pronColorEdited : pronColorOriginal);
     painter->setPen(pen);
-    painter->drawText(textRect, m_pronunciation);
-
-    // const auto time = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
-    // qDebug() << "PronunciationView painted in" << time << "ms";
+    TextCache::instance()->drawText(painter, textRect, m_pronunciation);
 }
 
 void PronunciationView::updateRectAndPos() {
@@ -0,0 +1,178 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "FrameProfiler.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtMath>
+
+#include <algorithm>
+
+FrameProfiler *FrameProfiler::s_current = nullptr;
+
+FrameProfiler::Scope::Scope(const Layer layer) : m_profiler(s_current), m_layer(layer) {
+    // Nested scopes (e.g. a subclass calling the paint() of its base) are counted once
+    if (m_profiler && m_profiler->m_depth++ == 0)
+        m_timer.start();
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (!m_profiler || --m_profiler->m_depth > 0)
+        return;
+    auto &frame = m_profiler->m_currentFrame;
+    frame.layerMs[m_layer] += static_cast<double>(m_timer.nsecsElapsed()) / 1e6;
+    frame.itemCount++;
+}
+
+FrameProfiler::FrameProfiler(const qsizetype capacity) {
+    m_frames.resize(capacity);
+}
+
+QString FrameProfiler::layerName(const Layer layer) {
+    switch (layer) {
+        case Background:
+            return "Background";
+        case Clips:
+            return "Clips";
+        case Notes:
+            return "Notes";
+        case Curves:
+            return "Curves";
+        case Overlays:
+            return "Overlays";
+        case LayerCount:
+            break;
+    }
+    return {};
+}
+
+void FrameProfiler::beginFrame() {
+    if (!m_clock.isValid())
+        m_clock.start();
+    m_currentFrame = {};
+    m_currentFrame.timeUs = m_clock.nsecsElapsed() / 1000;
+    m_depth = 0;
+    s_current = this;
+    m_paintTimer.start();
+}
+
+void FrameProfiler::endFrame(const bool record) {
+    if (s_current == this)
+        s_current = nullptr;
+    if (!record)
+        return;
+
+    m_currentFrame.paintMs = static_cast<double>(m_paintTimer.nsecsElapsed()) / 1e6;
+    const auto startNs = m_currentFrame.timeUs * 1000;
+    // Gaps of a second or more are idle time rather than slow frames
+    if (m_lastFrameStartNs >= 0 && startNs - m_lastFrameStartNs < 1000000000)
+        m_currentFrame.intervalMs = static_cast<double>(startNs - m_lastFrameStartNs) / 1e6;
+    m_lastFrameStartNs = startNs;
+
+    m_frames[m_next] = m_currentFrame;
+    m_next = (m_next + 1) % m_frames.count();
+    m_count = qMin(m_count + 1, m_frames.count());
+}
+
+void FrameProfiler::clear() {
+    m_next = 0;
+    m_count = 0;
+    m_lastFrameStartNs = -1;
+    m_clock.invalidate();
+}
+
+qsizetype FrameProfiler::frameCount() const {
+    return m_count;
+}
+
+const FrameProfiler::Frame &FrameProfiler::lastFrame() const {
+    return frameAt(m_count - 1);
+}
+
+FrameProfiler::Percentiles FrameProfiler::paintTime() const {
+    return percentiles([](const Frame &frame) { return frame.paintMs; });
+}
+
+FrameProfiler::Percentiles FrameProfiler::frameInterval() const {
+    return percentiles([](const Frame &frame) { return frame.intervalMs; });
+}
+
+FrameProfiler::Percentiles FrameProfiler::layerTime(const Layer layer) const {
+    return percentiles([layer](const Frame &frame) { return frame.layerMs[layer]; });
+}
+
+bool FrameProfiler::saveTrace(const QString &path, const QString &viewName) const {
+    QJsonArray events;
+    events.append(QJsonObject{
+        {"name", "thread_name"},
+        {"ph",   "M"          },
+        {"pid",  1            },
+        {"tid",  1            },
+        {"args", QJsonObject{{"name", viewName}}}
+    });
+    for (qsizetype i = 0; i < m_count; i++) {
+        const auto &frame = frameAt(i);
+        events.append(QJsonObject{
+            {"name", "paint"                      },
+            {"ph",   "X"                          },
+            {"pid",  1                            },
+            {"tid",  1                            },
+            {"ts",   frame.timeUs                 },
+            {"dur",  frame.paintMs * 1000         },
+            {"args",
+             QJsonObject{{"items", frame.itemCount}, {"intervalMs", frame.intervalMs}}}
+        });
+        QJsonObject layers;
+        for (int layer = 0; layer < LayerCount; layer++)
+            layers.insert(layerName(static_cast<Layer>(layer)), frame.layerMs[layer]);
+        events.append(QJsonObject{
+            {"name", "layers (ms)"},
+            {"ph",   "C"          },
+            {"pid",  1            },
+            {"ts",   frame.timeUs },
+            {"args", layers       }
+        });
+    }
+
+    const QJsonObject trace{
+        {"traceEvents",     events                          },
+        {"displayTimeUnit", "ms"                            },
+        {"otherData",       QJsonObject{{"view", viewName}}}
+    };
+    QFileInfo(path).dir().mkpath(".");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) >= 0;
+}
+
+template <typename Getter>
+FrameProfiler::Percentiles FrameProfiler::percentiles(Getter get) const {
+    QList<double> values;
+    values.reserve(m_count);
+    // Frames without a value (the first frame after idle, a layer not painted) are left out
+    for (qsizetype i = 0; i < m_count; i++)
+        if (const auto value = get(frameAt(i)); value > 0)
+            values.append(value);
+    if (values.isEmpty())
+        return {};
+    std::sort(values.begin(), values.end());
+    // Nearest rank
+    auto at = [&](const double p) {
+        const auto rank = qCeil(p * static_cast<double>(values.count()));
+        return values.at(qBound(0, rank - 1, static_cast<int>(values.count()) - 1));
+    };
+    return {at(0.5), at(0.95), at(0.99)};
+}
+
+const FrameProfiler::Frame &FrameProfiler::frameAt(const qsizetype index) const {
+    // index 0 is the oldest recorded frame
+    const auto capacity = m_frames.count();
+    return m_frames.at((m_next - m_count + index + capacity) % capacity);
+}
@@ -0,0 +1,86 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+#include <array>
+
+// Records the paint time of the frames of a view in a ring buffer: the total paint time, the
+// interval to the previous frame, the number of items painted and the paint time spent in each
+// layer of items. Items report themselves with a Scope at the top of their paint(), which only
+// costs a pointer check while no profiled view is painting.
+class FrameProfiler {
+public:
+    enum Layer { Background, Clips, Notes, Curves, Overlays, LayerCount };
+
+    class Scope {
+    public:
+        explicit Scope(Layer layer);
+        ~Scope();
+        Q_DISABLE_COPY_MOVE(Scope)
+
+    private:
+        FrameProfiler *m_profiler;
+        Layer m_layer;
+        QElapsedTimer m_timer;
+    };
+
+    struct Frame {
+        qint64 timeUs = 0; // Start of the frame since the first recorded one
+        double paintMs = 0;
+        double intervalMs = 0;
+        int itemCount = 0;
+        std::array<double, LayerCount> layerMs = {};
+    };
+
+    struct Percentiles {
+        double p50 = 0;
+        double p95 = 0;
+        double p99 = 0;
+    };
+
+    explicit FrameProfiler(qsizetype capacity = 1024);
+
+    static QString layerName(Layer layer);
+
+    // Items painted between beginFrame() and endFrame() are attributed to this profiler.
+    // Frames that are not recorded (e.g. overlay only repaints) still count their items out.
+    void beginFrame();
+    void endFrame(bool record);
+    void clear();
+
+    [[nodiscard]] qsizetype frameCount() const;
+    [[nodiscard]] const Frame &lastFrame() const;
+    [[nodiscard]] Percentiles paintTime() const;
+    [[nodiscard]] Percentiles frameInterval() const;
+    [[nodiscard]] Percentiles layerTime(Layer layer) const;
+
+    // Writes the recorded frames in the Chrome trace event format, which chrome://tracing and
+    // Perfetto open. Returns false if the file could not be written.
+    bool saveTrace(const QString &path, const QString &viewName) const;
+
+private:
+    template <typename Getter>
+    [[nodiscard]] Percentiles percentiles(Getter get) const;
+    [[nodiscard]] const Frame &frameAt(qsizetype index) const;
+
+    static FrameProfiler *s_current;
+
+    QList<Frame> m_frames;
+    qsizetype m_next = 0;
+    qsizetype m_count = 0;
+
+    QElapsedTimer m_clock;
+    QElapsedTimer m_paintTimer;
+    qint64 m_lastFrameStartNs = -1;
+    Frame m_currentFrame;
+    int m_depth = 0;
+};
+
+#endif // FRAMEPROFILER_H
@@ -4,6 +4,7 @@
 
 #include "RubberBandView.h"
 
+#include "FrameProfiler.h"
 #include "TimeGraphicsScene.h"
 
 #include <QPainter>
@@ -37,6 +38,7 @@ void RubberBandView::setSelectMode(SelectMode mode) {
 
 void RubberBandView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                                    QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Overlays);
     painter->setRenderHint(QPainter::Antialiasing);
     const auto borderColor = QColor(255, 204, 153);
     const auto backgroundColor = QColor(255, 204, 153, 64);
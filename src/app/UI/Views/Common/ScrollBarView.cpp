@@ -4,6 +4,7 @@
 
 #include "ScrollBarView.h"
 
+#include "FrameProfiler.h"
 #include "TimeGraphicsScene.h"
 
 #include <QPainter>
@@ -89,6 +90,7 @@ void ScrollBarView::setHandlePadding(const QVariant &value) {
 
 void ScrollBarView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                                   QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Overlays);
     // if (m_pageStep >= (m_maximum - m_minimum))
     //     return;
 
@@ -0,0 +1,126 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "TextCache.h"
+
+#include <QCoreApplication>
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QtMath>
+
+LITE_SINGLETON_IMPLEMENT_INSTANCE(TextCache)
+
+size_t qHash(const TextCache::Key &key, const size_t seed) noexcept {
+    return qHashMulti(seed, key.text, key.font, key.devicePixelRatio, key.color);
+}
+
+TextCache::TextCache() {
+    // Pixmaps cost their size in KiB, sizes one each
+    m_pixmaps.setMaxCost(8 * 1024);
+    m_sizes.setMaxCost(4096);
+    // The instance is a function local static, pixmaps must not outlive the application
+    QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                     [this] { clear(); });
+}
+
+void TextCache::drawText(QPainter *painter, const QRectF &rect, const QString &text,
+                         const Qt::Alignment alignment) {
+    if (text.isEmpty() || rect.isEmpty())
+        return;
+    const auto cached = pixmap(painter, text);
+    if (!cached) {
+        painter->drawText(rect, static_cast<int>(alignment) | Qt::TextSingleLine, text);
+        return;
+    }
+
+    const auto size = cached->deviceIndependentSize();
+    auto x = rect.left();
+    if (alignment & Qt::AlignRight)
+        x = rect.right() - size.width();
+    else if (alignment & Qt::AlignHCenter)
+        x = rect.center().x() - size.width() / 2;
+    auto y = rect.top();
+    if (alignment & Qt::AlignBottom)
+        y = rect.bottom() - size.height();
+    else if (alignment & Qt::AlignVCenter)
+        y = rect.center().y() - size.height() / 2;
+
+    const auto target = QRectF(QPointF(x, y), size);
+    const auto visible = target.intersected(rect);
+    if (visible.isEmpty())
+        return;
+    const auto dpr = cached->devicePixelRatio();
+    const auto source = QRectF((visible.topLeft() - target.topLeft()) * dpr, visible.size() * dpr);
+    painter->drawPixmap(visible, *cached, source);
+}
+
+void TextCache::drawText(QPainter *painter, const QPointF &pos, const QString &text) {
+    if (text.isEmpty())
+        return;
+    if (const auto cached = pixmap(painter, text))
+        painter->drawPixmap(pos, *cached);
+    else
+        painter->drawText(QRectF(pos, textSize(painter->font(), text)), Qt::TextSingleLine, text);
+}
+
+QSizeF TextCache::textSize(const QFont &font, const QString &text) {
+    const Key key{text, font.key()};
+    if (const auto size = m_sizes.object(key)) {
+        m_sizeHitCount++;
+        return *size;
+    }
+    m_sizeMissCount++;
+    const auto size = QFontMetricsF(font).size(Qt::TextSingleLine, text);
+    m_sizes.insert(key, new QSizeF(size));
+    return size;
+}
+
+void TextCache::clear() {
+    m_pixmaps.clear();
+    m_sizes.clear();
+    m_pixmapHitCount = 0;
+    m_pixmapMissCount = 0;
+    m_sizeHitCount = 0;
+    m_sizeMissCount = 0;
+}
+
+TextCache::Stats TextCache::pixmapStats() const {
+    return {m_pixmaps.count(), m_pixmapHitCount, m_pixmapMissCount};
+}
+
+TextCache::Stats TextCache::sizeStats() const {
+    return {m_sizes.count(), m_sizeHitCount, m_sizeMissCount};
+}
+
+const QPixmap *TextCache::pixmap(const QPainter *painter, const QString &text) {
+    // Pixmaps rendered for one scale would be blurry at another
+    if (painter->transform().type() > QTransform::TxTranslate)
+        return nullptr;
+
+    const auto dpr = painter->device()->devicePixelRatio();
+    const Key key{text, painter->font().key(), dpr, painter->pen().color().rgba()};
+    if (const auto cached = m_pixmaps.object(key)) {
+        m_pixmapHitCount++;
+        return cached;
+    }
+    m_pixmapMissCount++;
+
+    const auto size = textSize(painter->font(), text);
+    const auto pixmap = new QPixmap(qCeil(size.width() * dpr), qCeil(size.height() * dpr));
+    pixmap->setDevicePixelRatio(dpr);
+    pixmap->fill(Qt::transparent);
+    QPainter cachePainter(pixmap);
+    cachePainter.setRenderHints(painter->renderHints());
+    cachePainter.setFont(painter->font());
+    cachePainter.setPen(painter->pen().color());
+    cachePainter.drawText(QRectF(QPointF(0, 0), size), Qt::TextSingleLine, text);
+    cachePainter.end();
+
+    const auto cost = qMax(1, static_cast<int>(static_cast<qint64>(pixmap->width()) *
+                                               pixmap->height() * 4 / 1024));
+    // QCache deletes the pixmap right away if it costs more than the whole cache
+    if (!m_pixmaps.insert(key, pixmap, cost))
+        return nullptr;
+    return m_pixmaps.object(key);
+}
@@ -0,0 +1,77 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "Utils/Singleton.h"
+
+#include <QCache>
+#include <QColor>
+#include <QFont>
+#include <QPixmap>
+#include <QString>
+
+class QPainter;
+
+// Shared least recently used cache of rendered single line text, so that the lyrics, phonemes and
+// pronunciations of the piano roll are shaped once instead of on every repaint. Entries are keyed
+// by text, font, device pixel ratio and color, the measured sizes by text and font only.
+class TextCache {
+public:
+    LITE_SINGLETON_DECLARE_INSTANCE(TextCache)
+    Q_DISABLE_COPY_MOVE(TextCache)
+
+    // Draws text with the font and pen color of painter, aligned in rect and clipped to it.
+    // Painters with a scaling transform draw the text directly.
+    void drawText(QPainter *painter, const QRectF &rect, const QString &text,
+                  Qt::Alignment alignment = Qt::AlignLeft | Qt::AlignTop);
+    // Draws text with its top left at pos, without clipping
+    void drawText(QPainter *painter, const QPointF &pos, const QString &text);
+    // Same as QFontMetricsF::size() with Qt::TextSingleLine
+    QSizeF textSize(const QFont &font, const QString &text);
+
+    class Stats {
+    public:
+        qsizetype count = 0;
+        quint64 hitCount = 0;
+        quint64 missCount = 0;
+
+        // In percent, 0 before the first lookup
+        [[nodiscard]] double hitRate() const {
+            const auto lookups = hitCount + missCount;
+            return lookups > 0 ? 100.0 * static_cast<double>(hitCount) / lookups : 0;
+        }
+    };
+
+    void clear();
+    [[nodiscard]] Stats pixmapStats() const;
+    [[nodiscard]] Stats sizeStats() const;
+
+private:
+    TextCache();
+    ~TextCache() = default;
+
+    struct Key {
+        QString text;
+        QString font;
+        qreal devicePixelRatio = 1;
+        QRgb color = 0;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    friend size_t qHash(const Key &key, size_t seed) noexcept;
+
+    const QPixmap *pixmap(const QPainter *painter, const QString &text);
+
+    QCache<Key, QPixmap> m_pixmaps;
+    QCache<Key, QSizeF> m_sizes;
+    quint64 m_pixmapHitCount = 0;
+    quint64 m_pixmapMissCount = 0;
+    quint64 m_sizeHitCount = 0;
+    quint64 m_sizeMissCount = 0;
+};
+
+#endif // TEXTCACHE_H
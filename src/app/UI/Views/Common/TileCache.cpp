@@ -0,0 +1,118 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "TileCache.h"
+
+#include <QCoreApplication>
+#include <QPainter>
+#include <QtMath>
+
+size_t qHash(const TileCache::Key &key, const size_t seed) noexcept {
+    return qHashMulti(seed, key.owner, key.index);
+}
+
+QCache<TileCache::Key, QPixmap> &TileCache::tiles() {
+    static QCache<Key, QPixmap> cache(maxTotalCostKiB);
+    // Pixmaps must not outlive the application
+    static const auto connection =
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         [] { cache.clear(); });
+    Q_UNUSED(connection)
+    return cache;
+}
+
+template <typename Pred>
+void TileCache::removeTiles(Pred pred) {
+    auto &cache = tiles();
+    for (const auto &key : cache.keys())
+        if (key.owner == this && pred(key.index))
+            cache.remove(key);
+}
+
+TileCache::~TileCache() {
+    invalidate();
+}
+
+void TileCache::setLayout(const double zoom, const double top, const double height) {
+    if (qFuzzyCompare(zoom, m_zoom) && qFuzzyCompare(top + 1, m_top + 1) &&
+        qFuzzyCompare(height + 1, m_height + 1))
+        return;
+    m_zoom = zoom;
+    m_top = top;
+    m_height = height;
+    invalidate();
+}
+
+void TileCache::invalidate() {
+    removeTiles([](qint64) { return true; });
+}
+
+void TileCache::invalidate(const double left, const double right) {
+    const auto first = static_cast<qint64>(qFloor(qMin(left, right) / tileWidth));
+    const auto last = static_cast<qint64>(qFloor(qMax(left, right) / tileWidth));
+    removeTiles([first, last](const qint64 index) { return index >= first && index <= last; });
+}
+
+void TileCache::draw(QPainter *painter, const QRectF &target, const double contentLeft,
+                     const Renderer &render) {
+    if (target.width() <= 0 || target.height() <= 0)
+        return;
+
+    const auto dpr = painter->device()->devicePixelRatio();
+    const auto tileHeight = qCeil(target.height());
+    if (!qFuzzyCompare(dpr, m_devicePixelRatio) || tileHeight != m_tileHeight) {
+        invalidate();
+        m_devicePixelRatio = dpr;
+        m_tileHeight = tileHeight;
+    }
+
+    const auto first = static_cast<qint64>(qFloor(contentLeft / tileWidth));
+    const auto last = static_cast<qint64>(qFloor((contentLeft + target.width()) / tileWidth));
+
+    auto &cache = tiles();
+    painter->save();
+    painter->setClipRect(target, Qt::IntersectClip);
+    for (auto index = first; index <= last; index++) {
+        const auto x = target.left() + static_cast<double>(index) * tileWidth - contentLeft;
+        const Key key{this, index};
+        if (const auto cached = cache.object(key)) {
+            m_hitCount++;
+            painter->drawPixmap(QPointF(x, target.top()), *cached);
+            continue;
+        }
+        m_missCount++;
+        const double left = static_cast<double>(index) * tileWidth;
+        QPixmap pixmap(qCeil(tileWidth * dpr), qCeil(tileHeight * dpr));
+        pixmap.setDevicePixelRatio(dpr);
+        pixmap.fill(Qt::transparent);
+        QPainter tilePainter(&pixmap);
+        tilePainter.setRenderHints(painter->renderHints());
+        tilePainter.setFont(painter->font());
+        tilePainter.translate(-left, 0);
+        render(&tilePainter, left, tileWidth);
+        tilePainter.end();
+        painter->drawPixmap(QPointF(x, target.top()), pixmap);
+        // Pixmaps cost their size in KiB. Inserting may evict tiles drawn earlier in this loop.
+        const auto cost = qMax(1, static_cast<int>(static_cast<qint64>(pixmap.width()) *
+                                                   pixmap.height() * 4 / 1024));
+        cache.insert(key, new QPixmap(pixmap), cost);
+    }
+    painter->restore();
+}
+
+qsizetype TileCache::tileCount() const {
+    qsizetype count = 0;
+    for (const auto &key : tiles().keys())
+        if (key.owner == this)
+            count++;
+    return count;
+}
+
+quint64 TileCache::hitCount() const {
+    return m_hitCount;
+}
+
+quint64 TileCache::missCount() const {
+    return m_missCount;
+}
@@ -0,0 +1,75 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include <functional>
+
+#include <QCache>
+#include <QPixmap>
+
+class QPainter;
+
+// Caches the rendering of a horizontally scrolling layer in fixed width tiles, so that scrolling
+// and repaints caused by other items (e.g. the playhead) only blit pixmaps. Tiles are addressed in
+// content x, a logical pixel coordinate chosen by the layer (scene x for full width layers, the
+// position in the audio file for a clip), and are only valid for the layout they were rendered
+// with. Model changes drop the tiles of the changed range only.
+// The tiles of all caches share one least recently used store with a memory budget, so the
+// number of clips and views does not multiply the memory used.
+class TileCache {
+public:
+    // Renders the content in [left, left + width) of content x. The painter is translated so that
+    // content x can be used as is, y is the one of the target rect.
+    using Renderer = std::function<void(QPainter *painter, double left, double width)>;
+
+    static constexpr int tileWidth = 256;
+    // Of the tiles of all caches together
+    static constexpr int maxTotalCostKiB = 64 * 1024;
+
+    TileCache() = default;
+    ~TileCache();
+    Q_DISABLE_COPY_MOVE(TileCache)
+
+    // zoom is the content pixels per time unit, top and height describe the vertical mapping.
+    // Any change drops all tiles.
+    void setLayout(double zoom, double top, double height);
+    void invalidate();
+    // Drops the tiles overlapping [left, right] of content x
+    void invalidate(double left, double right);
+
+    // Fills target with the content starting at contentLeft, rendering the missing tiles
+    void draw(QPainter *painter, const QRectF &target, double contentLeft, const Renderer &render);
+
+    // Tiles of this cache still in the shared store
+    [[nodiscard]] qsizetype tileCount() const;
+    [[nodiscard]] quint64 hitCount() const;
+    [[nodiscard]] quint64 missCount() const;
+
+private:
+    struct Key {
+        const TileCache *owner = nullptr;
+        qint64 index = 0;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    friend size_t qHash(const Key &key, size_t seed) noexcept;
+
+    static QCache<Key, QPixmap> &tiles();
+    // Removes the tiles of this cache for which pred(index) is true
+    template <typename Pred>
+    void removeTiles(Pred pred);
+
+    double m_zoom = 0;
+    double m_top = 0;
+    double m_height = 0;
+    qreal m_devicePixelRatio = 0;
+    int m_tileHeight = 0;
+    quint64 m_hitCount = 0;
+    quint64 m_missCount = 0;
+};
+
+#endif // TILECACHE_H
@@ -113,6 +113,13 @@ void TimeGraphicsScene::setVerticalBarVisibility(bool visible) {
     }
 }
 
+void TimeGraphicsScene::setScrollBarsVisibleRect(const QRectF &rect) {
+    if (m_hBarAdded)
+        m_hBar.setVisibleRect(rect);
+    if (m_vBarAdded)
+        m_vBar.setVisibleRect(rect);
+}
+
 void TimeGraphicsScene::setSceneLength(int tick) {
     setSceneBaseSize(QSizeF(tick * m_pixelsPerQuarterNote / 480.0, sceneBaseSize().height()));
 }
@@ -44,6 +44,8 @@ private:
     [[nodiscard]] ScrollBarView *verticalBar();
     void setHorizontalBarVisibility(bool visible);
     void setVerticalBarVisibility(bool visible);
+    // Moves the scroll bars to rect, leaving the other items laid out for visibleRect()
+    void setScrollBarsVisibleRect(const QRectF &rect);
     void setSceneLength(int tick);
     using QGraphicsScene::addItem;
     using QGraphicsScene::removeItem;
@@ -4,14 +4,21 @@
 
 #include "TimeGraphicsView.h"
 
+#include <QFileDialog>
+#include <QPainter>
+#include <QScreen>
 #include <QScrollBar>
+#include <QStandardPaths>
 #include <QWheelEvent>
 
+#include "TextCache.h"
 #include "TimeGraphicsScene.h"
 #include "TimeGridView.h"
 #include "TimeIndicatorView.h"
+#include "Controller/PlaybackController.h"
 #include "Model/AppStatus/AppStatus.h"
 #include "Model/AppOptions/AppOptions.h"
+#include "UI/Controls/Toast.h"
 
 #if defined(Q_OS_MAC) && QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 #  define SUPPORTS_MOUSEWHEEL_DETECT_NATIVE
@@ -71,8 +78,8 @@ TimeGraphicsView::TimeGraphicsView(TimeGraphicsScene *scene, bool showLastPlayba
     });
 #endif
 
-    connect(this, &TimeGraphicsView::visibleRectChanged,
-            [this](const QRectF &rect) { m_scene->setVisibleRect(rect); });
+    connect(this, &TimeGraphicsView::visibleRectChanged, this,
+            &TimeGraphicsView::updateSceneVisibleRect);
     connect(this, &TimeGraphicsView::scaleChanged,
             [this](double sx, double sy) { m_scene->setScaleXY(sx, sy); });
     connect(m_scene, &TimeGraphicsScene::baseSizeChanged, this,
@@ -103,6 +110,26 @@ TimeGraphicsView::TimeGraphicsView(TimeGraphicsScene *scene, bool showLastPlayba
             [this] { emit timeRangeChanged(startTick(), endTick()); });
     connect(this, &TimeGraphicsView::visibleRectChanged, this,
             [this] { emit timeRangeChanged(startTick(), endTick()); });
+
+    setShowFrameTime(appOptions->appearance()->showFrameTime);
+    m_smoothPlaybackFollow = appOptions->appearance()->smoothPlaybackFollow;
+    connect(appOptions, &AppOptions::optionsChanged, this,
+            [this](const AppOptionsGlobal::Option option) {
+                if (option != AppOptionsGlobal::All && option != AppOptionsGlobal::Appearance)
+                    return;
+                setShowFrameTime(appOptions->appearance()->showFrameTime);
+                m_smoothPlaybackFollow = appOptions->appearance()->smoothPlaybackFollow;
+            });
+
+    m_playheadTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_playheadTimer, &QTimer::timeout, this, [this] {
+        if (isVisible())
+            showPlaybackPosition(playbackController->interpolatedPosition());
+    });
+    connect(playbackController, &PlaybackController::playbackStatusChanged, this,
+            [this](const PlaybackStatus status) {
+                status == Playing ? startPlayheadTimer() : stopPlayheadTimer();
+            });
 }
 
 TimeGraphicsScene *TimeGraphicsView::scene() {
@@ -122,6 +149,12 @@ void TimeGraphicsView::setGridItem(TimeGridView *item) {
 
 void TimeGraphicsView::setSceneVisibility(bool on) {
     setScene(on ? m_scene : nullptr);
+    updateViewportOpaque();
+}
+
+void TimeGraphicsView::setSceneFillsViewport(const bool on) {
+    m_sceneFillsViewport = on;
+    updateViewportOpaque();
 }
 
 qreal TimeGraphicsView::scaleXMax() const {
@@ -406,6 +439,36 @@ bool TimeGraphicsView::event(QEvent *event) {
     return QGraphicsView::event(event);
 }
 
+bool TimeGraphicsView::viewportEvent(QEvent *event) {
+    // Handled before the subclasses see the press, whatever their edit mode is
+    if (m_showFrameTime && event->type() == QEvent::MouseButtonPress) {
+        const auto mouseEvent = static_cast<QMouseEvent *>(event);
+        if (mouseEvent->button() == Qt::LeftButton &&
+            frameTimeRect().contains(mouseEvent->position().toPoint())) {
+            saveFrameTrace();
+            return true;
+        }
+    }
+    return QGraphicsView::viewportEvent(event);
+}
+
+void TimeGraphicsView::paintEvent(QPaintEvent *event) {
+    if (!m_showFrameTime) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+
+    // Repaints of the overlay alone are not frames of the view
+    const bool overlayOnly = frameTimeRect().contains(event->rect());
+    m_profiler.beginFrame();
+    QGraphicsView::paintEvent(event);
+    m_profiler.endFrame(!overlayOnly);
+    drawFrameTime();
+    // The frame may not have covered the overlay
+    if (!overlayOnly)
+        viewport()->update(frameTimeRect());
+}
+
 void TimeGraphicsView::wheelEvent(QWheelEvent *event) {
     if (event->modifiers() == Qt::ControlModifier) {
         onWheelHorScale(event);
@@ -541,6 +604,13 @@ void TimeGraphicsView::mouseReleaseEvent(QMouseEvent *event) {
     QGraphicsView::mouseReleaseEvent(event);
 }
 
+void TimeGraphicsView::scrollContentsBy(const int dx, const int dy) {
+    QGraphicsView::scrollContentsBy(dx, dy);
+    // The frame time overlay is fixed to the viewport, repaint where the blit moved it to
+    if (m_showFrameTime)
+        viewport()->update(frameTimeRect().translated(dx, dy));
+}
+
 bool TimeGraphicsView::isMouseEventFromWheel(QWheelEvent *event) {
 #ifdef SUPPORTS_MOUSEWHEEL_DETECT_NATIVE
     return event->deviceType() == QInputDevice::DeviceType::Mouse;
@@ -638,6 +708,139 @@ void TimeGraphicsView::handleHoverMoveEvent(QHoverEvent *event) {
     }
 }
 
+QRect TimeGraphicsView::frameTimeRect() const {
+    // Paint, frame interval, one line per layer, items, text pixmaps, text sizes and the hint
+    constexpr int lineCount = FrameProfiler::LayerCount + 6;
+    constexpr int width = 280;
+    constexpr int padding = 4;
+    constexpr int margin = 8;
+    const auto height = lineCount * viewport()->fontMetrics().height() + 2 * padding;
+    return {viewport()->width() - width - margin, margin, width, height};
+}
+
+void TimeGraphicsView::drawFrameTime() {
+    constexpr int padding = 4;
+    auto percentilesText = [](const FrameProfiler::Percentiles &p) {
+        return QString("p50 %1  p95 %2  p99 %3 ms")
+            .arg(p.p50, 0, 'f', 2)
+            .arg(p.p95, 0, 'f', 2)
+            .arg(p.p99, 0, 'f', 2);
+    };
+
+    QStringList lines;
+    lines.append("paint   " + percentilesText(m_profiler.paintTime()));
+    const auto interval = m_profiler.frameInterval();
+    const auto fps = interval.p50 > 0 ? 1000 / interval.p50 : 0;
+    lines.append("frame   " + percentilesText(interval) + QString("  %1 fps").arg(fps, 0, 'f', 0));
+    for (int layer = 0; layer < FrameProfiler::LayerCount; layer++) {
+        const auto name = FrameProfiler::layerName(static_cast<FrameProfiler::Layer>(layer));
+        lines.append(QString("%1 ").arg(name, -8) +
+                     percentilesText(m_profiler.layerTime(static_cast<FrameProfiler::Layer>(layer))));
+    }
+    const auto items = m_profiler.frameCount() > 0 ? m_profiler.lastFrame().itemCount : 0;
+    lines.append(QString("items %1  frames %2").arg(items).arg(m_profiler.frameCount()));
+    auto cacheText = [](const char *name, const TextCache::Stats &stats) {
+        return QString("%1 hit %2%  entries %3")
+            .arg(name)
+            .arg(stats.hitRate(), 0, 'f', 1)
+            .arg(stats.count);
+    };
+    lines.append(cacheText("text pixmaps", TextCache::instance()->pixmapStats()));
+    lines.append(cacheText("text sizes  ", TextCache::instance()->sizeStats()));
+    lines.append(tr("Click to save a trace"));
+
+    QPainter painter(viewport());
+    const auto rect = frameTimeRect();
+    painter.fillRect(rect, QColor(0, 0, 0, 160));
+    painter.setPen(QColor(255, 255, 255));
+    painter.drawText(rect.adjusted(padding, padding, -padding, -padding),
+                     Qt::AlignLeft | Qt::AlignTop, lines.join('\n'));
+}
+
+void TimeGraphicsView::saveFrameTrace() {
+    const auto defaultPath =
+        QStandardPaths::standardLocations(QStandardPaths::AppDataLocation).first() +
+        QString("/Diagnostics/frames-%1.json").arg(objectName());
+    const auto path = QFileDialog::getSaveFileName(this, tr("Save frame trace"), defaultPath,
+                                                   tr("JSON Files (*.json)"));
+    if (path.isEmpty())
+        return;
+    if (m_profiler.saveTrace(path, objectName()))
+        Toast::show(tr("Frame trace saved"));
+    else
+        Toast::show(tr("Failed to save frame trace"));
+}
+
+void TimeGraphicsView::updateSceneVisibleRect(const QRectF &rect) {
+    if (!m_playheadTimer.isActive()) {
+        m_anchoredVisibleRect = QRectF();
+        m_scene->setVisibleRect(rect);
+        return;
+    }
+
+    // While playing, the items are laid out for one more screen ahead of the view. Following the
+    // playhead then moves none of them, so the viewport is scrolled by blitting and only the strip
+    // scrolled into view and the playhead are repainted.
+    const bool sameRows = rect.top() == m_anchoredVisibleRect.top() &&
+                          rect.bottom() == m_anchoredVisibleRect.bottom();
+    if (!sameRows || !m_anchoredVisibleRect.contains(rect)) {
+        m_anchoredVisibleRect = rect;
+        m_anchoredVisibleRect.setRight(
+            qMax(rect.right(), qMin(rect.right() + rect.width(), sceneRect().right())));
+        m_scene->setVisibleRect(m_anchoredVisibleRect);
+    }
+    m_scene->setScrollBarsVisibleRect(rect);
+}
+
+void TimeGraphicsView::updateViewportOpaque() {
+    // Qt only scrolls opaque widgets by blitting
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent,
+                             m_sceneFillsViewport && QGraphicsView::scene() != nullptr);
+}
+
+void TimeGraphicsView::startPlayheadTimer() {
+    // As often as the screen refreshes
+    const auto refreshRate = screen() ? screen()->refreshRate() : 60;
+    m_playheadTimer.setInterval(qBound(4, qRound(1000 / refreshRate), 33));
+    m_playheadTimer.start();
+    updateSceneVisibleRect(visibleRect());
+}
+
+void TimeGraphicsView::stopPlayheadTimer() {
+    if (!m_playheadTimer.isActive())
+        return;
+    m_playheadTimer.stop();
+    updateSceneVisibleRect(visibleRect());
+    showPlaybackPosition(m_playbackPosition);
+}
+
+void TimeGraphicsView::showPlaybackPosition(const double tick) {
+    if (m_scenePlayPosIndicator != nullptr)
+        m_scenePlayPosIndicator->setPosition(tick);
+
+    if (!m_autoTurnPage || appStatus->currentEditObject != AppStatus::EditObjectType::None)
+        return;
+
+    if (m_smoothPlaybackFollow && m_playheadTimer.isActive())
+        followPlaybackPosition(tick);
+    else if (tick > endTick())
+        pageAdd();
+    else if (tick < startTick())
+        setViewportStartTick(tick);
+}
+
+void TimeGraphicsView::followPlaybackPosition(const double tick) {
+    // Keep the playhead in the middle of the view once it gets there. Whole pixel steps keep the
+    // scroll a blit.
+    const auto x = tickToSceneX(tick - m_offset);
+    const auto rect = visibleRect();
+    const auto target = qRound(x - rect.width() / 2);
+    if (x < rect.left() || x > rect.right() || target > horizontalBarValue()) {
+        m_hBarAnimation.stop();
+        setHorizontalBarValue(target);
+    }
+}
+
 ScrollBarView *TimeGraphicsView::scrollBarAt(const QPoint &pos) {
     if (!scene())
         return nullptr;
@@ -695,16 +898,9 @@ void TimeGraphicsView::setSceneLength(int tick) const {
 
 void TimeGraphicsView::setPlaybackPosition(double tick) {
     m_playbackPosition = tick;
-    if (m_scenePlayPosIndicator != nullptr)
-        m_scenePlayPosIndicator->setPosition(tick);
-
-    if (!m_autoTurnPage || appStatus->currentEditObject != AppStatus::EditObjectType::None)
-        return;
-
-    if (m_playbackPosition > endTick()) {
-        pageAdd();
-    } else if (m_playbackPosition < startTick())
-        setViewportStartTick(m_playbackPosition);
+    // While playing, the playhead timer moves the indicator at the display rate
+    if (!m_playheadTimer.isActive())
+        showPlaybackPosition(tick);
 }
 
 void TimeGraphicsView::setLastPlaybackPosition(double tick) {
@@ -719,6 +915,18 @@ void TimeGraphicsView::setViewportStartTick(double tick) {
     horizontalBarAnimateTo(sceneX);
 }
 
+bool TimeGraphicsView::showFrameTime() const {
+    return m_showFrameTime;
+}
+
+void TimeGraphicsView::setShowFrameTime(const bool on) {
+    if (m_showFrameTime == on)
+        return;
+    m_showFrameTime = on;
+    m_profiler.clear();
+    viewport()->update();
+}
+
 void TimeGraphicsView::setViewportCenterAtTick(double tick) {
     auto tickRange = endTick() - startTick();
     auto targetStart = tick - tickRange / 2;
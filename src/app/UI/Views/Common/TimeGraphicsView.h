@@ -5,6 +5,7 @@
 #ifndef TIMEGRAPHICSVIEW_H
 #define TIMEGRAPHICSVIEW_H
 
+#include "FrameProfiler.h"
 #include "RubberBandView.h"
 #include "UI/Utils/IAnimatable.h"
 #include "UI/Utils/IScalable.h"
@@ -37,6 +38,8 @@ public:
     TimeGraphicsScene *scene();
     void setGridItem(TimeGridView *item);
     void setSceneVisibility(bool on);
+    // The scene paints every pixel of the viewport, which lets Qt scroll it by blitting
+    void setSceneFillsViewport(bool on);
     [[nodiscard]] double scaleXMax() const;
     void setScaleXMax(double max);
     [[nodiscard]] double scaleYMin() const;
@@ -61,6 +64,8 @@ public:
     void setAutoTurnPage(bool on);
     void setViewportStartTick(double tick);
     void setViewportCenterAtTick(double tick);
+    [[nodiscard]] bool showFrameTime() const;
+    void setShowFrameTime(bool on);
 
 signals:
     void scaleChanged(double sx, double sy);
@@ -87,11 +92,14 @@ protected:
     void dragMoveEvent(QDragMoveEvent *event) override;
     void dragLeaveEvent(QDragLeaveEvent *event) override;
     bool event(QEvent *event) override;
+    bool viewportEvent(QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
     void wheelEvent(QWheelEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
     void afterSetScale() override;
     void afterSetAnimationLevel(AnimationGlobal::AnimationLevels level) override;
     void afterSetTimeScale(double scale) override;
@@ -119,7 +127,17 @@ private:
     void handleHoverLeaveEvent(QHoverEvent *event);
     void handleHoverMoveEvent(QHoverEvent *event);
 
+    void updateSceneVisibleRect(const QRectF &rect);
+    void updateViewportOpaque();
+    void startPlayheadTimer();
+    void stopPlayheadTimer();
+    void showPlaybackPosition(double tick);
+    void followPlaybackPosition(double tick);
+
     [[nodiscard]] ScrollBarView *scrollBarAt(const QPoint &pos);
+    [[nodiscard]] QRect frameTimeRect() const;
+    void drawFrameTime();
+    void saveFrameTrace();
 
     double m_hZoomingStep = 0.4;
     double m_vZoomingStep = 0.3;
@@ -162,6 +180,13 @@ private:
     bool m_autoTurnPage = true;
     double m_playbackPosition = 0;
     double m_lastPlaybackPosition = 0;
+    bool m_smoothPlaybackFollow = false;
+    QTimer m_playheadTimer;
+    QRectF m_anchoredVisibleRect;
+    bool m_sceneFillsViewport = false;
+
+    bool m_showFrameTime = false;
+    FrameProfiler m_profiler;
 
     QColor m_barLineColor = {8, 9, 10};
     QColor m_beatLineColor = {22, 25, 28};
@@ -4,6 +4,7 @@
 
 #include "TimeGridView.h"
 
+#include "FrameProfiler.h"
 #include "Model/AppModel/AppModel.h"
 #include "Model/AppStatus/AppStatus.h"
 
@@ -47,21 +48,34 @@ double TimeGridView::endTick() const {
 
 void TimeGridView::setTimeSignature(int numerator, int denominator) {
     ITimelinePainter::setTimeSignature(numerator, denominator);
+    m_tileCache.invalidate();
     update();
 }
 
 void TimeGridView::setQuantize(int quantize) {
     ITimelinePainter::setQuantize(quantize);
+    m_tileCache.invalidate();
     update();
 }
 
 void TimeGridView::setOffset(int tick) {
     m_offset = tick;
+    m_tileCache.invalidate();
     update();
 }
 
 void TimeGridView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                          QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Background);
+    // Lines are laid out in scene x, so scrolling only blits the cached tiles
+    m_tileCache.setLayout(scaleX() * pixelsPerQuarterNote(), 0, rect().height());
+    m_tileCache.draw(painter, rect(), visibleRect().left(),
+                     [this](QPainter *tilePainter, const double left, const double width) {
+                         renderTile(tilePainter, left, width);
+                     });
+}
+
+void TimeGridView::renderTile(QPainter *painter, const double left, const double width) {
     auto penWidth = 1;
 
     QPen pen;
@@ -70,7 +84,10 @@ void TimeGridView::paint(QPainter *painter, const QStyleOptionGraphicsItem *opti
     pen.setColor(m_commonLineColor);
     painter->setPen(pen);
     // painter->setRenderHint(QPainter::Antialiasing);
-    drawTimeline(painter, startTick(), endTick(), visibleRect().width());
+    // Include the lines on the tile borders, which are drawn half on each tile
+    const auto start = sceneXToTick(left - penWidth) + m_offset;
+    const auto end = sceneXToTick(left + width + penWidth) + m_offset;
+    drawTimeline(painter, start, end, width + 2 * penWidth);
 }
 
 void TimeGridView::updateRectAndPos() {
@@ -82,33 +99,33 @@ void TimeGridView::updateRectAndPos() {
 
 void TimeGridView::drawBar(QPainter *painter, int tick, int bar) {
     QPen pen;
-    auto x = sceneXToItemX(tickToSceneX(tick - m_offset));
+    auto x = tickToSceneX(tick - m_offset);
     // pen.setColor(barTextColor);
     // painter->setPen(pen);
     // painter->drawText(QPointF(x, 10), QString::number(bar));
     pen.setColor(m_barLineColor);
     painter->setPen(pen);
-    painter->drawLine(QLineF(x, 0, x, visibleRect().height()));
+    painter->drawLine(QLineF(x, 0, x, rect().height()));
 }
 
 void TimeGridView::drawBeat(QPainter *painter, int tick, int bar, int beat) {
     QPen pen;
-    auto x = sceneXToItemX(tickToSceneX(tick - m_offset));
+    auto x = tickToSceneX(tick - m_offset);
     // pen.setColor(beatTextColor);
     // painter->setPen(pen);
     // painter->drawText(QPointF(x, 10), QString::number(bar) + "." + QString::number(beat));
     pen.setColor(m_beatLineColor);
     painter->setPen(pen);
-    painter->drawLine(QLineF(x, 0, x, visibleRect().height()));
+    painter->drawLine(QLineF(x, 0, x, rect().height()));
 }
 
 void TimeGridView::drawSubdivision(QPainter *painter, int tick, int level, int levelCount) {
     QPen pen;
-    auto x = sceneXToItemX(tickToSceneX(tick - m_offset));
+    auto x = tickToSceneX(tick - m_offset);
     const double ratio = levelCount > 1 ? static_cast<double>(level) / (levelCount - 1) : 0.0;
     pen.setColor(blendColor(m_beatLineColor, m_commonLineColor, ratio));
     painter->setPen(pen);
-    painter->drawLine(QLineF(x, 0, x, visibleRect().height()));
+    painter->drawLine(QLineF(x, 0, x, rect().height()));
 }
 
 QColor TimeGridView::barLineColor() const {
@@ -117,6 +134,7 @@ QColor TimeGridView::barLineColor() const {
 
 void TimeGridView::setBarLineColor(const QColor &color) {
     m_barLineColor = color;
+    m_tileCache.invalidate();
     update();
 }
 
@@ -126,6 +144,7 @@ QColor TimeGridView::beatLineColor() const {
 
 void TimeGridView::setBeatLineColor(const QColor &color) {
     m_beatLineColor = color;
+    m_tileCache.invalidate();
     update();
 }
 
@@ -135,6 +154,7 @@ QColor TimeGridView::commonLineColor() const {
 
 void TimeGridView::setCommonLineColor(const QColor &color) {
     m_commonLineColor = color;
+    m_tileCache.invalidate();
     update();
 }
 
@@ -145,7 +165,3 @@ double TimeGridView::sceneXToTick(double pos) const {
 double TimeGridView::tickToSceneX(double tick) const {
     return tick * scaleX() * pixelsPerQuarterNote() / 480;
 }
-
-double TimeGridView::sceneXToItemX(double x) const {
-    return mapFromScene(QPointF(x, 0)).x();
-}
@@ -6,6 +6,7 @@
 #define TIMEGRIDVIEW_H
 
 #include "AbstractGraphicsRectItem.h"
+#include "TileCache.h"
 #include "UI/Utils/ITimelinePainter.h"
 
 class TimeGridView : public AbstractGraphicsRectItem, public ITimelinePainter {
@@ -47,8 +48,9 @@ private:
     [[nodiscard]] double endTick() const;
     [[nodiscard]] double sceneXToTick(double pos) const;
     [[nodiscard]] double tickToSceneX(double tick) const;
-    [[nodiscard]] double sceneXToItemX(double x) const;
+    void renderTile(QPainter *painter, double left, double width);
 
+    TileCache m_tileCache;
     int m_offset = 0;
     QColor m_barLineColor = {8, 9, 10};
     QColor m_beatLineColor = {22, 25, 28};
@@ -17,6 +17,7 @@
 #include "Modules/History/HistoryManager.h"
 #include "UI/Controls/Toast.h"
 #include "UI/Dialogs/Audio/AudioExportDialog.h"
+#include "UI/Dialogs/Diagnostics/InferTelemetryDialog.h"
 #include "UI/Dialogs/Extractor/ExtractPitchParamDialog.h"
 #include "UI/Dialogs/Options/AppOptionsDialog.h"
 #include "UI/Window/MainWindow.h"
@@ -493,11 +494,17 @@ CMenu *MainMenuViewPrivate::buildHelpMenu() {
     auto actionCheckForUpdates = new QAction(tr("Check for updates"), this);
     connect(actionCheckForUpdates, &QAction::triggered, this,
             [=] { Toast::show(tr("You are already up to date")); });
+    auto actionInferDiagnostics = new QAction(tr("Inference diagnostics..."), this);
+    connect(actionInferDiagnostics, &QAction::triggered, this, [] {
+        InferTelemetryDialog dialog;
+        dialog.exec();
+    });
     auto actionAbout = new QAction(tr("About..."), this);
     connect(actionAbout, &QAction::triggered, this, [] { Toast::show(tr("About")); });
 
     auto menuHelp = new CMenu(tr("&Help"), q);
     menuHelp->addAction(actionCheckForUpdates);
+    menuHelp->addAction(actionInferDiagnostics);
     menuHelp->addAction(actionAbout);
     return menuHelp;
 }
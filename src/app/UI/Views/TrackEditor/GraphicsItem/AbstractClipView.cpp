@@ -7,6 +7,7 @@
 #include "Global/AppGlobal.h"
 #include "Global/TracksEditorGlobal.h"
 #include "UI/Controls/Menu.h"
+#include "UI/Views/Common/FrameProfiler.h"
 
 #include <QGraphicsSceneMouseEvent>
 #include <QKeyEvent>
@@ -182,6 +183,7 @@ QString AbstractClipView::text() const {
 
 void AbstractClipView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                              QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Clips);
     Q_D(const AbstractClipView);
     constexpr auto colorPrimary = QColor(155, 186, 255);
     constexpr auto colorPrimaryTransparent = QColor(155, 186, 255, 64);
@@ -4,8 +4,8 @@
 
 #include "AudioClipView.h"
 
-#include <QElapsedTimer>
 #include <QPainter>
+#include <QtMath>
 #include <QThread>
 #include <QFileDialog>
 
@@ -32,6 +32,7 @@ void AudioClipView::setTempo(const double tempo) {
 
 void AudioClipView::setAudioInfo(const AudioInfoModel &info) {
     m_audioInfo = info;
+    m_tileCache.invalidate();
     update();
 }
 
@@ -56,121 +57,76 @@ void AudioClipView::onTempoChange(const double tempo) {
 
 void AudioClipView::drawPreviewArea(QPainter *painter, const QRectF &previewRect,
                                     const QColor color) {
-    QElapsedTimer mstimer;
-    mstimer.start();
-    
-    // Get device pixel ratio for high DPI support
-    const qreal devicePixelRatio = painter->device()->devicePixelRatio();
-    
-    // Create off-screen pixmap with correct device pixel ratio
-    const int pixmapWidth = static_cast<int>(previewRect.width() * devicePixelRatio);
-    const int pixmapHeight = static_cast<int>(previewRect.height() * devicePixelRatio);
-    
-    QPixmap pixmap(pixmapWidth, pixmapHeight);
-    pixmap.setDevicePixelRatio(1);
-    pixmap.fill(Qt::transparent);
-
-    QPainter pixmapPainter(&pixmap);
-    pixmapPainter.setRenderHint(QPainter::Antialiasing, false);
-
-    const auto rectTop = 0;
-    const auto rectWidth = previewRect.width() * devicePixelRatio;
-    const auto rectHeight = previewRect.height() * devicePixelRatio;
-    const auto halfRectHeight = rectHeight / 2;
-
     QPen pen;
-
+    pen.setColor(color);
     if (m_status == AppGlobal::Loading) {
-        pen.setColor(color);
-        pixmapPainter.setPen(pen);
-        pixmapPainter.drawText(QRectF(0, 0, rectWidth, rectHeight), "Loading...", QTextOption(Qt::AlignCenter));
+        painter->setPen(pen);
+        painter->drawText(previewRect, "Loading...", QTextOption(Qt::AlignCenter));
     }
 
-    pen.setColor(color);
-    pen.setWidth(1);
-    pixmapPainter.setPen(pen);
+    if (m_audioInfo.peaks.isEmpty())
+        return;
 
-    if (m_audioInfo.peakCache.count() == 0 || m_audioInfo.peakCacheMipmap.count() == 0) {
-        // Draw the pixmap to the main painter
-        painter->drawPixmap(previewRect.topLeft(), pixmap);
+    const auto framesPerTick = static_cast<double>(m_audioInfo.sampleRate) * 60 / m_tempo / 480;
+    const auto start = clipStart() * framesPerTick;
+    const auto end = (clipStart() + clipLen()) * framesPerTick;
+    const auto framesPerPixel = (end - start) / previewRect.width();
+    if (framesPerPixel <= 0)
         return;
-    }
 
-    m_resolution = scaleX() >= 0.2 ? High : Low;
-    const auto chunksPerTickBase =
-        static_cast<double>(m_audioInfo.sampleRate) / m_audioInfo.chunkSize * 60 / m_tempo / 480;
-    const auto peakData = m_resolution == Low ? m_audioInfo.peakCacheMipmap : m_audioInfo.peakCache;
-    const auto chunksPerTick =
-        m_resolution == Low ? chunksPerTickBase / m_audioInfo.mipmapScale : chunksPerTickBase;
-
-    const auto rectLeftScene = mapToScene(previewRect.topLeft()).x();
-    const auto rectRightScene = mapToScene(previewRect.bottomRight()).x();
-    const auto waveRectLeft =
-        visibleRect().left() < rectLeftScene ? 0 : (visibleRect().left() - rectLeftScene) * devicePixelRatio;
-    const auto waveRectRight = visibleRect().right() < rectRightScene
-                                   ? (visibleRect().right() - rectLeftScene) * devicePixelRatio
-                                   : (rectRightScene - rectLeftScene) * devicePixelRatio;
-    // auto waveRectWidth = waveRectRight - waveRectLeft + 1; // 1 px spaceing at right
-
-    const auto start = clipStart() * chunksPerTick;
-    const auto end = (clipStart() + clipLen()) * chunksPerTick;
-    const auto divideCount = (end - start) / rectWidth;
-
-    auto drawPeak = [&](const int x, const short min, const short max) {
-        const auto yMin = -min * halfRectHeight / 32767 + halfRectHeight + rectTop;
-        const auto yMax = -max * halfRectHeight / 32767 + halfRectHeight + rectTop;
-        pixmapPainter.drawLine(x, static_cast<int>(yMin), x, static_cast<int>(yMax));
-    };
-
-    // qDebug() << m_peakCacheThumbnail.count() << divideCount;
-    for (int i = static_cast<int>(waveRectLeft); i <= static_cast<int>(waveRectRight); i++) {
-        short min = 0;
-        short max = 0;
-        auto updateMinMax = [](const std::tuple<short, short> &frame, short &min_, short &max_) {
-            const auto frameMin = std::get<0>(frame);
-            const auto frameMax = std::get<1>(frame);
-            if (frameMin < min_)
-                min_ = frameMin;
-            if (frameMax > max_)
-                max_ = frameMax;
-        };
-
-        for (int j = start + i * divideCount; j < start + i * divideCount + divideCount; j++) {
-            if (j >= peakData.count())
-                break;
-
-            const auto &frame = peakData.at(j);
-            updateMinMax(frame, min, max);
-        }
-        // if (i == rectWidth - 1) {
-        //     // for (int j = start + i * (divideCount + 1); j < m_peakCache.count(); j++) {
-        //     for (int j = start + i * (divideCount + 1); j < peakData.count(); j++) {
-        //         // auto frame = m_peakCache.at(j);
-        //         auto frame = peakData.at(j);
-        //         updateMinMax(frame, min, max);
-        //     }
-        // }
-        drawPeak(i, min, max);
+    // Tiles are laid out by position in the audio file, so moving or trimming the clip and
+    // scrolling keep them. Only the visible part of the clip is drawn.
+    if (color != m_tileColor) {
+        m_tileColor = color;
+        m_tileCache.invalidate();
     }
+    m_tileCache.setLayout(framesPerPixel, 0, previewRect.height());
+    const auto visibleLeft = mapFromScene(visibleRect().topLeft()).x();
+    const auto visibleRight = mapFromScene(visibleRect().bottomRight()).x();
+    const auto left = qMax(previewRect.left(), visibleLeft);
+    const auto right = qMin(previewRect.right(), visibleRight);
+    if (right <= left)
+        return;
+    const auto target = QRectF(left, previewRect.top(), right - left, previewRect.height());
+    const auto contentLeft = start / framesPerPixel + left - previewRect.left();
+    m_tileCache.draw(painter, target, contentLeft,
+                     [&](QPainter *tilePainter, const double tileLeft, const double tileWidth) {
+                         renderWaveformTile(tilePainter, tileLeft, tileWidth, framesPerPixel,
+                                            previewRect.height(), color);
+                     });
+}
 
-    pixmap.setDevicePixelRatio(devicePixelRatio);
-
-    painter->drawPixmap(previewRect.topLeft(), pixmap);
-
-    // const auto time = static_cast<double>(mstimer.nsecsElapsed()) / 1000000.0;
-    // qDebug() << time;
+void AudioClipView::renderWaveformTile(QPainter *painter, const double left, const double width,
+                                       const double framesPerPixel, const double height,
+                                       const QColor &color) const {
+    // One peak line per device pixel
+    const qreal devicePixelRatio = painter->device()->devicePixelRatio();
+    painter->scale(1 / devicePixelRatio, 1 / devicePixelRatio);
+    painter->setRenderHint(QPainter::Antialiasing, false);
 
-    // Draw visible area
-    // auto waveRectTop = previewRect.top();
-    // auto waveRectHeight = previewRect.height();
-    // auto waveRect = QRectF(waveRectLeft, waveRectTop, waveRectWidth, waveRectHeight);
-    //
-    // pen.setColor(QColor(255, 0, 0));
-    // pen.setWidth(1);
-    // painter->setPen(pen);
-    // painter->drawRect(waveRect);
-    // painter->drawLine(waveRect.topLeft(), waveRect.bottomRight());
-    // painter->drawLine(waveRect.topRight(), waveRect.bottomLeft());
+    QPen pen;
+    pen.setColor(color);
+    pen.setWidth(1);
+    painter->setPen(pen);
+
+    const auto halfRectHeight = height * devicePixelRatio / 2;
+    const auto framesPerDevicePixel = framesPerPixel / devicePixelRatio;
+    // Peaks of the level matching the zoom span at most three entries per pixel
+    const auto &peakLevel = m_audioInfo.peaks.levelFor(framesPerDevicePixel);
+    const auto totalFrames = static_cast<double>(m_audioInfo.frames);
+
+    const auto first = qFloor(left * devicePixelRatio);
+    const auto last = qCeil((left + width) * devicePixelRatio);
+    for (int x = first; x < last; x++) {
+        const auto frameStart = x * framesPerDevicePixel;
+        if (frameStart >= totalFrames)
+            break;
+        const auto [min, max] =
+            PeakPyramid::peakOf(peakLevel, frameStart, frameStart + framesPerDevicePixel);
+        const auto yMin = -min * halfRectHeight / 32767 + halfRectHeight;
+        const auto yMax = -max * halfRectHeight / 32767 + halfRectHeight;
+        painter->drawLine(x, static_cast<int>(yMin), x, static_cast<int>(yMax));
+    }
 }
 
 QString AudioClipView::clipTypeName() const {
@@ -8,6 +8,7 @@
 #include "AbstractClipView.h"
 #include "Model/AppModel/AudioInfoModel.h"
 #include "Global/AppGlobal.h"
+#include "UI/Views/Common/TileCache.h"
 
 class AudioClipView final : public AbstractClipView {
 public:
@@ -31,21 +32,22 @@ public slots:
     void onTempoChange(double tempo);
 
 private:
-    enum RenderResolution { High, Low };
-
     void drawPreviewArea(QPainter *painter, const QRectF &previewRect, QColor color) override;
+    void renderWaveformTile(QPainter *painter, double left, double width, double framesPerPixel,
+                            double height, const QColor &color) const;
     [[nodiscard]] QString clipTypeName() const override;
     [[nodiscard]] QString iconPath() const override;
 
     AppGlobal::AudioLoadStatus m_status = AppGlobal::Init;
     AudioInfoModel m_audioInfo;
     QString m_errorMessage;
+    TileCache m_tileCache;
+    QColor m_tileColor;
     double m_renderStart = 0;
     double m_renderEnd = 0;
     QPoint m_mouseLastPos;
     int m_rectLastWidth = -1;
     double m_tempo = 60;
-    RenderResolution m_resolution = High;
     QString m_path;
 };
 
@@ -41,7 +41,7 @@ SingingClipView::~SingingClipView() {
     dispose();
 }
 
-void SingingClipView::loadNotes(const OverlappableSerialList<Note> &notes) {
+void SingingClipView::loadNotes(const FlatOverlappableList<Note> &notes) {
     dispose();
     if (notes.count() != 0)
         for (const auto &note : notes)
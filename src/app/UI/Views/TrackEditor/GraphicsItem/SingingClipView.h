@@ -8,7 +8,7 @@
 #include "AbstractClipView.h"
 
 #include "Model/AppModel/SingingClip.h"
-#include "Utils/OverlappableSerialList.h"
+#include "Utils/FlatOverlappableList.h"
 
 class Note;
 
@@ -34,7 +34,7 @@ public:
     explicit SingingClipView(int itemId, QGraphicsItem *parent = nullptr);
     ~SingingClipView() override;
 
-    void loadNotes(const OverlappableSerialList<Note> &notes);
+    void loadNotes(const FlatOverlappableList<Note> &notes);
     [[nodiscard]] int contentLength() const override;
 
 public slots:
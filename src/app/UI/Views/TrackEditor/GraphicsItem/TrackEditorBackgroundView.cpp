@@ -7,6 +7,7 @@
 #include <QPainter>
 
 #include "Global/TracksEditorGlobal.h"
+#include "UI/Views/Common/FrameProfiler.h"
 
 using namespace TracksEditorGlobal;
 
@@ -22,6 +23,7 @@ void TrackEditorBackgroundView::onTrackSelectionChanged(const int trackIndex) {
 
 void TrackEditorBackgroundView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
                                       QWidget *widget) {
+    FrameProfiler::Scope profilerScope(FrameProfiler::Background);
     auto sceneYToTrackIndex = [&](const double y) { return y / scaleY() / trackHeight; };
     auto trackIndexToSceneY = [&](const double index) { return index * scaleY() * trackHeight; };
     auto sceneYToItemY = [&](const double y) { return mapFromScene(QPointF(0, y)).y(); };
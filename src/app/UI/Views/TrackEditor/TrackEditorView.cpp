@@ -11,6 +11,7 @@
 #include "TracksGraphicsView.h"
 #include "TrackViewModel.h"
 #include "Controller/AppController.h"
+#include "Controller/AudioDecodingController.h"
 #include "Controller/PlaybackController.h"
 #include "Controller/TrackController.h"
 #include "Global/TracksEditorGlobal.h"
@@ -96,6 +97,8 @@ TrackEditorView::TrackEditorView(QWidget *parent) : PanelView(AppGlobal::TracksE
             &TracksGraphicsView::onWheelHorScale);
     connect(m_graphicsView, &TimeGraphicsView::timeRangeChanged, m_timeline,
             &TimelineView::setTimeRange);
+    connect(m_graphicsView, &TimeGraphicsView::timeRangeChanged, audioDecodingController,
+            &AudioDecodingController::setVisibleTimeRange);
     connect(gBar, &QScrollBar::valueChanged, lBar, &QScrollBar::setValue);
     connect(lBar, &QScrollBar::valueChanged, gBar, &QScrollBar::setValue);
 
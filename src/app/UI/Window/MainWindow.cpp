@@ -99,6 +99,14 @@ MainWindow::MainWindow() {
 
     connect(m_mainMenu->actionSave(), &QAction::triggered, this, &MainWindow::onSave);
     connect(m_mainMenu->actionSaveAs(), &QAction::triggered, this, &MainWindow::onSaveAs);
+    connect(appController, &AppController::projectSaved, this,
+            [](const QString &filePath, const bool success, const QString &errorMessage) {
+                Q_UNUSED(filePath)
+                if (success)
+                    Toast::show(tr("Saved"));
+                else // TODO: Use dialog
+                    Toast::show(tr("Failed to save project: %1").arg(errorMessage));
+            });
 
     m_trackEditorView = new TrackEditorView;
     m_bottomPanelView = new BottomPanelView(this);
@@ -299,15 +307,11 @@ void MainWindow::onTaskStatusChanged(const TaskStatus &status) {
 }
 
 bool MainWindow::onSave() {
-    if (appController->projectPath().isEmpty()) {
+    // Closing the window waits for the save to finish, as it runs as a background task
+    if (appController->projectPath().isEmpty())
         onSaveAs();
-    } else {
-        if (QString errorMessage;
-            appController->saveProject(appController->projectPath(), errorMessage))
-            Toast::show(tr("Saved"));
-        else
-            Toast::show(tr("Failed to save project: %1").arg(errorMessage)); // TODO: Use dialog
-    }
+    else
+        appController->saveProjectInBackground(appController->projectPath());
     return true;
 }
 
@@ -323,11 +327,7 @@ bool MainWindow::onSaveAs() {
     if (fileName.isNull()) // Canceled
         return false;
 
-    QString errorMessage;
-    bool saved = appController->saveProject(fileName, errorMessage);
-    while (!saved) {
-        saved = appController->saveProject(getFileName(), errorMessage);
-    }
+    appController->saveProjectInBackground(fileName);
     return true;
 }
 
@@ -0,0 +1,286 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef CHUNKEDLIST_H
+#define CHUNKEDLIST_H
+
+#include <algorithm>
+
+#include <QList>
+
+// A list stored as a sequence of chunks of at most MaxChunkSize items. Locating an index is a
+// binary search over the chunk ends, and range insert/remove only touch the chunks involved.
+// Chunks are implicitly shared QLists: copies of the list share all chunks, and a write detaches
+// only the chunk it modifies.
+template <typename T, qsizetype MaxChunkSize = 1024>
+class ChunkedList {
+public:
+    ChunkedList() = default;
+    explicit ChunkedList(const QList<T> &values);
+
+    [[nodiscard]] qsizetype count() const;
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] const T &at(qsizetype i) const;
+    [[nodiscard]] QList<T> mid(qsizetype pos, qsizetype length = -1) const;
+    [[nodiscard]] QList<T> toList() const;
+
+    void append(const T &value);
+    void append(const QList<T> &values);
+    void insert(qsizetype i, const QList<T> &values);
+    void remove(qsizetype i, qsizetype n);
+    // Overwrites values.count() items starting at i
+    void replace(qsizetype i, const QList<T> &values);
+    void replace(qsizetype i, const T &value);
+    void clear();
+
+    template <typename Func>
+    void forEach(qsizetype from, Func func) const;
+    // Calls func(const QList<T> &chunk) for every chunk, e.g. to tell shared chunks apart
+    template <typename Func>
+    void forEachChunk(Func func) const;
+
+    friend bool operator==(const ChunkedList &lhs, const ChunkedList &rhs) {
+        if (lhs.count() != rhs.count())
+            return false;
+        // Chunks shared by both lists need no comparison
+        if (lhs.m_chunkEnds == rhs.m_chunkEnds) {
+            for (qsizetype c = 0; c < lhs.m_chunks.count(); c++)
+                if (lhs.m_chunks[c] != rhs.m_chunks[c])
+                    return false;
+            return true;
+        }
+        for (qsizetype i = 0; i < lhs.count(); i++)
+            if (lhs.at(i) != rhs.at(i))
+                return false;
+        return true;
+    }
+
+    friend bool operator!=(const ChunkedList &lhs, const ChunkedList &rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Returns the chunk containing item i, and the offset of i in it
+    [[nodiscard]] qsizetype chunkOf(qsizetype i, qsizetype &offset) const;
+    [[nodiscard]] qsizetype chunkStart(qsizetype chunk) const;
+    // Splits the chunk at offset, so that an item boundary becomes a chunk boundary.
+    // Returns the index of the chunk starting at i.
+    qsizetype splitAt(qsizetype i);
+    void insertChunks(qsizetype chunk, const QList<T> &values);
+    void updateChunkEnds(qsizetype fromChunk);
+
+    QList<QList<T>> m_chunks;
+    QList<qsizetype> m_chunkEnds; // Exclusive end index of each chunk
+};
+
+template <typename T, qsizetype MaxChunkSize>
+ChunkedList<T, MaxChunkSize>::ChunkedList(const QList<T> &values) {
+    insertChunks(0, values);
+    updateChunkEnds(0);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+qsizetype ChunkedList<T, MaxChunkSize>::count() const {
+    return m_chunkEnds.isEmpty() ? 0 : m_chunkEnds.last();
+}
+
+template <typename T, qsizetype MaxChunkSize>
+bool ChunkedList<T, MaxChunkSize>::isEmpty() const {
+    return count() == 0;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+const T &ChunkedList<T, MaxChunkSize>::at(const qsizetype i) const {
+    qsizetype offset;
+    const auto chunk = chunkOf(i, offset);
+    return m_chunks[chunk].at(offset);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+QList<T> ChunkedList<T, MaxChunkSize>::mid(const qsizetype pos, qsizetype length) const {
+    QList<T> result;
+    if (pos >= count())
+        return result;
+    if (length < 0 || pos + length > count())
+        length = count() - pos;
+    result.reserve(length);
+    qsizetype offset;
+    for (auto chunk = chunkOf(pos, offset); result.count() < length; chunk++, offset = 0) {
+        const auto &items = m_chunks[chunk];
+        const auto n = std::min(items.count() - offset, length - result.count());
+        result.append(items.mid(offset, n));
+    }
+    return result;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+QList<T> ChunkedList<T, MaxChunkSize>::toList() const {
+    if (m_chunks.count() == 1)
+        return m_chunks.first();
+    QList<T> result;
+    result.reserve(count());
+    for (const auto &chunk : m_chunks)
+        result.append(chunk);
+    return result;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::append(const T &value) {
+    if (m_chunks.isEmpty() || m_chunks.last().count() >= MaxChunkSize) {
+        m_chunks.append(QList<T>());
+        m_chunks.last().reserve(MaxChunkSize);
+        m_chunkEnds.append(count());
+    }
+    m_chunks.last().append(value);
+    m_chunkEnds.last()++;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::append(const QList<T> &values) {
+    insert(count(), values);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::insert(const qsizetype i, const QList<T> &values) {
+    if (values.isEmpty())
+        return;
+    Q_ASSERT(i >= 0 && i <= count());
+    // Small insertions go into the chunk in place, as long as it stays within the limit
+    qsizetype offset;
+    if (i < count()) {
+        const auto chunk = chunkOf(i, offset);
+        if (m_chunks[chunk].count() + values.count() <= MaxChunkSize) {
+            m_chunks[chunk].insert(offset, values.count(), T());
+            std::copy(values.cbegin(), values.cend(), m_chunks[chunk].begin() + offset);
+            updateChunkEnds(chunk);
+            return;
+        }
+    } else if (!m_chunks.isEmpty() &&
+               m_chunks.last().count() + values.count() <= MaxChunkSize) {
+        m_chunks.last().append(values);
+        m_chunkEnds.last() += values.count();
+        return;
+    }
+    const auto chunk = splitAt(i);
+    insertChunks(chunk, values);
+    updateChunkEnds(chunk);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::remove(const qsizetype i, qsizetype n) {
+    if (n <= 0)
+        return;
+    Q_ASSERT(i >= 0 && i + n <= count());
+    qsizetype offset;
+    const auto first = chunkOf(i, offset);
+    auto chunk = first;
+    while (n > 0) {
+        auto &items = m_chunks[chunk];
+        const auto removeCount = std::min(items.count() - offset, n);
+        if (removeCount == items.count()) {
+            m_chunks.removeAt(chunk);
+            m_chunkEnds.removeAt(chunk);
+        } else {
+            items.remove(offset, removeCount);
+            chunk++;
+        }
+        n -= removeCount;
+        offset = 0;
+    }
+    updateChunkEnds(first);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::replace(const qsizetype i, const QList<T> &values) {
+    Q_ASSERT(i >= 0 && i + values.count() <= count());
+    qsizetype offset;
+    qsizetype done = 0;
+    for (auto chunk = chunkOf(i, offset); done < values.count(); chunk++, offset = 0) {
+        auto &items = m_chunks[chunk];
+        const auto n = std::min(items.count() - offset, values.count() - done);
+        std::copy(values.cbegin() + done, values.cbegin() + done + n, items.begin() + offset);
+        done += n;
+    }
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::replace(const qsizetype i, const T &value) {
+    qsizetype offset;
+    const auto chunk = chunkOf(i, offset);
+    m_chunks[chunk][offset] = value;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::clear() {
+    m_chunks.clear();
+    m_chunkEnds.clear();
+}
+
+template <typename T, qsizetype MaxChunkSize>
+template <typename Func>
+void ChunkedList<T, MaxChunkSize>::forEach(const qsizetype from, Func func) const {
+    if (from >= count())
+        return;
+    qsizetype offset;
+    auto index = from;
+    for (auto chunk = chunkOf(from, offset); chunk < m_chunks.count(); chunk++, offset = 0)
+        for (auto it = m_chunks[chunk].cbegin() + offset; it != m_chunks[chunk].cend(); ++it)
+            func(index++, *it);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+template <typename Func>
+void ChunkedList<T, MaxChunkSize>::forEachChunk(Func func) const {
+    for (const auto &chunk : m_chunks)
+        func(chunk);
+}
+
+template <typename T, qsizetype MaxChunkSize>
+qsizetype ChunkedList<T, MaxChunkSize>::chunkOf(const qsizetype i, qsizetype &offset) const {
+    Q_ASSERT(i >= 0 && i < count());
+    const auto it = std::upper_bound(m_chunkEnds.cbegin(), m_chunkEnds.cend(), i);
+    const auto chunk = it - m_chunkEnds.cbegin();
+    offset = i - chunkStart(chunk);
+    return chunk;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+qsizetype ChunkedList<T, MaxChunkSize>::chunkStart(const qsizetype chunk) const {
+    return chunk == 0 ? 0 : m_chunkEnds[chunk - 1];
+}
+
+template <typename T, qsizetype MaxChunkSize>
+qsizetype ChunkedList<T, MaxChunkSize>::splitAt(const qsizetype i) {
+    if (i >= count())
+        return m_chunks.count();
+    qsizetype offset;
+    const auto chunk = chunkOf(i, offset);
+    if (offset == 0)
+        return chunk;
+    const auto tail = m_chunks[chunk].mid(offset);
+    m_chunks[chunk].resize(offset);
+    m_chunks.insert(chunk + 1, tail);
+    m_chunkEnds.insert(chunk + 1, 0);
+    updateChunkEnds(chunk);
+    return chunk + 1;
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::insertChunks(qsizetype chunk, const QList<T> &values) {
+    for (qsizetype pos = 0; pos < values.count(); pos += MaxChunkSize, chunk++) {
+        m_chunks.insert(chunk, values.mid(pos, MaxChunkSize));
+        m_chunkEnds.insert(chunk, 0);
+    }
+}
+
+template <typename T, qsizetype MaxChunkSize>
+void ChunkedList<T, MaxChunkSize>::updateChunkEnds(const qsizetype fromChunk) {
+    auto end = chunkStart(fromChunk);
+    for (auto chunk = fromChunk; chunk < m_chunks.count(); chunk++) {
+        end += m_chunks[chunk].count();
+        m_chunkEnds[chunk] = end;
+    }
+}
+
+#endif // CHUNKEDLIST_H
@@ -0,0 +1,139 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef CURVERESAMPLER_H
+#define CURVERESAMPLER_H
+
+#include <algorithm>
+
+#include <QList>
+
+// Linearly resamples curves of sampleCount values taken every interval onto newInterval.
+// The source index and the interpolation weight of every output sample only depend on the
+// lengths, so they are computed once and shared by all the curves of a piece. What is left per
+// curve is a branch-free gather and lerp into a preallocated buffer, which the compiler
+// vectorizes without any instruction set specific code.
+// Produces the same samples as the former per-sample MathUtils::resample loop: output sample i
+// is at i * newInterval, and samples at or after the last source value are dropped.
+// Samples may also be taken at given ascending positions, e.g. frame times mapped through the
+// tempo map, where the spacing of the output changes with the tempo.
+class CurveResampler {
+public:
+    CurveResampler(const qsizetype sampleCount, const double interval, const double newInterval)
+        : m_sampleCount(sampleCount), m_interval(interval), m_newInterval(newInterval) {
+        if (sampleCount < 2 || interval <= 0 || newInterval <= 0)
+            return;
+        const double totalLength = static_cast<double>(sampleCount - 1) * interval;
+        const auto maxCount = static_cast<qsizetype>(totalLength / newInterval) + 1;
+        m_indexes.reserve(maxCount);
+        m_weights.reserve(maxCount);
+        for (qsizetype i = 0; i < maxCount; i++) {
+            const double newX = static_cast<double>(i) * newInterval;
+            const auto index = static_cast<qsizetype>(newX / interval);
+            if (index >= sampleCount - 1)
+                break;
+            m_indexes.append(index);
+            m_weights.append((newX - static_cast<double>(index) * interval) / interval);
+        }
+    }
+
+    // positions are in the unit of interval, from the first source value
+    CurveResampler(const qsizetype sampleCount, const double interval, QList<double> positions)
+        : m_sampleCount(sampleCount), m_interval(interval), m_positions(std::move(positions)) {
+        if (sampleCount < 2 || interval <= 0)
+            return;
+        m_indexes.reserve(m_positions.count());
+        m_weights.reserve(m_positions.count());
+        for (const auto x : std::as_const(m_positions)) {
+            const auto index = static_cast<qsizetype>(std::max(0.0, x) / interval);
+            if (index >= sampleCount - 1)
+                break;
+            m_indexes.append(index);
+            m_weights.append((x - static_cast<double>(index) * interval) / interval);
+        }
+    }
+
+    [[nodiscard]] qsizetype sampleCount() const {
+        return m_sampleCount;
+    }
+
+    [[nodiscard]] qsizetype resampledCount() const {
+        return m_indexes.count();
+    }
+
+    // Writes resampledCount() values to out. values must hold sampleCount() values.
+    template <typename In, typename Out>
+    void resample(const In *values, Out *out) const {
+        const auto indexes = m_indexes.constData();
+        const auto weights = m_weights.constData();
+        const auto count = m_indexes.count();
+        for (qsizetype i = 0; i < count; i++) {
+            const double y0 = values[indexes[i]];
+            const double y1 = values[indexes[i] + 1];
+            out[i] = static_cast<Out>(y0 + (y1 - y0) * weights[i]);
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] QList<T> resample(const QList<T> &values) const {
+        QList<T> result;
+        if (values.count() != m_sampleCount) {
+            // Curves of another length need their own resampler
+            return values.count() < 2 ? result : withSampleCount(values.count()).resample(values);
+        }
+        result.resize(resampledCount());
+        resample(values.constData(), result.data());
+        return result;
+    }
+
+    // Resamples every curve, sharing the precomputed positions between curves of the same length
+    template <typename T>
+    [[nodiscard]] static QList<QList<T>> resample(const QList<const QList<T> *> &curves,
+                                                  const double interval,
+                                                  const double newInterval) {
+        return CurveResampler(0, interval, newInterval).resampleAll(curves);
+    }
+
+    template <typename T>
+    [[nodiscard]] static QList<QList<T>> resample(const QList<const QList<T> *> &curves,
+                                                  const double interval,
+                                                  const QList<double> &positions) {
+        return CurveResampler(0, interval, positions).resampleAll(curves);
+    }
+
+private:
+    // A resampler to the same output positions, for curves of sampleCount values
+    [[nodiscard]] CurveResampler withSampleCount(const qsizetype sampleCount) const {
+        return m_positions.isEmpty() ? CurveResampler(sampleCount, m_interval, m_newInterval)
+                                     : CurveResampler(sampleCount, m_interval, m_positions);
+    }
+
+    template <typename T>
+    [[nodiscard]] QList<QList<T>> resampleAll(const QList<const QList<T> *> &curves) const {
+        QList<QList<T>> results;
+        results.reserve(curves.count());
+        QList<CurveResampler> resamplers;
+        for (const auto curve : curves) {
+            auto it = std::find_if(resamplers.cbegin(), resamplers.cend(), [curve](const auto &r) {
+                return r.sampleCount() == curve->count();
+            });
+            if (it == resamplers.cend()) {
+                resamplers.append(withSampleCount(curve->count()));
+                it = resamplers.cend() - 1;
+            }
+            results.append(it->resample(*curve));
+        }
+        return results;
+    }
+
+    qsizetype m_sampleCount = 0;
+    double m_interval = 0;
+    double m_newInterval = 0;
+    // Output positions, if not evenly spaced by m_newInterval
+    QList<double> m_positions;
+    QList<qsizetype> m_indexes;
+    QList<double> m_weights;
+};
+
+#endif // CURVERESAMPLER_H
@@ -0,0 +1,369 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef FLATOVERLAPPABLELIST_H
+#define FLATOVERLAPPABLELIST_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+#include <QList>
+
+// Same interface as OverlappableSerialList, stored as two sorted contiguous arrays instead of an
+// interval tree and two sets: the items, and their (low, high) bounds with the running maximum of
+// high. Items are ordered by interval start, then by address, so T::compareTo must order by
+// interval start too. An overlap query is two binary searches followed by a linear scan of the
+// candidates, which for non-overlapping items such as notes are exactly the result.
+// Like OverlappableSerialList, an item must be removed before its interval changes and added again
+// afterwards. An interval [start, end) overlaps [low, max(low, end - 1)] of the others, so that
+// zero-length items at the same position are overlapped.
+template <typename T>
+class FlatOverlappableList {
+    struct Bounds {
+        qsizetype low;
+        qsizetype high;
+        qsizetype maxHigh; // Maximum high of this and all previous items
+    };
+
+public:
+    [[nodiscard]] int count() const;
+    [[nodiscard]] bool isEmpty() const;
+    void add(T *item);
+    // Sorts the new items once instead of inserting them one by one
+    void add(const QList<T *> &items);
+    void remove(T *item);
+    void remove(const QList<T *> &items);
+    void clear();
+    bool contains(const T *item) const;
+    [[nodiscard]] bool hasOverlappedItem() const;
+    QList<T *> findOverlappedItems(T *obj) const;
+    QList<T *> findOverlappedItems(const std::tuple<qsizetype, qsizetype> &interval_) const;
+    QList<T *> overlappedItems() const;
+    QList<T *> toList() const;
+
+    using iterator = typename std::vector<T *>::const_iterator;
+    using const_iterator = typename std::vector<T *>::const_iterator;
+    using reverse_iterator = typename std::vector<T *>::const_reverse_iterator;
+    using const_reverse_iterator = typename std::vector<T *>::const_reverse_iterator;
+
+    const_iterator begin() const {
+        return m_items.cbegin();
+    }
+
+    const_iterator end() const {
+        return m_items.cend();
+    }
+
+    const_iterator cbegin() const {
+        return m_items.cbegin();
+    }
+
+    const_iterator cend() const {
+        return m_items.cend();
+    }
+
+    const_reverse_iterator rbegin() const {
+        return m_items.crbegin();
+    }
+
+    const_reverse_iterator rend() const {
+        return m_items.crend();
+    }
+
+    const_reverse_iterator crbegin() const {
+        return m_items.crbegin();
+    }
+
+    const_reverse_iterator crend() const {
+        return m_items.crend();
+    }
+
+private:
+    static std::pair<qsizetype, qsizetype> boundsOf(const std::tuple<qsizetype, qsizetype> &range);
+    static bool isBefore(qsizetype lowA, const T *a, qsizetype lowB, const T *b);
+    // Position of item in the (low, address) order
+    [[nodiscard]] qsizetype lowerBound(qsizetype low, const T *item) const;
+    [[nodiscard]] qsizetype indexOf(const T *item) const;
+    // Calls func(index) for every item whose bounds overlap [low, high]
+    template <typename Func>
+    void forEachOverlapped(qsizetype low, qsizetype high, Func func) const;
+    void updateMaxHigh(qsizetype from);
+    void acquireOverlap(T *item);
+    void releaseOverlap(T *item);
+
+    std::vector<T *> m_items;
+    std::vector<Bounds> m_bounds;
+    int m_overlappedCounter{};
+};
+
+template <typename T>
+int FlatOverlappableList<T>::count() const {
+    return static_cast<int>(m_items.size());
+}
+
+template <typename T>
+bool FlatOverlappableList<T>::isEmpty() const {
+    return m_items.empty();
+}
+
+template <typename T>
+void FlatOverlappableList<T>::add(T *item) {
+    item->clearOverlappedCounter();
+    const auto [low, high] = boundsOf(item->interval());
+    forEachOverlapped(low, high, [this, item](const qsizetype i) {
+        acquireOverlap(m_items[i]);
+        acquireOverlap(item);
+    });
+    const auto pos = lowerBound(low, item);
+    m_items.insert(m_items.begin() + pos, item);
+    m_bounds.insert(m_bounds.begin() + pos, {low, high, high});
+    updateMaxHigh(pos);
+}
+
+template <typename T>
+void FlatOverlappableList<T>::add(const QList<T *> &items) {
+    if (items.count() == 1) {
+        add(items.first());
+        return;
+    }
+    struct Entry {
+        Bounds bounds;
+        T *item;
+    };
+    std::vector<Entry> newEntries;
+    newEntries.reserve(items.count());
+    for (const auto item : items) {
+        item->clearOverlappedCounter();
+        const auto [low, high] = boundsOf(item->interval());
+        newEntries.push_back({{low, high, high}, item});
+    }
+    const auto entryBefore = [](const Entry &a, const Entry &b) {
+        return isBefore(a.bounds.low, a.item, b.bounds.low, b.item);
+    };
+    std::sort(newEntries.begin(), newEntries.end(), entryBefore);
+
+    // Merge the sorted new items into the arrays from the back, so nothing is moved twice
+    const auto oldCount = m_items.size();
+    m_items.resize(oldCount + newEntries.size());
+    m_bounds.resize(oldCount + newEntries.size());
+    auto oldIndex = static_cast<qsizetype>(oldCount) - 1;
+    auto newIndex = static_cast<qsizetype>(newEntries.size()) - 1;
+    for (auto out = static_cast<qsizetype>(m_items.size()) - 1; newIndex >= 0; out--) {
+        const auto &entry = newEntries[newIndex];
+        if (oldIndex >= 0 &&
+            isBefore(entry.bounds.low, entry.item, m_bounds[oldIndex].low, m_items[oldIndex])) {
+            m_items[out] = m_items[oldIndex];
+            m_bounds[out] = m_bounds[oldIndex];
+            oldIndex--;
+        } else {
+            m_items[out] = entry.item;
+            m_bounds[out] = entry.bounds;
+            newIndex--;
+        }
+    }
+    updateMaxHigh(oldIndex + 1);
+
+    // Every overlapping pair is counted once: by the later of the two new items, or by the new one
+    std::unordered_set<const T *> pending(items.cbegin(), items.cend());
+    for (const auto &entry : newEntries) {
+        pending.erase(entry.item);
+        forEachOverlapped(entry.bounds.low, entry.bounds.high, [&](const qsizetype i) {
+            const auto other = m_items[i];
+            if (other == entry.item || pending.count(other))
+                return;
+            acquireOverlap(other);
+            acquireOverlap(entry.item);
+        });
+    }
+}
+
+template <typename T>
+void FlatOverlappableList<T>::remove(T *item) {
+    const auto index = indexOf(item);
+    if (index < 0)
+        return;
+    if (item->overlapped())
+        m_overlappedCounter--;
+    item->clearOverlappedCounter();
+    const auto &bounds = m_bounds[index];
+    forEachOverlapped(bounds.low, bounds.high, [this, index](const qsizetype i) {
+        if (i != index)
+            releaseOverlap(m_items[i]);
+    });
+    m_items.erase(m_items.begin() + index);
+    m_bounds.erase(m_bounds.begin() + index);
+    updateMaxHigh(index);
+}
+
+template <typename T>
+void FlatOverlappableList<T>::remove(const QList<T *> &items) {
+    if (items.count() == 1) {
+        remove(items.first());
+        return;
+    }
+    std::vector<bool> removed(m_items.size(), false);
+    auto firstRemoved = static_cast<qsizetype>(m_items.size());
+    for (const auto item : items) {
+        const auto index = indexOf(item);
+        if (index < 0 || removed[index])
+            continue;
+        if (item->overlapped())
+            m_overlappedCounter--;
+        item->clearOverlappedCounter();
+        const auto &bounds = m_bounds[index];
+        forEachOverlapped(bounds.low, bounds.high, [&](const qsizetype i) {
+            // Items removed earlier in this batch have already been cleared
+            if (i != index && !removed[i])
+                releaseOverlap(m_items[i]);
+        });
+        removed[index] = true;
+        firstRemoved = std::min(firstRemoved, index);
+    }
+
+    auto out = firstRemoved;
+    for (auto i = firstRemoved; i < static_cast<qsizetype>(m_items.size()); i++) {
+        if (removed[i])
+            continue;
+        m_items[out] = m_items[i];
+        m_bounds[out] = m_bounds[i];
+        out++;
+    }
+    m_items.resize(out);
+    m_bounds.resize(out);
+    updateMaxHigh(firstRemoved);
+}
+
+template <typename T>
+void FlatOverlappableList<T>::clear() {
+    m_items.clear();
+    m_bounds.clear();
+    m_overlappedCounter = 0;
+}
+
+template <typename T>
+bool FlatOverlappableList<T>::contains(const T *item) const {
+    return indexOf(item) >= 0;
+}
+
+template <typename T>
+bool FlatOverlappableList<T>::hasOverlappedItem() const {
+    return m_overlappedCounter;
+}
+
+template <typename T>
+QList<T *> FlatOverlappableList<T>::findOverlappedItems(T *obj) const {
+    return findOverlappedItems(obj->interval());
+}
+
+template <typename T>
+QList<T *> FlatOverlappableList<T>::findOverlappedItems(
+    const std::tuple<qsizetype, qsizetype> &interval_) const {
+    const auto [low, high] = boundsOf(interval_);
+    QList<T *> ret;
+    forEachOverlapped(low, high, [this, &ret](const qsizetype i) { ret.append(m_items[i]); });
+    return ret;
+}
+
+template <typename T>
+QList<T *> FlatOverlappableList<T>::overlappedItems() const {
+    QList<T *> ret;
+    std::copy_if(m_items.cbegin(), m_items.cend(), std::back_inserter(ret),
+                 [](auto item) { return item->overlapped(); });
+    return ret;
+}
+
+template <typename T>
+QList<T *> FlatOverlappableList<T>::toList() const {
+    return QList<T *>(m_items.cbegin(), m_items.cend());
+}
+
+template <typename T>
+std::pair<qsizetype, qsizetype>
+    FlatOverlappableList<T>::boundsOf(const std::tuple<qsizetype, qsizetype> &range) {
+    const auto low = std::get<0>(range);
+    return {low, std::max(low, std::get<1>(range) - 1)};
+}
+
+template <typename T>
+bool FlatOverlappableList<T>::isBefore(const qsizetype lowA, const T *a, const qsizetype lowB,
+                                       const T *b) {
+    if (lowA != lowB)
+        return lowA < lowB;
+    return std::less<const T *>()(a, b);
+}
+
+template <typename T>
+qsizetype FlatOverlappableList<T>::lowerBound(const qsizetype low, const T *item) const {
+    qsizetype first = 0;
+    auto length = static_cast<qsizetype>(m_items.size());
+    while (length > 0) {
+        const auto half = length / 2;
+        const auto mid = first + half;
+        if (isBefore(m_bounds[mid].low, m_items[mid], low, item)) {
+            first = mid + 1;
+            length -= half + 1;
+        } else
+            length = half;
+    }
+    return first;
+}
+
+template <typename T>
+qsizetype FlatOverlappableList<T>::indexOf(const T *item) const {
+    const auto low = std::get<0>(item->interval());
+    if (const auto pos = lowerBound(low, item);
+        pos < static_cast<qsizetype>(m_items.size()) && m_items[pos] == item)
+        return pos;
+    // The item has moved since it was added
+    const auto it = std::find(m_items.cbegin(), m_items.cend(), item);
+    return it == m_items.cend() ? -1 : it - m_items.cbegin();
+}
+
+template <typename T>
+template <typename Func>
+void FlatOverlappableList<T>::forEachOverlapped(const qsizetype low, const qsizetype high,
+                                                Func func) const {
+    // Items from first on are the only ones that may reach low, items from last on start after high
+    const auto first = std::lower_bound(m_bounds.cbegin(), m_bounds.cend(), low,
+                                        [](const Bounds &bounds, const qsizetype value) {
+                                            return bounds.maxHigh < value;
+                                        }) -
+                       m_bounds.cbegin();
+    const auto last = std::upper_bound(m_bounds.cbegin() + first, m_bounds.cend(), high,
+                                       [](const qsizetype value, const Bounds &bounds) {
+                                           return value < bounds.low;
+                                       }) -
+                      m_bounds.cbegin();
+    for (auto i = first; i < last; i++)
+        if (m_bounds[i].high >= low)
+            func(i);
+}
+
+template <typename T>
+void FlatOverlappableList<T>::updateMaxHigh(const qsizetype from) {
+    auto maxHigh = from == 0 ? std::numeric_limits<qsizetype>::min() : m_bounds[from - 1].maxHigh;
+    for (auto i = from; i < static_cast<qsizetype>(m_bounds.size()); i++) {
+        maxHigh = std::max(maxHigh, m_bounds[i].high);
+        m_bounds[i].maxHigh = maxHigh;
+    }
+}
+
+template <typename T>
+void FlatOverlappableList<T>::acquireOverlap(T *item) {
+    if (!item->overlapped())
+        m_overlappedCounter++;
+    item->acquireOverlappedCounter();
+}
+
+template <typename T>
+void FlatOverlappableList<T>::releaseOverlap(T *item) {
+    item->releaseOverlappedCounter();
+    if (!item->overlapped())
+        m_overlappedCounter--;
+}
+
+#endif // FLATOVERLAPPABLELIST_H
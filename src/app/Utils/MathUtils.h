@@ -8,6 +8,8 @@
 #include <QDebug>
 #include <QPoint>
 
+#include "CurveResampler.h"
+
 class MathUtils {
 public:
     static double clip(const double value, const double min, const double max) {
@@ -58,38 +60,10 @@ public:
         return 1 - std::pow(1 - y, 1 / power);
     }
 
+    // For several curves of one piece, use CurveResampler::resample to share the sample positions
     static QList<double> resample(const QList<double> &values, const double interval,
                                   const double newInterval) {
-        QList<double> resampledValues;
-
-        const int numOldSamples = values.size();
-        if (numOldSamples < 2 || interval <= 0 || newInterval <= 0) {
-            // 如果数据点不足，或间隔无效，直接返回空的结果
-            return resampledValues;
-        }
-
-        const double totalLength = (numOldSamples - 1) * interval;                 // 总长度
-        const int numNewSamples = static_cast<int>(totalLength / newInterval) + 1; // 新采样点数目
-
-        for (int i = 0; i < numNewSamples; ++i) {
-            const double newX = i * newInterval;
-
-            // 找到 newX 所处的区间 [x0, x1]
-            const int oldIndex = static_cast<int>(newX / interval);
-            if (oldIndex >= numOldSamples - 1) {
-                break; // 超出范围
-            }
-
-            double x0 = oldIndex * interval;
-            double x1 = (oldIndex + 1) * interval;
-            double y0 = values[oldIndex];
-            double y1 = values[oldIndex + 1];
-
-            const double newValue = linearValueAt({x0, y0}, {x1, y1}, newX);
-            resampledValues.append(newValue);
-        }
-
-        return resampledValues;
+        return CurveResampler(values.count(), interval, newInterval).resample(values);
     }
 
     template <typename T>
@@ -0,0 +1,147 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+#include <algorithm>
+
+#include <QList>
+
+// Min/max ranges of a sequence of values at power-of-two resolutions. Level 0 holds the range of
+// every valuesPerEntry values, and each following level halves the entry count of the previous
+// one. Views pick the level matching their zoom, so that a pixel never reads more than three
+// entries whatever the length of the sequence.
+template <typename T>
+class MinMaxPyramid {
+public:
+    // Ranges are stored planar, so each array can be scanned and saved in one go
+    class Level {
+    public:
+        int valuesPerEntry = 0;
+        QList<T> mins;
+        QList<T> maxs;
+
+        [[nodiscard]] qsizetype count() const {
+            return mins.count();
+        }
+    };
+
+    MinMaxPyramid() = default;
+    // Builds the coarser levels from level 0
+    explicit MinMaxPyramid(Level first);
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] int levelCount() const;
+    [[nodiscard]] const Level &level(int index) const;
+    // The coarsest level whose entries span no more than valuesPerPixel values
+    [[nodiscard]] const Level &levelFor(double valuesPerPixel) const;
+    // Folds the entries [firstEntry, lastEntry) of level into min and max. Entries out of range
+    // are skipped, at least the first entry is read if it exists.
+    static std::pair<T, T> rangeOf(const Level &level, qsizetype firstEntry, qsizetype lastEntry,
+                                   T min, T max);
+
+protected:
+    // Level 0, for derived classes changing it in place. Call updateLevels() afterwards.
+    Level &firstLevel();
+    // Rebuilds the coarser entries covering the level 0 entries [firstEntry, lastEntry), adding
+    // or dropping levels as the count of level 0 changed. Entries past the old count of level 0
+    // must be in the range.
+    void updateLevels(qsizetype firstEntry, qsizetype lastEntry);
+
+private:
+    QList<Level> m_levels;
+};
+
+template <typename T>
+MinMaxPyramid<T>::MinMaxPyramid(Level first) {
+    if (first.mins.isEmpty() || first.mins.count() != first.maxs.count() ||
+        first.valuesPerEntry <= 0)
+        return;
+    const auto count = first.count();
+    m_levels.append(std::move(first));
+    updateLevels(0, count);
+}
+
+template <typename T>
+bool MinMaxPyramid<T>::isEmpty() const {
+    return m_levels.isEmpty();
+}
+
+template <typename T>
+int MinMaxPyramid<T>::levelCount() const {
+    return static_cast<int>(m_levels.count());
+}
+
+template <typename T>
+auto MinMaxPyramid<T>::level(const int index) const -> const Level & {
+    return m_levels.at(index);
+}
+
+template <typename T>
+auto MinMaxPyramid<T>::levelFor(const double valuesPerPixel) const -> const Level & {
+    Q_ASSERT(!isEmpty());
+    auto index = 0;
+    while (index + 1 < m_levels.count() && m_levels[index + 1].valuesPerEntry <= valuesPerPixel)
+        index++;
+    return m_levels[index];
+}
+
+template <typename T>
+std::pair<T, T> MinMaxPyramid<T>::rangeOf(const Level &level, const qsizetype firstEntry,
+                                          const qsizetype lastEntry, T min, T max) {
+    const auto first = std::max<qsizetype>(0, firstEntry);
+    const auto last = std::min(level.count(), std::max(first + 1, lastEntry));
+    for (auto i = first; i < last; i++) {
+        min = std::min(min, level.mins[i]);
+        max = std::max(max, level.maxs[i]);
+    }
+    return {min, max};
+}
+
+template <typename T>
+auto MinMaxPyramid<T>::firstLevel() -> Level & {
+    Q_ASSERT(!isEmpty());
+    return m_levels.first();
+}
+
+template <typename T>
+void MinMaxPyramid<T>::updateLevels(qsizetype firstEntry, qsizetype lastEntry) {
+    if (m_levels.isEmpty())
+        return;
+    if (m_levels.first().count() == 0) {
+        m_levels.clear();
+        return;
+    }
+    qsizetype index = 1;
+    for (; m_levels[index - 1].count() > 1; index++) {
+        const auto count = (m_levels[index - 1].count() + 1) / 2;
+        firstEntry /= 2;
+        lastEntry = std::min((lastEntry + 1) / 2, count);
+        if (index == m_levels.count()) {
+            Level level;
+            level.valuesPerEntry = m_levels[index - 1].valuesPerEntry * 2;
+            m_levels.append(level);
+            firstEntry = 0;
+            lastEntry = count;
+        }
+        const auto &finer = m_levels[index - 1];
+        auto &level = m_levels[index];
+        level.mins.resize(count);
+        level.maxs.resize(count);
+        const auto finerMins = finer.mins.constData();
+        const auto finerMaxs = finer.maxs.constData();
+        const auto lastFiner = finer.count() - 1;
+        for (auto i = firstEntry; i < lastEntry; i++) {
+            const auto a = 2 * i;
+            const auto b = std::min(a + 1, lastFiner);
+            level.mins[i] = std::min(finerMins[a], finerMins[b]);
+            level.maxs[i] = std::max(finerMaxs[a], finerMaxs[b]);
+        }
+    }
+    // The last level left has a single entry
+    m_levels.resize(index);
+}
+
+#endif // MINMAXPYRAMID_H
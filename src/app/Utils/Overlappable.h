@@ -16,6 +16,11 @@ public:
         return m_overlappedCounter;
     }
 
+    // Number of other items of the list this item overlaps
+    [[nodiscard]] int overlappedCounter() const {
+        return m_overlappedCounter;
+    }
+
     void acquireOverlappedCounter() {
         m_overlappedCounter++;
     }
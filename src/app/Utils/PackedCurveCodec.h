@@ -0,0 +1,88 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#ifndef PACKEDCURVECODEC_H
+#define PACKEDCURVECODEC_H
+
+#include <algorithm>
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+// Compact storage for dense curve values. Neighbouring samples of a drawn curve are close, so each
+// value is stored as the zigzag encoded difference to the previous one in a LEB128 varint, which
+// takes one or two bytes for most samples instead of a JSON number.
+class PackedCurveCodec {
+public:
+    static QByteArray pack(const QList<int> &values) {
+        QByteArray result;
+        result.reserve(values.count() * 2);
+        qint64 previous = 0;
+        for (const auto value : values) {
+            const auto delta = static_cast<qint64>(value) - previous;
+            previous = value;
+            auto zigzag = (static_cast<quint64>(delta) << 1) ^ static_cast<quint64>(delta >> 63);
+            while (zigzag >= 0x80) {
+                result.append(static_cast<char>((zigzag & 0x7F) | 0x80));
+                zigzag >>= 7;
+            }
+            result.append(static_cast<char>(zigzag));
+        }
+        return result;
+    }
+
+    // Number of values in data, without decoding them
+    static qsizetype countValues(const QByteArray &data) {
+        return std::count_if(data.cbegin(), data.cend(),
+                             [](const char byte) { return (byte & 0x80) == 0; });
+    }
+
+    // Returns false and leaves values empty if data does not hold exactly count values
+    static bool unpack(const QByteArray &data, const qsizetype count, QList<int> &values) {
+        values.clear();
+        values.reserve(count);
+        qint64 previous = 0;
+        quint64 zigzag = 0;
+        int shift = 0;
+        for (const auto byte : data) {
+            const auto bits = static_cast<quint8>(byte);
+            if (shift > 63) {
+                values.clear();
+                return false;
+            }
+            zigzag |= static_cast<quint64>(bits & 0x7F) << shift;
+            if (bits & 0x80) {
+                shift += 7;
+                continue;
+            }
+            const auto delta = static_cast<qint64>(zigzag >> 1) ^ -static_cast<qint64>(zigzag & 1);
+            previous += delta;
+            values.append(static_cast<int>(previous));
+            zigzag = 0;
+            shift = 0;
+        }
+        if (shift != 0 || values.count() != count) {
+            values.clear();
+            return false;
+        }
+        return true;
+    }
+
+    static QString toBase64(const QList<int> &values) {
+        return QString::fromLatin1(pack(values).toBase64());
+    }
+
+    static bool fromBase64(const QString &text, const qsizetype count, QList<int> &values) {
+        const auto decoded = QByteArray::fromBase64Encoding(text.toLatin1(),
+                                                            QByteArray::AbortOnBase64DecodingErrors);
+        if (!decoded) {
+            values.clear();
+            return false;
+        }
+        return unpack(*decoded, count, values);
+    }
+};
+
+#endif // PACKEDCURVECODEC_H
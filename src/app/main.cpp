@@ -13,7 +13,9 @@
 #include "Modules/Audio/subsystem/MidiSystem.h"
 #include "Modules/Audio/subsystem/OutputSystem.h"
 #include "Modules/Audio/utils/DeviceTester.h"
+#include "Modules/BatchRender/BatchRenderer.h"
 #include "Modules/Inference/InferEngine.h"
+#include "Modules/Inference/InferTelemetry.h"
 #include "Modules/PackageManager/PackageManager.h"
 #include "UI/Dialogs/PackageManager/PackageManagerDialog.h"
 #include "UI/Window/MainWindow.h"
@@ -90,6 +92,9 @@ int main(int argc, char *argv[]) {
         Qt::HighDpiScaleFactorRoundingPolicy::PassThrough);
     if (QSysInfo::productType() == "windows")
         QGuiApplication::setAttribute(Qt::AA_DontCreateNativeWidgetSiblings);
+    const auto isBatchRender = BatchRenderer::isRequested(argc, argv);
+    if (isBatchRender)
+        BatchRenderer::prepareEnvironment();
     QApplication a(argc, argv);
     // QApplication::setAttribute(Qt::AA_SynthesizeTouchForUnhandledMouseEvents);
     QApplication::setEffectEnabled(Qt::UI_AnimateTooltip, false);
@@ -134,13 +139,29 @@ int main(int argc, char *argv[]) {
 
     AppContext appContext;
 
+    if (isBatchRender)
+        BatchRenderer::prepareOptions();
+
     AppController::instance();
+    InferTelemetry::instance();
     InferEngine::instance();
     PackageManager::instance();
 
     QObject::connect(inferEngine, &InferEngine::engineInitialized, packageManager,
                      &PackageManager::initialize, Qt::SingleShotConnection);
 
+    if (isBatchRender) {
+        BatchRenderer::Options options;
+        QString errorMessage;
+        if (!BatchRenderer::parseArguments(QApplication::arguments(), options, errorMessage)) {
+            qCritical().noquote() << "Batch render:" << errorMessage;
+            return BatchRenderer::ExitInvalidArguments;
+        }
+        BatchRenderer renderer(options);
+        renderer.start();
+        return a.exec();
+    }
+
     // 需要存储自定义的信息时，根据唯一名称获取到 editor 对象
     // auto editor = appModel->workspaceEditor("flutydeer.filllyrics");
     // auto workspace = editor->privateWorkspace();
@@ -0,0 +1,223 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "Utils/FlatOverlappableList.h"
+#include "Utils/Overlappable.h"
+#include "Utils/OverlappableSerialList.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <random>
+
+static constexpr int noteCount = 10000;
+static constexpr int queryCount = 10000;
+static constexpr int iteratePasses = 100;
+
+class BenchNote final : public Overlappable {
+public:
+    BenchNote(const int start, const int length) : m_start(start), m_length(length) {
+    }
+
+    [[nodiscard]] int start() const {
+        return m_start;
+    }
+
+    [[nodiscard]] int compareTo(const BenchNote *obj) const {
+        return m_start < obj->m_start ? -1 : m_start > obj->m_start ? 1 : 0;
+    }
+
+    [[nodiscard]] std::tuple<qsizetype, qsizetype> interval() const override {
+        return std::make_tuple(m_start, m_start + m_length);
+    }
+
+private:
+    int m_start;
+    int m_length;
+};
+
+// Bounds as in FlatOverlappableList: [start, end) covers [start, max(start, end - 1)]
+static bool isOverlapped(const BenchNote *a, const BenchNote *b) {
+    const auto [startA, endA] = a->interval();
+    const auto [startB, endB] = b->interval();
+    return startA <= std::max(startB, endB - 1) && startB <= std::max(startA, endA - 1);
+}
+
+// Recounts the overlaps of every item in the list pair by pair
+static bool checkOverlapCounters(const FlatOverlappableList<BenchNote> &list, const char *step) {
+    const auto items = list.toList();
+    qsizetype overlappedCount = 0;
+    for (const auto item : items) {
+        int expected = 0;
+        for (const auto other : items)
+            if (other != item && isOverlapped(item, other))
+                expected++;
+        if (item->overlappedCounter() != expected || item->overlapped() != (expected > 0)) {
+            qCritical() << step << "overlap counter of item at" << item->start() << "is"
+                        << item->overlappedCounter() << "expected" << expected;
+            return false;
+        }
+        if (expected > 0)
+            overlappedCount++;
+    }
+    if (list.hasOverlappedItem() != (overlappedCount > 0) ||
+        list.overlappedItems().count() != overlappedCount) {
+        qCritical() << step << "list reports" << list.overlappedItems().count()
+                    << "overlapped items, expected" << overlappedCount;
+        return false;
+    }
+    return true;
+}
+
+// Adds and removes densely overlapping items in batches, including zero-length ones, and checks
+// the counters against a recount after each batch
+static bool testBatchOverlapCounters(QRandomGenerator &random) {
+    constexpr int count = 1000;
+    constexpr int batchCount = 4;
+    QList<BenchNote *> notes;
+    for (int i = 0; i < count; i++)
+        notes.append(new BenchNote(random.bounded(count * 60), random.bounded(0, 480)));
+
+    FlatOverlappableList<BenchNote> list;
+    bool ok = true;
+    for (int b = 0; b < batchCount && ok; b++) {
+        list.add(notes.mid(b * count / batchCount, count / batchCount));
+        ok = checkOverlapCounters(list, "batch add");
+    }
+    for (int b = 0; b < batchCount && ok; b++) {
+        // Strided, so that removed and remaining items are interleaved
+        QList<BenchNote *> batch;
+        for (int i = b; i < count; i += batchCount)
+            batch.append(notes[i]);
+        list.remove(batch);
+        ok = checkOverlapCounters(list, "batch remove");
+    }
+    if (ok && !list.isEmpty()) {
+        qCritical() << "batch remove left" << list.count() << "items";
+        ok = false;
+    }
+    qDeleteAll(notes);
+    return ok;
+}
+
+static double elapsedMs(const QElapsedTimer &timer) {
+    return static_cast<double>(timer.nsecsElapsed()) / 1e6;
+}
+
+template <typename List>
+static void benchmark(const char *name, const QList<BenchNote *> &notes,
+                      const QList<std::tuple<qsizetype, qsizetype>> &queries,
+                      QList<qsizetype> &hitCounts, bool &hasOverlappedItem) {
+    List list;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (const auto note : notes)
+        list.add(note);
+    const auto insertMs = elapsedMs(timer);
+    hasOverlappedItem = list.hasOverlappedItem();
+
+    timer.restart();
+    hitCounts.clear();
+    for (const auto &query : queries)
+        hitCounts.append(list.findOverlappedItems(query).count());
+    const auto overlapMs = elapsedMs(timer);
+
+    timer.restart();
+    qint64 sum = 0;
+    for (int i = 0; i < iteratePasses; i++)
+        for (const auto note : list)
+            sum += note->start();
+    const auto iterateMs = elapsedMs(timer);
+
+    timer.restart();
+    for (const auto note : notes)
+        list.remove(note);
+    const auto removeMs = elapsedMs(timer);
+
+    qInfo().noquote() << QString("%1  insert %2 ms  overlap %3 ms  iterate %4 ms  remove %5 ms")
+                             .arg(name, -24)
+                             .arg(insertMs, 8, 'f', 2)
+                             .arg(overlapMs, 8, 'f', 2)
+                             .arg(iterateMs, 8, 'f', 2)
+                             .arg(removeMs, 8, 'f', 2)
+                      << "(checksum" << sum << ")";
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+    QRandomGenerator random(42);
+
+    // Mostly back-to-back notes of a quarter or an eighth, with a few overlapping ones
+    QList<BenchNote *> notes;
+    int pos = 0;
+    for (int i = 0; i < noteCount; i++) {
+        const auto length = random.bounded(2) == 0 ? 480 : 240;
+        const auto start = random.bounded(100) == 0 ? pos - 120 : pos;
+        notes.append(new BenchNote(start, length));
+        pos += length;
+    }
+    std::shuffle(notes.begin(), notes.end(), std::mt19937(42));
+
+    QList<std::tuple<qsizetype, qsizetype>> queries;
+    for (int i = 0; i < queryCount; i++) {
+        const qsizetype start = random.bounded(pos);
+        queries.append({start, start + random.bounded(1, 1920)});
+    }
+
+    // Interval bounds are compared as in FlatOverlappableList: [start, end) covers
+    // [start, max(start, end - 1)]. OverlappableSerialList only serves as the timing baseline, as
+    // lib_interval_tree may treat the ends of right-open intervals differently.
+    QList<qsizetype> expectedHits;
+    for (const auto &[queryStart, queryEnd] : queries) {
+        const auto queryHigh = std::max(queryStart, queryEnd - 1);
+        qsizetype hits = 0;
+        for (const auto note : std::as_const(notes)) {
+            const auto [start, end] = note->interval();
+            if (start <= queryHigh && queryStart <= std::max(start, end - 1))
+                hits++;
+        }
+        expectedHits.append(hits);
+    }
+
+    QList<qsizetype> serialHits;
+    QList<qsizetype> flatHits;
+    bool serialOverlapped = false;
+    bool flatOverlapped = false;
+    qInfo() << noteCount << "notes," << queryCount << "overlap queries," << iteratePasses
+            << "iterations";
+    benchmark<OverlappableSerialList<BenchNote>>("OverlappableSerialList", notes, queries,
+                                                 serialHits, serialOverlapped);
+    benchmark<FlatOverlappableList<BenchNote>>("FlatOverlappableList", notes, queries, flatHits,
+                                               flatOverlapped);
+
+    QElapsedTimer timer;
+    timer.start();
+    FlatOverlappableList<BenchNote> batchList;
+    batchList.add(notes);
+    const auto batchInsertMs = elapsedMs(timer);
+    timer.restart();
+    batchList.remove(notes);
+    qInfo().noquote() << QString("%1  insert %2 ms  remove %3 ms")
+                             .arg("FlatOverlappableList batch", -24)
+                             .arg(batchInsertMs, 8, 'f', 2)
+                             .arg(elapsedMs(timer), 8, 'f', 2);
+
+    qDeleteAll(notes);
+
+    if (!testBatchOverlapCounters(random))
+        return 1;
+    if (flatHits != expectedHits) {
+        qCritical() << "FlatOverlappableList returned wrong overlapped items";
+        return 1;
+    }
+    if (flatOverlapped != serialOverlapped) {
+        qCritical() << "FlatOverlappableList reports overlapped items differently";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+//
+// Created by fluty on 26-10-19.
+//
+
+#include "Modules/Task/Task.h"
+#include "Modules/Task/TaskQueue.h"
+#include "Utils/Linq.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+
+static constexpr int taskCount = 200;
+// More tasks run than there are threads, so that some wait in the thread pool when cancelled
+static constexpr int threadCount = 4;
+static constexpr int maxConcurrentTasks = 8;
+// Long enough that a session only completes if the cancellation did not reach it
+static constexpr int sessionMs = 10000;
+static constexpr int waitForCancelledMs = 5000;
+static constexpr quint32 seed = 20261019;
+static constexpr qint64 expectedP99LatencyNs = 50 * 1000 * 1000;
+// Generous, so that only a lost or blocked cancellation fails on a loaded machine
+static constexpr qint64 maxP99LatencyNs = 10 * expectedP99LatencyNs;
+
+// Stands in for a model session: it only checks its own stop flag, like srt::Inference does
+class FakeSession {
+public:
+    // Returns false if the session was stopped
+    bool run() {
+        for (int i = 0; i < sessionMs; i++) {
+            if (m_stopRequested.load(std::memory_order_acquire))
+                return false;
+            QThread::msleep(1);
+        }
+        return true;
+    }
+
+    void stop() {
+        m_stopRequested.store(true, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> m_stopRequested{false};
+};
+
+class FakeInferTask final : public Task {
+    Q_OBJECT
+
+public:
+    [[nodiscard]] bool sessionCompleted() const {
+        return m_sessionCompleted.load(std::memory_order_acquire);
+    }
+
+protected:
+    void runTask() override {
+        FakeSession session;
+        const CancellationToken::Registration stopOnCancel(cancellationToken(),
+                                                           [&] { session.stop(); });
+        if (isTerminateRequested())
+            return;
+        m_sessionCompleted.store(session.run(), std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> m_sessionCompleted{false};
+};
+
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+    QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+
+    TaskQueue<FakeInferTask> queue;
+    queue.setMaxConcurrentTasks(maxConcurrentTasks);
+
+    // Collected on the main thread, as InferController handles finished tasks
+    int failedCount = 0;
+    QList<qint64> latencies;
+    QList<QPointer<FakeInferTask>> tasks;
+    for (int i = 0; i < taskCount; i++) {
+        const auto task = new FakeInferTask;
+        tasks.append(task);
+        QObject::connect(
+            task, &Task::finished, &a,
+            [&, task, i] {
+                if (!task->terminated()) {
+                    qCritical() << "Task" << i << "finished without being cancelled";
+                    failedCount++;
+                    queue.onTaskFinished(task);
+                } else if (task->cancelLatencyNs() < 0 || task->sessionCompleted()) {
+                    qCritical() << "Task" << i << "was not cancelled: latency"
+                                << task->cancelLatencyNs() << "session completed"
+                                << task->sessionCompleted();
+                    failedCount++;
+                } else
+                    latencies.append(task->cancelLatencyNs());
+            },
+            Qt::QueuedConnection);
+        queue.add(task);
+    }
+
+    // Cancel the tasks one by one like edits do while notes are dragged. Pending tasks are
+    // disposed, tasks waiting in the thread pool are taken back, and running ones are terminated,
+    // which stops their session through the cancellation token.
+    QRandomGenerator random(seed);
+    int terminatedCount = 0;
+    for (const auto &task : std::as_const(tasks)) {
+        QThread::msleep(random.bounded(5));
+        QCoreApplication::processEvents();
+        if (!task)
+            continue;
+        const auto id = task->id();
+        queue.cancelIf(L_PRED(t, t->id() == id));
+        if (task && task->terminated())
+            terminatedCount++;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (latencies.count() + failedCount < terminatedCount &&
+           timer.elapsed() < waitForCancelledMs) {
+        QCoreApplication::processEvents();
+        QThread::msleep(1);
+    }
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    // Disposed pending tasks are not deleted by the queue
+    for (const auto &task : std::as_const(tasks))
+        delete task.data();
+
+    if (latencies.count() + failedCount < terminatedCount) {
+        qCritical() << terminatedCount - latencies.count() - failedCount
+                    << "terminated tasks did not finish within" << waitForCancelledMs << "ms";
+        return 1;
+    }
+    if (failedCount > 0)
+        return 1;
+    if (latencies.isEmpty()) {
+        qCritical() << "No task was cancelled while running";
+        return 1;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto p50 = latencies.at(latencies.count() / 2);
+    const auto p99 = latencies.at(qMin(latencies.count() - 1, latencies.count() * 99 / 100));
+    qDebug() << "Terminated:" << latencies.count()
+             << "disposed or taken back:" << taskCount - latencies.count();
+    qDebug() << "Cancel latency p50:" << p50 / 1000 << "us, p99:" << p99 / 1000
+             << "us, target:" << expectedP99LatencyNs / 1000 << "us";
+    if (p99 > maxP99LatencyNs) {
+        qCritical() << "p99 cancel latency exceeds" << maxP99LatencyNs / 1000 << "us";
+        return 1;
+    }
+    return 0;
+}
+
+#include "main.moc"